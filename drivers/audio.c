@@ -21,12 +21,16 @@
 #endif
 #if defined(FEATURE_AUDIO_PWM)
 #include <hardware/pwm.h>
-#define PWM_BITS 12
+#define PWM_BITS AUDIO_PWM_BITS
 #define PWM_WRAP ((1 << PWM_BITS) - 1)
 #define PWM_OSR               16
 #define PWM_AUDIO_RATE        AUDIO_SAMPLE_RATE
+#if AUDIO_DIRECT
+#define PWM_DMA_SAMPLES       1     // Plays from the caller's memory
+#else
 #define PWM_DMA_SAMPLES       TARGET_SAMPLES_PAL
 #endif
+#endif
 
 #include <stdio.h>
 #include <string.h>
@@ -55,7 +59,12 @@
 #define DMA_BUFFER_COUNT 2
 // One DMA word is one stereo frame (packed L/R int16).
 // AUDIO_BUFFER_SAMPLES is sized to cover NTSC/PAL with headroom.
+// With AUDIO_DIRECT the DMA plays from the caller's memory instead.
+#if AUDIO_DIRECT
+#define DMA_BUFFER_MAX_SAMPLES 1
+#else
 #define DMA_BUFFER_MAX_SAMPLES AUDIO_BUFFER_SAMPLES
+#endif
 
 static uint32_t __attribute__((aligned(4))) dma_buffers[DMA_BUFFER_COUNT][DMA_BUFFER_MAX_SAMPLES];
 
@@ -74,6 +83,14 @@ static uint32_t dma_transfer_count;
 
 static volatile bool audio_running = false;
 
+// Pulls the samples of each finished buffer when set (audio_start_callback)
+static volatile audio_fill_callback_t fill_callback = NULL;
+
+// Direct mode (audio_start_direct): block queued on each DMA channel
+static volatile audio_next_block_t next_block_callback = NULL;
+static const uint16_t *direct_block[2];
+static uint32_t direct_count[2];
+
 static void audio_dma_irq_handler(void);
 
 //=============================================================================
@@ -106,6 +123,11 @@ static uint g_pwm_slice = 0;
 static uint32_t *g_pwm_dma_buf = NULL;
 static uint32_t g_pwm_dma_count = 0;
 static bool g_pwm_dma_active = false;
+
+// Two buffers when driven by the fill callback: one plays while the
+// interrupt refills the other
+static uint32_t __attribute__((aligned(4))) g_pwm_dma_bufs[2][PWM_DMA_SAMPLES];
+static int g_pwm_dma_playing = 0;
 #endif
 
 void i2s_init(i2s_config_t *config) {
@@ -138,10 +160,9 @@ void i2s_init(i2s_config_t *config) {
     pwm_set_gpio_level(PWM_RIGHT_PIN, PWM_WRAP >> 1);
     pwm_set_gpio_level(PWM_LEFT_PIN,  PWM_WRAP >> 1);
 
-    // Allocate DMA buffer sized to ONE audio buffer worth of frames
-    static uint32_t dma_buf[PWM_DMA_SAMPLES];
+    // DMA buffer sized to ONE audio buffer worth of frames
     g_pwm_dma_count = PWM_DMA_SAMPLES;
-    g_pwm_dma_buf = dma_buf;
+    g_pwm_dma_buf = g_pwm_dma_bufs[0];
 
     g_pwm_dma_chan = dma_claim_unused_channel(true);
 
@@ -432,7 +453,7 @@ void i2s_decrease_volume(i2s_config_t *config) {
 
 static bool audio_initialized = false;
 static bool audio_enabled = true;
-static int master_volume = 100;  // 0-128
+static int master_volume = 128;  // 0-128, 128 = full scale
 #if defined(FEATURE_AUDIO_I2S)
 static i2s_config_t i2s_config;
 #endif
@@ -532,27 +553,196 @@ bool audio_is_initialized(void) {
     return audio_initialized;
 }
 
+#if defined(FEATURE_AUDIO_I2S)
+// Refill a finished I2S buffer through the fill callback
+static void i2s_fill_buffer(uint32_t *buf) {
+    fill_callback((int16_t *)(void *)buf, dma_transfer_count);
+    int32_t gain = audio_get_gain();
+    if (gain != AUDIO_GAIN_UNITY) {
+        int16_t *buf16 = (int16_t *)(void *)buf;
+        for (uint32_t i = 0; i < dma_transfer_count * 2; i++) {
+            buf16[i] = (int16_t)((buf16[i] * gain) >> 16);
+        }
+    }
+}
+#endif
+
+// Direct mode: let the callback retire the block of a channel and queue the
+// next one on it
+static void direct_next(int slot, int channel, bool trigger) {
+    uint32_t count;
+    const uint16_t *block = next_block_callback(direct_block[slot], direct_count[slot], &count);
+    direct_block[slot] = block;
+    direct_count[slot] = count;
+    dma_channel_set_read_addr(channel, block, false);
+    dma_channel_set_trans_count(channel, count, trigger);
+}
+
+// Direct mode: switch a channel to 16-bit transfers, so each sample is
+// written to both halves of the PIO FIFO word / PWM compare register
+static void direct_set_16bit(int channel) {
+    dma_channel_config cfg = dma_get_channel_config(channel);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    dma_channel_set_config(channel, &cfg, false);
+}
+
 static void audio_dma_irq_handler(void) {
     uint32_t ints = dma_hw->ints1;
     uint32_t mask = 0;
     if (dma_channel_a >= 0) mask |= (1u << dma_channel_a);
     if (dma_channel_b >= 0) mask |= (1u << dma_channel_b);
+#if defined(FEATURE_AUDIO_PWM)
+    if (g_pwm_dma_chan >= 0) mask |= (1u << g_pwm_dma_chan);
+#endif
     ints &= mask;
     if (!ints) return;
 
-    if ((dma_channel_a >= 0) && (ints & (1u << dma_channel_a))) {
+#if defined(FEATURE_AUDIO_I2S)
+    if ((dma_channel_a >= 0) && (ints & (1u << dma_channel_a)) && next_block_callback) {
+        dma_hw->ints1 = (1u << dma_channel_a);
+        direct_next(0, dma_channel_a, false);
+    } else if ((dma_channel_a >= 0) && (ints & (1u << dma_channel_a))) {
         dma_hw->ints1 = (1u << dma_channel_a);
         dma_channel_set_read_addr(dma_channel_a, dma_buffers[0], false);
         dma_channel_set_trans_count(dma_channel_a, dma_transfer_count, false);
-        dma_buffers_free_mask |= 1u;
+        if (fill_callback) {
+            i2s_fill_buffer(dma_buffers[0]);
+        } else {
+            dma_buffers_free_mask |= 1u;
+        }
     }
 
-    if ((dma_channel_b >= 0) && (ints & (1u << dma_channel_b))) {
+    if ((dma_channel_b >= 0) && (ints & (1u << dma_channel_b)) && next_block_callback) {
+        dma_hw->ints1 = (1u << dma_channel_b);
+        direct_next(1, dma_channel_b, false);
+    } else if ((dma_channel_b >= 0) && (ints & (1u << dma_channel_b))) {
         dma_hw->ints1 = (1u << dma_channel_b);
         dma_channel_set_read_addr(dma_channel_b, dma_buffers[1], false);
         dma_channel_set_trans_count(dma_channel_b, dma_transfer_count, false);
-        dma_buffers_free_mask |= 2u;
+        if (fill_callback) {
+            i2s_fill_buffer(dma_buffers[1]);
+        } else {
+            dma_buffers_free_mask |= 2u;
+        }
+    }
+#endif
+
+#if defined(FEATURE_AUDIO_PWM)
+    if ((ints & (1u << g_pwm_dma_chan)) && next_block_callback) {
+        // Single channel, restarted right away; the PWM holds the last
+        // level meanwhile
+        dma_hw->ints1 = (1u << g_pwm_dma_chan);
+        direct_next(0, g_pwm_dma_chan, true);
+    } else if (ints & (1u << g_pwm_dma_chan)) {
+        dma_hw->ints1 = (1u << g_pwm_dma_chan);
+
+        // Start the other buffer right away, then refill the finished one
+        uint32_t *done = g_pwm_dma_bufs[g_pwm_dma_playing];
+        g_pwm_dma_playing ^= 1;
+        dma_channel_transfer_from_buffer_now(g_pwm_dma_chan, g_pwm_dma_bufs[g_pwm_dma_playing], g_pwm_dma_count);
+
+        // The callback writes packed L/R samples, converted in place
+        fill_callback((int16_t *)(void *)done, g_pwm_dma_count);
+        int32_t gain = audio_get_gain();
+        for (uint32_t i = 0; i < g_pwm_dma_count; i++) {
+            uint32_t lr = done[i];
+            int32_t l = ((int16_t)(lr & 0xffff) * gain) >> 16;
+            int32_t r = ((int16_t)(lr >> 16) * gain) >> 16;
+            done[i] = pack_pwm_cc(s16_to_pwm_u16((int16_t)l), s16_to_pwm_u16((int16_t)r));
+        }
+    }
+#endif
+}
+
+void audio_start_callback(audio_fill_callback_t callback) {
+    if (!audio_initialized) return;
+
+#if defined(FEATURE_AUDIO_I2S)
+    uint32_t irq_state = save_and_disable_interrupts();
+    fill_callback = callback;
+    if (!audio_running) {
+        // Pre-roll silence; each buffer is refilled as soon as it finished
+        memset(dma_buffers, 0, sizeof(dma_buffers));
+        dma_buffers_free_mask = 0;
+        preroll_count = PREROLL_BUFFERS;
+        __dmb();
+        dma_channel_start(dma_channel_a);
+        audio_running = true;
+    }
+    restore_interrupts(irq_state);
+#endif
+
+#if defined(FEATURE_AUDIO_PWM)
+    if (g_pwm_dma_chan < 0) return;
+
+    if (g_pwm_dma_active) {
+        dma_channel_wait_for_finish_blocking(g_pwm_dma_chan);
+    }
+
+    uint32_t mid = pack_pwm_cc(PWM_WRAP >> 1, PWM_WRAP >> 1);
+    for (uint32_t i = 0; i < g_pwm_dma_count; i++) {
+        g_pwm_dma_bufs[0][i] = g_pwm_dma_bufs[1][i] = mid;
+    }
+    fill_callback = callback;
+    g_pwm_dma_playing = 0;
+
+    irq_set_exclusive_handler(AUDIO_DMA_IRQ, audio_dma_irq_handler);
+    irq_set_priority(AUDIO_DMA_IRQ, 0x80);
+    dma_hw->ints1 = (1u << g_pwm_dma_chan);
+    dma_channel_set_irq1_enabled(g_pwm_dma_chan, true);
+    irq_set_enabled(AUDIO_DMA_IRQ, true);
+
+    dma_channel_transfer_from_buffer_now(g_pwm_dma_chan, g_pwm_dma_bufs[0], g_pwm_dma_count);
+    g_pwm_dma_active = true;
+#endif
+}
+
+void audio_start_direct(audio_next_block_t next_block) {
+    if (!audio_initialized) return;
+
+#if defined(FEATURE_AUDIO_I2S)
+    uint32_t irq_state = save_and_disable_interrupts();
+    if (!audio_running) {
+        direct_set_16bit(dma_channel_a);
+        direct_set_16bit(dma_channel_b);
+
+        // Queue the first two blocks, channel B follows A through the chain
+        next_block_callback = next_block;
+        direct_block[0] = direct_block[1] = NULL;
+        direct_count[0] = direct_count[1] = 0;
+        direct_next(0, dma_channel_a, false);
+        direct_next(1, dma_channel_b, false);
+
+        dma_buffers_free_mask = 0;
+        preroll_count = PREROLL_BUFFERS;
+        __dmb();
+        dma_channel_start(dma_channel_a);
+        audio_running = true;
+    }
+    restore_interrupts(irq_state);
+#endif
+
+#if defined(FEATURE_AUDIO_PWM)
+    if (g_pwm_dma_chan < 0) return;
+
+    if (g_pwm_dma_active) {
+        dma_channel_wait_for_finish_blocking(g_pwm_dma_chan);
     }
+    direct_set_16bit(g_pwm_dma_chan);
+
+    next_block_callback = next_block;
+    direct_block[0] = NULL;
+    direct_count[0] = 0;
+
+    irq_set_exclusive_handler(AUDIO_DMA_IRQ, audio_dma_irq_handler);
+    irq_set_priority(AUDIO_DMA_IRQ, 0x80);
+    dma_hw->ints1 = (1u << g_pwm_dma_chan);
+    dma_channel_set_irq1_enabled(g_pwm_dma_chan, true);
+    irq_set_enabled(AUDIO_DMA_IRQ, true);
+
+    direct_next(0, g_pwm_dma_chan, true);
+    g_pwm_dma_active = true;
+#endif
 }
 
 void audio_submit(void) {
@@ -588,6 +778,14 @@ int audio_get_volume(void) {
     return master_volume;
 }
 
+int32_t audio_get_gain(void) {
+    int32_t gain = master_volume << 9;
+#if defined(FEATURE_AUDIO_I2S)
+    gain >>= i2s_config.volume;
+#endif
+    return gain;
+}
+
 void audio_set_enabled(bool enabled) {
     audio_enabled = enabled;
 }
@@ -24,6 +24,9 @@
 // Audio buffer size - enough for both NTSC (~888) and PAL (~1061) with headroom
 #define AUDIO_BUFFER_SAMPLES 1120
 
+// Resolution of the PWM output (compare values 0..2^AUDIO_PWM_BITS-1)
+#define AUDIO_PWM_BITS 12
+
 // I2S configuration structure
 typedef struct {
     uint32_t sample_freq;
@@ -80,6 +83,11 @@ void audio_set_volume(int volume);
 // Get current master volume
 int audio_get_volume(void);
 
+// Output gain of the volume settings in 1/65536: the master volume (128 =
+// full scale) and, with I2S, the attenuation shift of i2s_volume()
+#define AUDIO_GAIN_UNITY 65536
+int32_t audio_get_gain(void);
+
 // Enable/disable audio
 void audio_set_enabled(bool enabled);
 
@@ -95,4 +103,27 @@ void audio_debug_buffer_values(void);
 // Get the I2S config for direct access (for Core 1 loop)
 i2s_config_t* audio_get_i2s_config(void);
 
+// Fill callback: called from the audio DMA interrupt with a buffer that
+// has just finished playing, to be filled with the next `count` stereo
+// frames (interleaved L/R int16)
+typedef void (*audio_fill_callback_t)(int16_t *samples, uint32_t count);
+
+// Start playback driven by the audio clock: the driver pulls every buffer
+// through the callback instead of waiting for i2s_dma_write_count() or
+// pwm_dma_write_count() calls. Plays silence until the first refill.
+void audio_start_callback(audio_fill_callback_t callback);
+
+// Direct mode callback: called from the audio DMA interrupt with the block
+// that has just finished playing (NULL while the queue is first filled)
+// and returns the next block to play and its length in *count. A block is
+// one 16-bit word per sample in the output format (I2S: signed sample,
+// PWM: compare value), sent to both channels.
+typedef const uint16_t *(*audio_next_block_t)(const uint16_t *done, uint32_t done_count, uint32_t *count);
+
+// Start playback straight from the caller's memory, without copying into
+// the driver's buffers (which are not allocated when built with
+// AUDIO_DIRECT). The caller applies audio_get_gain() when it writes the
+// samples.
+void audio_start_direct(audio_next_block_t next_block);
+
 #endif // AUDIO_H
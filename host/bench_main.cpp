@@ -0,0 +1,245 @@
+/*
+ *  bench_main.cpp - Headless frame benchmark for the emulator core
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Boots the built-in ROMs, optionally autoloads a PRG/D64/CRT from a
+ *  host directory standing in for the SD card, then runs frames without
+ *  pacing and reports throughput plus framebuffer/audio hashes, so two
+ *  builds can be compared for both speed and identical output. -expect
+ *  fails the run when the audio hash differs from a known value.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#if VIC_RENDER_QUEUE || SID_WRITE_QUEUE || DRIVE_IEC_QUEUE
+#include <atomic>
+#include <thread>
+#endif
+
+#include "host_platform.h"
+#include "c64_profile.h"
+
+#include "sysdeps.h"
+#include "VIC.h"
+#include "SID.h"
+#include "Display.h"
+#include "C64.h"
+#include "CPUC64.h"
+#include "CPU1541.h"
+#include "Prefs.h"
+
+extern C64 *TheC64;
+extern "C" uint8_t *graphics_get_buffer_line(int y);
+
+static void usage(const char *prg)
+{
+    printf("Usage: %s [-n frames] [-b boot_frames] [-r sd_root] [-o file.pgm] [-I] [-P] [-expect audio_hash] [file.prg|file.d64|file.crt]\n", prg);
+    printf("  -n frames       measured frames (default 3000)\n");
+    printf("  -b boot_frames  frames run before autoload/measurement (default 150)\n");
+    printf("  -r sd_root      host directory used as SD card root (default .)\n");
+    printf("  -o file.pgm     dump the last frame (color index * 17 as grey levels)\n");
+    printf("  -I              disable idle-loop skipping in the 6510\n");
+    printf("  -P              emulate the 1541 processor instead of the IEC traps\n");
+    printf("  -expect hash    exit with 1 if the audio hash differs (hex)\n");
+}
+
+// FNV-1a over the whole frame buffer
+static uint64_t framebuffer_hash(const uint8_t *fb)
+{
+    uint64_t h = 14695981039346656037ull;
+    for (unsigned i = 0; i < FRAME_X * FRAME_Y; ++i) {
+        h = (h ^ fb[i]) * 1099511628211ull;
+    }
+    return h;
+}
+
+// Read a frame the way the video driver does, once per emulated frame
+static void scan_out()
+{
+#if DISPLAY_BUFFERS > 1
+    for (int y = 0; y < (int)FRAME_Y; ++y) {
+        graphics_get_buffer_line(y);
+    }
+#endif
+}
+
+static void dump_frame(const char *path, const uint8_t *fb)
+{
+    // Plain iostreams: sysdeps.h redirects the stdio file calls to FatFs
+    std::ofstream f(path, std::ios::binary);
+    f << "P5\n" << FRAME_X << " " << FRAME_Y << "\n255\n";
+    for (unsigned i = 0; i < FRAME_X * FRAME_Y; ++i) {
+        f.put((char)((fb[i] & 0x0f) * 17));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    unsigned frames = 3000;
+    unsigned boot_frames = 150;
+    const char *autoload = nullptr;
+    const char *dump_path = nullptr;
+    bool skip_idle = true;
+    bool emul_1541_proc = ThePrefs.Emul1541Proc;
+    bool check_audio = false;
+    uint32_t expect_audio = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            frames = strtoul(argv[++i], nullptr, 0);
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            boot_frames = strtoul(argv[++i], nullptr, 0);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            host_set_sd_root(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            dump_path = argv[++i];
+        } else if (strcmp(argv[i], "-I") == 0) {
+            skip_idle = false;
+        } else if (strcmp(argv[i], "-P") == 0) {
+            emul_1541_proc = true;
+        } else if (strcmp(argv[i], "-expect") == 0 && i + 1 < argc) {
+            check_audio = true;
+            expect_audio = strtoul(argv[++i], nullptr, 16);
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            autoload = argv[i];
+        }
+    }
+
+    ThePrefs.Emul1541Proc = emul_1541_proc;  // Before the Kernal is patched
+    c64_init();
+    ThePrefs.SkipIdleLoops = skip_idle;
+
+#if VIC_RENDER_QUEUE || SID_WRITE_QUEUE || DRIVE_IEC_QUEUE
+    // Stand-in for core 1 drawing the queued VIC lines and SID audio and
+    // running the 1541
+    std::atomic<bool> render_quit(false);
+    std::thread render_thread([&render_quit] {
+        while (!render_quit.load(std::memory_order_relaxed)) {
+#if VIC_RENDER_QUEUE
+            c64_render_lines();
+#endif
+#if SID_WRITE_QUEUE
+            c64_render_audio();
+#endif
+#if DRIVE_IEC_QUEUE
+            c64_run_drive();
+#endif
+            std::this_thread::yield();
+        }
+    });
+#endif
+
+    // Keep the overlay out of the framebuffer hash
+    c64_set_profile_overlay(false);
+
+    // Let the Kernal reach the READY prompt before typing into its buffer
+    for (unsigned i = 0; i < boot_frames; ++i) {
+        c64_run_frame();
+        scan_out();
+    }
+    if (autoload) {
+        c64_load_file(autoload);
+    }
+
+    uint64_t idle_start = TheC64->TheCPU->SkippedIdleCycles();
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < frames; ++i) {
+        c64_run_frame();
+        scan_out();
+    }
+    TheC64->TheSID->WaitRendered();
+    auto end = std::chrono::steady_clock::now();
+
+    TheC64->TheCPU1541->Sync();
+
+#if VIC_RENDER_QUEUE || SID_WRITE_QUEUE || DRIVE_IEC_QUEUE
+    render_quit = true;
+    render_thread.join();
+#endif
+
+    double secs = std::chrono::duration<double>(end - start).count();
+    double fps = frames / secs;
+    double ns_per_line = secs * 1e9 / ((double)frames * TOTAL_RASTERS);
+
+    printf("frames:        %u\n", frames);
+    printf("time:          %.3f s\n", secs);
+    printf("frames/s:      %.1f (%.2fx PAL)\n", fps, fps / 50.0);
+    printf("ns/line:       %.1f\n", ns_per_line);
+    printf("audio samples: %llu\n", (unsigned long long)host_audio_samples());
+    printf("audio hash:    %08x\n", host_audio_hash());
+    printf("idle skipped:  %llu cycles\n",
+           (unsigned long long)(TheC64->TheCPU->SkippedIdleCycles() - idle_start));
+#if CPU_BLOCK_CACHE
+    const MOS6510::BlockCacheStats &bc = TheC64->TheCPU->GetBlockCacheStats();
+    uint64_t lookups = bc.hits + bc.misses;
+    printf("block cache:   %u blocks, %.2f%% hits, %llu misses, %llu uncached, %llu invalidations\n",
+           (unsigned)CPU_BLOCK_CACHE, lookups ? bc.hits * 100.0 / lookups : 0.0,
+           (unsigned long long)bc.misses, (unsigned long long)bc.uncached,
+           (unsigned long long)bc.invalidations);
+#endif
+    if (ThePrefs.Emul1541Proc) {
+        DriveSyncStats ds = TheC64->TheCPU1541->SyncStats();
+        printf("1541 sync:     %u IEC reads (%u from the published state), %u stalls, %u polls, max lag %u cycles before throttling\n",
+               ds.syncs + ds.published, ds.published, ds.stalls, ds.stall_polls, ds.max_lag_unthrottled);
+        uint32_t drive_cycles = TheC64->TheCPU1541->CycleCounter();
+        printf("1541 asleep:   %.1f%% of %u cycles\n",
+               drive_cycles ? ds.slept * 100.0 / drive_cycles : 0.0, drive_cycles);
+    }
+    printf("fb hash:       %016llx\n", (unsigned long long)framebuffer_hash(c64_get_framebuffer()));
+#if DISPLAY_BUFFERS > 1
+    const DisplayFrameStats &fs = TheC64->TheDisplay->GetFrameStats();
+    printf("frame buffers: %u, %u completed, %u shown, %u dropped, %u repeated, max age %u us, waited %u us\n",
+           (unsigned)DISPLAY_BUFFERS, fs.completed, fs.shown, fs.dropped, fs.repeated,
+           fs.max_age_us, fs.wait_us);
+#endif
+
+    // Per-chip breakdown of the last C64_PROFILE_FRAMES frames
+    if (const c64_profile_t *p = c64_get_profile()) {
+        static const char *names[C64_PROF_NUM] = { "VIC", "SID", "CIA1", "CIA2", "CPU", "1541" };
+        unsigned n = p->count < C64_PROFILE_FRAMES ? p->count : C64_PROFILE_FRAMES;
+        uint64_t chip[C64_PROF_NUM] = {};
+        uint64_t total = 0;
+        uint32_t worst = 0;
+        unsigned worst_line = 0;
+        for (unsigned f = 0; f < n; ++f) {
+            for (unsigned c = 0; c < C64_PROF_NUM; ++c) {
+                chip[c] += p->frames[f].chip[c];
+            }
+            total += p->frames[f].total;
+            if (p->frames[f].worst_line_cycles > worst) {
+                worst = p->frames[f].worst_line_cycles;
+                worst_line = p->frames[f].worst_line;
+            }
+        }
+        printf("profile (last %u frames, ns/frame):\n", n);
+        for (unsigned c = 0; c < C64_PROF_NUM; ++c) {
+            printf("  %-5s %10.0f  %5.1f%%\n", names[c], chip[c] * 1000.0 / p->clock_mhz / n,
+                   total ? chip[c] * 100.0 / total : 0.0);
+        }
+        printf("  total %10.0f\n", total * 1000.0 / p->clock_mhz / n);
+        printf("  worst line %u: %.0f ns\n", worst_line, worst * 1000.0 / p->clock_mhz);
+    }
+
+    if (dump_path) {
+        dump_frame(dump_path, c64_get_framebuffer());
+    }
+
+    if (check_audio && host_audio_hash() != expect_audio) {
+        printf("audio hash CHANGED, expected %08x\n", expect_audio);
+        return 1;
+    }
+    return 0;
+}
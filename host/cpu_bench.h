@@ -0,0 +1,37 @@
+/*
+ *  cpu_bench.h - 6502 opcode dispatch micro-benchmark
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ */
+
+#ifndef CPU_BENCH_H
+#define CPU_BENCH_H
+
+#include <stdint.h>
+#include <time.h>
+
+struct cpu_bench_result {
+    uint64_t instructions;  // Executed opcodes
+    uint64_t ns;            // Wall time
+    uint32_t state;         // A | X << 8 | Y << 16 | SP << 24 at the end
+    uint16_t pc;            // PC at the end
+};
+
+static inline uint64_t cpu_bench_now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// Run 'lines' lines of 63 cycles from 'start' in the 64K 'ram'
+cpu_bench_result cpu_bench_run_switch(uint8_t *ram, uint16_t start, uint64_t lines);
+cpu_bench_result cpu_bench_run_table(uint8_t *ram, uint16_t start, uint64_t lines);
+
+#endif // CPU_BENCH_H
@@ -0,0 +1,156 @@
+/*
+ *  cpu_bench_core.h - Flat-memory 6502 used to time the opcode dispatch
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Included by cpu_bench_switch.cpp and cpu_bench_table.cpp with
+ *  CPU_THREADED_DISPATCH set to 0 and 1, so the same CPU_emulline.h body
+ *  is compiled with both engines into one binary. Memory is a plain 64K
+ *  array, which leaves the dispatch and the opcode handlers as the only
+ *  cost. Define CPU_BENCH_RUN to the name of the exported run function.
+ */
+
+#include <stdint.h>
+
+#include "cpu_bench.h"
+
+#define PRECISE_CPU_CYCLES 1
+#define PRECISE_CIA_CYCLES 0
+
+namespace {
+
+class BenchCPU {
+public:
+	BenchCPU(uint8_t * Ram) : ram(Ram) { }
+
+	int EmulateLine(int cycles_left);
+
+	uint8_t a = 0, x = 0, y = 0, sp = 0xff;
+	uint16_t pc = 0;
+	uint64_t instructions = 0;
+
+private:
+	uint8_t read_byte(uint16_t adr) { return ram[adr]; }
+	uint16_t read_word(uint16_t adr) { return ram[adr] | (ram[(uint16_t)(adr + 1)] << 8); }
+	void write_byte(uint16_t adr, uint8_t byte) { ram[adr] = byte; }
+	uint8_t read_zp(uint16_t adr) { return ram[adr & 0xff]; }
+	uint16_t read_zp_word(uint16_t adr) { return ram[adr & 0xff] | (ram[(adr + 1) & 0xff] << 8); }
+	void write_zp(uint16_t adr, uint8_t byte) { ram[adr & 0xff] = byte; }
+
+	void Reset() { }
+	void illegal_op(uint16_t adr) { jammed = true; --pc; }
+
+	void do_adc(uint8_t byte);
+	void do_sbc(uint8_t byte);
+
+	uint8_t * ram;
+	uint8_t n_flag = 0, z_flag = 0;
+	bool v_flag = false, d_flag = false, i_flag = true, c_flag = false;
+	bool nmi_triggered = false;
+	bool jammed = false;
+	int interrupt_delay = 0;
+	int borrowed_cycles = 0;
+};
+
+void BenchCPU::do_adc(uint8_t byte)
+{
+	if (!d_flag) {
+		uint16_t tmp = a + (byte) + (c_flag ? 1 : 0);
+		c_flag = tmp > 0xff;
+		v_flag = !((a ^ (byte)) & 0x80) && ((a ^ tmp) & 0x80);
+		z_flag = n_flag = a = tmp;
+	} else {
+		uint16_t al, ah;
+		al = (a & 0x0f) + ((byte) & 0x0f) + (c_flag ? 1 : 0);
+		if (al > 9) al += 6;
+		ah = (a >> 4) + ((byte) >> 4);
+		if (al > 0x0f) ah++;
+		z_flag = a + (byte) + (c_flag ? 1 : 0);
+		n_flag = ah << 4;
+		v_flag = (((ah << 4) ^ a) & 0x80) && !((a ^ (byte)) & 0x80);
+		if (ah > 9) ah += 6;
+		c_flag = ah > 0x0f;
+		a = (ah << 4) | (al & 0x0f);
+	}
+}
+
+void BenchCPU::do_sbc(uint8_t byte)
+{
+	uint16_t tmp = a - (byte) - (c_flag ? 0 : 1);
+	if (!d_flag) {
+		c_flag = tmp < 0x100;
+		v_flag = ((a ^ tmp) & 0x80) && ((a ^ (byte)) & 0x80);
+		z_flag = n_flag = a = tmp;
+	} else {
+		uint16_t al, ah;
+		al = (a & 0x0f) - ((byte) & 0x0f) - (c_flag ? 0 : 1);
+		ah = (a >> 4) - ((byte) >> 4);
+		if (al & 0x10) {
+			al -= 6;
+			ah--;
+		}
+		if (ah & 0x10) ah -= 6;
+		c_flag = tmp < 0x100;
+		v_flag = ((a ^ tmp) & 0x80) && ((a ^ (byte)) & 0x80);
+		z_flag = n_flag = tmp;
+		a = (ah << 4) | (al & 0x0f);
+	}
+}
+
+int BenchCPU::EmulateLine(int cycles_left)
+{
+	uint8_t tmp, tmp2;
+	uint16_t adr, tmp_adr;
+
+	int last_cycles = 0;
+
+#define RESET_PENDING false
+#define IRQ_PENDING false
+#define CHECK_SO ;
+#define OPCODE_DONE ++instructions
+
+	if (interrupt_delay > 0) {
+		interrupt_delay--;
+		return 0;
+	}
+
+#include "CPU_emulline.h"
+
+		OPCODE(0xf2):
+			illegal_op(pc - 1);
+			ENDOP(2);
+		}
+
+		OPCODE_DONE;
+	}
+
+	return last_cycles;
+}
+
+} // namespace
+
+
+cpu_bench_result CPU_BENCH_RUN(uint8_t * ram, uint16_t start, uint64_t lines)
+{
+	BenchCPU cpu(ram);
+	cpu.pc = start;
+
+	uint64_t t0 = cpu_bench_now_ns();
+	for (uint64_t i = 0; i < lines; ++i) {
+		cpu.EmulateLine(63);
+	}
+	uint64_t t1 = cpu_bench_now_ns();
+
+	cpu_bench_result r;
+	r.instructions = cpu.instructions;
+	r.ns = t1 - t0;
+	r.state = cpu.a | (cpu.x << 8) | (cpu.y << 16) | (cpu.sp << 24);
+	r.pc = cpu.pc;
+	return r;
+}
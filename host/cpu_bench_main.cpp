@@ -0,0 +1,139 @@
+/*
+ *  cpu_bench_main.cpp - 6502 opcode dispatch micro-benchmark
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Runs a fixed instruction mix (loads/stores in all common addressing
+ *  modes, ALU, read-modify-write, stack, JSR/RTS and branches) for a fixed
+ *  number of 63-cycle lines and reports instructions per second for:
+ *    - the switch and computed-goto engines on flat memory, both built
+ *      into this binary from the same CPU_emulline.h body
+ *    - the real MOS6510 with the C64 memory map, using the engine the
+ *      core was built with (CPU_THREADED_DISPATCH)
+ *  All three must end in the same CPU state.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "cpu_bench.h"
+#include "host_platform.h"
+
+#include "sysdeps.h"
+#include "C64.h"
+#include "CPUC64.h"
+
+extern C64 *TheC64;
+
+#if CPU_THREADED_DISPATCH
+static const char c64_engine[] = "6510, computed goto";
+#else
+static const char c64_engine[] = "6510, switch";
+#endif
+
+static const uint16_t MIX_START = 0x0200;
+
+static const uint8_t mix[] = {
+    0x78,               // $0200  SEI
+    0xa2, 0x00,         // $0201  LDX #$00
+    0xbd, 0x00, 0x10,   // $0203  LDA $1000,X
+    0x9d, 0x00, 0x20,   //        STA $2000,X
+    0x69, 0x03,         //        ADC #$03
+    0x85, 0x10,         //        STA $10
+    0xb1, 0x10,         //        LDA ($10),Y
+    0x45, 0x11,         //        EOR $11
+    0xe6, 0x12,         //        INC $12
+    0x20, 0x1d, 0x02,   //        JSR $021D
+    0xca,               //        DEX
+    0xd0, 0xea,         //        BNE $0203
+    0xc8,               //        INY
+    0x4c, 0x01, 0x02,   //        JMP $0201
+    0x0a,               // $021D  ASL A
+    0x26, 0x13,         //        ROL $13
+    0x48,               //        PHA
+    0x68,               //        PLA
+    0xc9, 0x40,         //        CMP #$40
+    0x60                //        RTS
+};
+
+static void load_mix(uint8_t *ram)
+{
+    memcpy(ram + MIX_START, mix, sizeof(mix));
+    for (unsigned i = 0; i < 0x100; ++i) {
+        ram[0x1000 + i] = i * 7;
+    }
+}
+
+static void report(const char *name, const cpu_bench_result &r)
+{
+    double s = r.ns / 1e9;
+    printf("%-22s %12llu instr  %7.3f s  %8.2f MIPS  state %08x pc %04x\n",
+           name, (unsigned long long)r.instructions, s, r.instructions / s / 1e6,
+           r.state, r.pc);
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t lines = 2000000;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            lines = strtoull(argv[++i], nullptr, 0);
+        } else {
+            printf("Usage: %s [-n lines]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    static uint8_t ram[0x10000];
+
+    memset(ram, 0, sizeof(ram));
+    load_mix(ram);
+    cpu_bench_result sw = cpu_bench_run_switch(ram, MIX_START, lines);
+
+    memset(ram, 0, sizeof(ram));
+    load_mix(ram);
+    cpu_bench_result tab = cpu_bench_run_table(ram, MIX_START, lines);
+
+    // Real 6510 with the C64 memory map; the opcode count is taken from
+    // the flat runs, which execute the same instructions in the same cycles
+    c64_init();
+    MOS6510 *cpu = TheC64->TheCPU;
+    load_mix(TheC64->RAM);
+    memset(TheC64->RAM + 0x10, 0, 4);
+    cpu->SetPC(MIX_START);
+    cpu->SetSP(0xff);
+    cpu->SetA(0);
+    cpu->SetX(0);
+    cpu->SetY(0);
+    cpu->SetP(0x04);
+
+    cpu_bench_result c64;
+    uint64_t t0 = cpu_bench_now_ns();
+    for (uint64_t i = 0; i < lines; ++i) {
+        cpu->EmulateLine(63);
+    }
+    c64.ns = cpu_bench_now_ns() - t0;
+    c64.instructions = sw.instructions;
+    c64.state = cpu->GetA() | (cpu->GetX() << 8) | (cpu->GetY() << 16) | (cpu->GetSP() << 24);
+    c64.pc = cpu->GetPC();
+
+    printf("lines:                 %llu (%llu cycles)\n",
+           (unsigned long long)lines, (unsigned long long)lines * 63);
+    report("flat, switch", sw);
+    report("flat, computed goto", tab);
+    report(c64_engine, c64);
+
+    bool same = sw.instructions == tab.instructions
+             && sw.state == tab.state && sw.pc == tab.pc
+             && sw.state == c64.state && sw.pc == c64.pc;
+    printf("%s\n", same ? "state: identical" : "state: MISMATCH");
+    return same ? 0 : 1;
+}
@@ -0,0 +1,5 @@
+// Flat-memory 6502 with the switch opcode dispatch
+#undef CPU_THREADED_DISPATCH
+#define CPU_THREADED_DISPATCH 0
+#define CPU_BENCH_RUN cpu_bench_run_switch
+#include "cpu_bench_core.h"
@@ -0,0 +1,138 @@
+/*
+ *  host_fatfs.c - FatFs file API on top of POSIX stdio for the host build
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Paths are resolved relative to a host directory that stands in for
+ *  the SD card root (see host_set_sd_root()).
+ */
+
+#include "ff.h"
+#include <stdio.h>
+#include <string.h>
+
+static char sd_root[512] = ".";
+
+void host_set_sd_root(const char *dir)
+{
+    snprintf(sd_root, sizeof(sd_root), "%s", dir);
+}
+
+static void host_path(char *out, size_t size, const char *path)
+{
+    while (*path == '/') {
+        path++;
+    }
+    snprintf(out, size, "%s/%s", sd_root, path);
+}
+
+// The stdio handle is kept in the (otherwise unused) filesystem pointer
+static FILE *host_file(FIL *fp)
+{
+    return (FILE *)fp->obj.fs;
+}
+
+FRESULT f_open(FIL *fp, const TCHAR *path, BYTE mode)
+{
+    char full[1024];
+    host_path(full, sizeof(full), path);
+
+    const char *fmode;
+    if (mode & FA_CREATE_ALWAYS) {
+        fmode = (mode & FA_READ) ? "w+b" : "wb";
+    } else if ((mode & FA_OPEN_APPEND) == FA_OPEN_APPEND) {
+        fmode = (mode & FA_READ) ? "a+b" : "ab";
+    } else if (mode & FA_WRITE) {
+        fmode = "r+b";
+    } else {
+        fmode = "rb";
+    }
+
+    memset(fp, 0, sizeof(*fp));
+    FILE *f = fopen(full, fmode);
+    if (!f && (mode & (FA_OPEN_ALWAYS | FA_CREATE_NEW))) {
+        f = fopen(full, (mode & FA_READ) ? "w+b" : "wb");
+    }
+    if (!f) {
+        return FR_NO_FILE;
+    }
+
+    fseek(f, 0, SEEK_END);
+    fp->obj.objsize = (FSIZE_t)ftell(f);
+    if ((mode & FA_OPEN_APPEND) == FA_OPEN_APPEND) {
+        fp->fptr = fp->obj.objsize;
+    } else {
+        fseek(f, 0, SEEK_SET);
+    }
+    fp->obj.fs = (FATFS *)f;
+    fp->flag = mode;
+    return FR_OK;
+}
+
+FRESULT f_close(FIL *fp)
+{
+    FILE *f = host_file(fp);
+    if (!f) {
+        return FR_INVALID_OBJECT;
+    }
+    fclose(f);
+    fp->obj.fs = NULL;
+    return FR_OK;
+}
+
+FRESULT f_read(FIL *fp, void *buff, UINT btr, UINT *br)
+{
+    FILE *f = host_file(fp);
+    if (!f) {
+        return FR_INVALID_OBJECT;
+    }
+    *br = (UINT)fread(buff, 1, btr, f);
+    fp->fptr += *br;
+    return FR_OK;
+}
+
+FRESULT f_write(FIL *fp, const void *buff, UINT btw, UINT *bw)
+{
+    FILE *f = host_file(fp);
+    if (!f) {
+        return FR_INVALID_OBJECT;
+    }
+    *bw = (UINT)fwrite(buff, 1, btw, f);
+    fp->fptr += *bw;
+    if (fp->fptr > fp->obj.objsize) {
+        fp->obj.objsize = fp->fptr;
+    }
+    return FR_OK;
+}
+
+FRESULT f_lseek(FIL *fp, FSIZE_t ofs)
+{
+    FILE *f = host_file(fp);
+    if (!f) {
+        return FR_INVALID_OBJECT;
+    }
+    if (fseek(f, (long)ofs, SEEK_SET) != 0) {
+        return FR_INT_ERR;
+    }
+    fp->fptr = ofs;
+    if (fp->fptr > fp->obj.objsize) {
+        fp->obj.objsize = fp->fptr;
+    }
+    return FR_OK;
+}
+
+FRESULT f_sync(FIL *fp)
+{
+    FILE *f = host_file(fp);
+    if (!f) {
+        return FR_INVALID_OBJECT;
+    }
+    fflush(f);
+    return FR_OK;
+}
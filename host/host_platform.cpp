@@ -0,0 +1,150 @@
+/*
+ *  host_platform.cpp - Stand-ins for the hardware-facing RP2350 modules
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Replaces input_rp2350.cpp, sid_i2s.cpp, disk_ui.c, the PSRAM allocator
+ *  and the flash programming functions so the core links on a PC.
+ */
+
+#include "host_platform.h"
+#include "sid_i2s.h"
+
+#include "hardware/flash.h"
+
+#include <cstdlib>
+#include <cstring>
+
+extern "C" {
+
+//=============================================================================
+// Flash (cartridge images are "programmed" into a RAM array)
+//=============================================================================
+
+uint8_t host_flash[HOST_FLASH_SIZE];
+
+void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+    if (flash_offs + count <= HOST_FLASH_SIZE) {
+        memset(host_flash + flash_offs, 0xff, count);
+    }
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count)
+{
+    if (flash_offs + count <= HOST_FLASH_SIZE) {
+        memcpy(host_flash + flash_offs, data, count);
+    }
+}
+
+
+//=============================================================================
+// PSRAM allocator
+//=============================================================================
+
+void *psram_malloc(size_t size) { return malloc(size); }
+void *psram_realloc(void *ptr, size_t size) { return realloc(ptr, size); }
+void psram_free(void *ptr) { free(ptr); }
+
+
+//=============================================================================
+// Input (no keys pressed, joysticks centered)
+//=============================================================================
+
+void input_rp2350_poll(uint8_t *key_matrix, uint8_t *rev_matrix, uint8_t *joystick)
+{
+    memset(key_matrix, 0xff, 8);
+    memset(rev_matrix, 0xff, 8);
+    *joystick = 0xff;
+}
+
+uint8_t input_get_joystick2(void)
+{
+    return 0xff;
+}
+
+bool disk_ui_is_visible(void)
+{
+    return false;
+}
+
+
+//=============================================================================
+// Audio sink (samples are counted and hashed instead of played)
+//=============================================================================
+
+static uint64_t audio_samples;
+static uint32_t audio_hash = 2166136261u;
+static sid_out_t audio_block[256 * SID_OUT_CHANNELS];
+
+sid_out_t *sid_get_write_block(unsigned *count)
+{
+    *count = sizeof(audio_block) / sizeof(audio_block[0]) / SID_OUT_CHANNELS;
+    return audio_block;
+}
+
+void sid_commit_samples(unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i) {
+        // Hashed as a stereo pair in both ring formats
+        uint16_t l = audio_block[i * SID_OUT_CHANNELS];
+        uint16_t r = audio_block[i * SID_OUT_CHANNELS + SID_OUT_CHANNELS - 1];
+        uint32_t s = ((uint32_t)l << 16) | r;
+        audio_hash = (audio_hash ^ s) * 16777619u;
+    }
+    audio_samples += count;
+}
+
+#if AUDIO_DIRECT
+int32_t sid_out_gain(void)
+{
+    return SID_OUT_UNITY;
+}
+#endif
+
+void sid_drop_samples(unsigned count)
+{
+}
+
+int sid_get_buffer_fill(void)
+{
+    return 0;
+}
+
+int32_t sid_get_rate_adjust(void)
+{
+    return 0;
+}
+
+void sid_get_audio_stats(sid_audio_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+void sid_reset_audio_stats(void)
+{
+}
+
+uint64_t host_audio_samples(void)
+{
+    return audio_samples;
+}
+
+uint32_t host_audio_hash(void)
+{
+    return audio_hash;
+}
+
+void host_audio_reset(void)
+{
+    audio_samples = 0;
+    audio_hash = 2166136261u;
+}
+
+}  // extern "C"
@@ -0,0 +1,45 @@
+/*
+ *  host_platform.h - Host build helpers
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ */
+
+#ifndef HOST_PLATFORM_H
+#define HOST_PLATFORM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Directory that stands in for the SD card root (host_fatfs.c)
+void host_set_sd_root(const char *dir);
+
+// Audio produced by the SID renderer since startup
+uint64_t host_audio_samples(void);
+uint32_t host_audio_hash(void);
+void host_audio_reset(void);
+
+// C64 interface (C64_rp2350.cpp)
+void c64_init(void);
+void c64_reset(void);
+bool c64_run_frame(void);
+void c64_render_lines(void);
+void c64_render_audio(void);
+void c64_run_drive(void);
+uint8_t *c64_get_framebuffer(void);
+void c64_load_file(const char *filename);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_PLATFORM_H
@@ -0,0 +1,13 @@
+/*
+ *  hardware/dma.h - Host shim (only pulled in through driver headers)
+ */
+
+#ifndef HOST_HARDWARE_DMA_H
+#define HOST_HARDWARE_DMA_H
+
+#include "pico.h"
+
+#define DMA_IRQ_0 10
+#define DMA_IRQ_1 11
+
+#endif // HOST_HARDWARE_DMA_H
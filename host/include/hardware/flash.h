@@ -0,0 +1,31 @@
+/*
+ *  hardware/flash.h - Host shim, flash is an ordinary RAM array
+ */
+
+#ifndef HOST_HARDWARE_FLASH_H
+#define HOST_HARDWARE_FLASH_H
+
+#include "pico/stdlib.h"
+
+#define FLASH_PAGE_SIZE   (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define FLASH_BLOCK_SIZE  (1u << 16)
+
+#define HOST_FLASH_SIZE   (16u << 20)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint8_t host_flash[HOST_FLASH_SIZE];
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define XIP_BASE ((uintptr_t)host_flash)
+
+#endif // HOST_HARDWARE_FLASH_H
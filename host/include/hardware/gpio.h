@@ -0,0 +1,22 @@
+/*
+ *  hardware/gpio.h - Host shim (pins are write-only no-ops)
+ */
+
+#ifndef HOST_HARDWARE_GPIO_H
+#define HOST_HARDWARE_GPIO_H
+
+#include "pico.h"
+
+#define GPIO_OUT 1
+#define GPIO_IN  0
+
+#ifndef PICO_DEFAULT_LED_PIN
+#define PICO_DEFAULT_LED_PIN 25
+#endif
+
+static inline void gpio_init(unsigned gpio) { (void)gpio; }
+static inline void gpio_set_dir(unsigned gpio, bool out) { (void)gpio; (void)out; }
+static inline void gpio_put(unsigned gpio, bool value) { (void)gpio; (void)value; }
+static inline bool gpio_get(unsigned gpio) { (void)gpio; return false; }
+
+#endif // HOST_HARDWARE_GPIO_H
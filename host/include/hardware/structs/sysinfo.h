@@ -0,0 +1,10 @@
+/*
+ *  hardware/structs/sysinfo.h - Host shim
+ */
+
+#ifndef HOST_HARDWARE_STRUCTS_SYSINFO_H
+#define HOST_HARDWARE_STRUCTS_SYSINFO_H
+
+#include "pico.h"
+
+#endif // HOST_HARDWARE_STRUCTS_SYSINFO_H
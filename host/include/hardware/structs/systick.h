@@ -0,0 +1,36 @@
+/*
+ *  hardware/structs/systick.h - Host shim
+ *
+ *  The down-counting 24-bit SysTick value is synthesized from the host
+ *  monotonic clock, scaled to CPU_CLOCK_MHZ, on every access.
+ */
+
+#ifndef HOST_HARDWARE_STRUCTS_SYSTICK_H
+#define HOST_HARDWARE_STRUCTS_SYSTICK_H
+
+#include "pico.h"
+#include <time.h>
+
+#ifndef CPU_CLOCK_MHZ
+#define CPU_CLOCK_MHZ 252
+#endif
+
+typedef struct {
+    uint32_t csr;
+    uint32_t rvr;
+    uint32_t cvr;
+    uint32_t calib;
+} systick_hw_t;
+
+static inline systick_hw_t *host_systick_hw(void) {
+    static systick_hw_t hw;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ns = (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+    hw.cvr = (uint32_t)~(ns * CPU_CLOCK_MHZ / 1000u) & 0x00ffffff;
+    return &hw;
+}
+
+#define systick_hw (host_systick_hw())
+
+#endif // HOST_HARDWARE_STRUCTS_SYSTICK_H
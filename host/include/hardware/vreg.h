@@ -0,0 +1,21 @@
+/*
+ *  hardware/vreg.h - Host shim (voltage constants only)
+ */
+
+#ifndef HOST_HARDWARE_VREG_H
+#define HOST_HARDWARE_VREG_H
+
+#include "pico.h"
+
+enum vreg_voltage {
+    VREG_VOLTAGE_1_10,
+    VREG_VOLTAGE_1_15,
+    VREG_VOLTAGE_1_20,
+    VREG_VOLTAGE_1_25,
+    VREG_VOLTAGE_1_30,
+    VREG_VOLTAGE_1_50,
+    VREG_VOLTAGE_1_60,
+    VREG_VOLTAGE_1_65,
+};
+
+#endif // HOST_HARDWARE_VREG_H
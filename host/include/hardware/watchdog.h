@@ -0,0 +1,12 @@
+/*
+ *  hardware/watchdog.h - Host shim
+ */
+
+#ifndef HOST_HARDWARE_WATCHDOG_H
+#define HOST_HARDWARE_WATCHDOG_H
+
+#include "pico.h"
+
+static inline void watchdog_update(void) {}
+
+#endif // HOST_HARDWARE_WATCHDOG_H
@@ -0,0 +1,37 @@
+/*
+ *  pico.h - Host shim for the common pico-sdk attribute macros
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Like the real SDK, every hardware/ and pico/ shim pulls this in.
+ */
+
+#ifndef HOST_PICO_H
+#define HOST_PICO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Section placement attributes are meaningless on the host
+#define __not_in_flash(group)
+#define __not_in_flash_func(func_name) func_name
+#define __time_critical_func(func_name) func_name
+#define __in_flash(group)
+#define __scratch_x(group)
+#define __scratch_y(group)
+#define __uninitialized_ram(var) var
+#ifndef __aligned
+#define __aligned(x) __attribute__((aligned(x)))
+#endif
+#ifndef __packed
+#define __packed __attribute__((packed))
+#endif
+
+#endif // HOST_PICO_H
@@ -0,0 +1,14 @@
+/*
+ *  pico/multicore.h - Host shim (single-threaded, lockout is a no-op)
+ */
+
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+#include "pico/stdlib.h"
+
+static inline void multicore_lockout_start_blocking(void) {}
+static inline void multicore_lockout_end_blocking(void) {}
+static inline void multicore_lockout_victim_init(void) {}
+
+#endif // HOST_PICO_MULTICORE_H
@@ -0,0 +1,52 @@
+/*
+ *  pico/stdlib.h - Host shim for the pico-sdk subset used by the emulator core
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Only used by the headless host build (host/CMakeLists.txt).
+ */
+
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "pico.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+
+typedef uint64_t absolute_time_t;
+
+static inline absolute_time_t get_absolute_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000u); }
+static inline uint64_t time_us_64(void) { return get_absolute_time(); }
+static inline uint32_t time_us_32(void) { return (uint32_t)get_absolute_time(); }
+
+static inline void sleep_us(uint64_t us) {
+    struct timespec ts = { (time_t)(us / 1000000u), (long)(us % 1000000u) * 1000 };
+    nanosleep(&ts, NULL);
+}
+
+static inline void sleep_ms(uint32_t ms) { sleep_us((uint64_t)ms * 1000u); }
+
+static inline void tight_loop_contents(void) {}
+
+static inline bool stdio_init_all(void) { return true; }
+
+#endif // HOST_PICO_STDLIB_H
@@ -0,0 +1,5 @@
+/*
+ *  pico/time.h - Host shim, see pico/stdlib.h
+ */
+
+#include "pico/stdlib.h"
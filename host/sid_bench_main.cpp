@@ -0,0 +1,534 @@
+/*
+ *  sid_bench_main.cpp - SID renderer benchmark
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Replays a SID register log through the MOS6581 and its renderer, line
+ *  by line without the rest of the C64, once with the per-sample renderer
+ *  and once with the block renderer (Prefs::SIDBlockRender), and reports
+ *  the time and cycles per sample of each. Both must produce the same PCM.
+ *
+ *  The log is a generated three-voice tune: notes on all waveforms with
+ *  gate/ADSR changes, a pulse-width sweep, a filter sweep over all filter
+ *  modes, a section using hard sync and a 4-bit digi played through the
+ *  volume register.
+ *
+ *  Both renderers are then run again with band-limited oscillators
+ *  (Prefs::SIDBandLimit), which must also agree with each other.
+ *
+ *  The same tune, shifted by a few notes, is then played on two and three
+ *  SIDs (extra SIDs at $d420 and $d500, mixed in stereo) to show what the
+ *  extra SIDs cost.
+ *
+ *  With -log, a log recorded by a SID_CAPTURE build (sid_capture.h) is
+ *  replayed instead of the generated tune, with the SID type and extra
+ *  SIDs it was recorded with. -expect then checks the PCM hash against a
+ *  known value, so a set of captured tunes serves as a regression test
+ *  for the SID renderer: same hash, and the time per sample.
+ *
+ *  It then runs the fixed-point filter (sid_filter.h) and its float
+ *  reference on the same signal, sweeping the cutoff for every resonance
+ *  and filter mode, and reports the difference as signal-to-error ratio.
+ *
+ *  Finally it checks the combined waveform tables expanded into SRAM
+ *  against the original tables and reports the time of the expansion.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "host_platform.h"
+
+#include "sysdeps.h"
+#include "C64.h"
+#include "SID.h"
+#include "VIC.h"
+#include "Prefs.h"
+#include "sid_filter.h"
+#include "sid_capture.h"
+
+// The original 16-bit tables, to check the expanded ones against
+#include "SID_wave_tables.h"
+
+extern C64 *TheC64;
+
+// One register write of the log
+struct SIDLogEntry {
+    uint32_t line;      // Raster line, counted from the start of the log
+    uint8_t cycle;      // Cycle within that line
+    uint8_t chip;       // 0 = SID at $d400, 1/2 = extra SIDs
+    uint8_t reg;
+    uint8_t val;
+};
+
+static void add(std::vector<SIDLogEntry> &log, uint8_t chip, uint32_t line, uint8_t cycle, uint8_t reg, uint8_t val)
+{
+    log.push_back({ line, cycle, chip, reg, val });
+}
+
+// The tune for one SID, the extra SIDs play it a few notes higher
+static std::vector<SIDLogEntry> make_chip_log(unsigned frames, uint8_t chip)
+{
+    // Waveform + gate per voice and note, cycling through all waveforms
+    static const uint8_t wave_v1[] = { 0x21, 0x41, 0x11, 0x31, 0x61 };
+    static const uint8_t wave_v2[] = { 0x41, 0x11, 0x21, 0x51, 0x71 };
+    static const uint8_t wave_v3[] = { 0x81, 0x11, 0x21, 0x41 };
+    static const uint16_t notes[] = {
+        0x1125, 0x1468, 0x16e3, 0x1b3a, 0x224b, 0x28d0, 0x2dc6, 0x3674
+    };
+
+    std::vector<SIDLogEntry> log;
+    add(log, chip, 0, 10, 0x18, 0x1f);    // Volume 15, low-pass
+    add(log, chip, 0, 14, 0x17, 0xa3);    // Voices 1 and 2 filtered, resonance 10
+
+    for (unsigned f = 0; f < frames; ++f) {
+        uint32_t line = f * TOTAL_RASTERS;
+        unsigned note = f / 8 + chip * 3;
+
+        // Player call in the raster IRQ: a new note every 8 frames
+        if (f % 8 == 0) {
+            for (unsigned v = 0; v < 3; ++v) {
+                uint8_t base = v * 7;
+                uint16_t freq = notes[(note + v * 3) % 8] >> (v == 2 ? 1 : 0);
+                uint8_t wave = v == 0 ? wave_v1[note % 5] : v == 1 ? wave_v2[note % 5] : wave_v3[note % 4];
+
+                // Hard sync of voice 1 by voice 3 for a stretch
+                if (v == 0 && note % 16 >= 12) {
+                    wave |= 0x02;
+                }
+
+                add(log, chip, line, 20 + v * 8, base + 0, freq & 0xff);
+                add(log, chip, line, 24 + v * 8, base + 1, freq >> 8);
+                add(log, chip, line, 28 + v * 8, base + 5, v == 2 ? 0x09 : 0x26);
+                add(log, chip, line, 32 + v * 8, base + 6, v == 2 ? 0x00 : 0xa8);
+                add(log, chip, line, 36 + v * 8, base + 4, wave);
+            }
+        } else if (f % 8 == 6) {
+            // Gate off
+            add(log, chip, line, 20, 0x04, wave_v1[note % 5] & 0xfe);
+            add(log, chip, line, 28, 0x0b, wave_v2[note % 5] & 0xfe);
+            add(log, chip, line, 36, 0x12, wave_v3[note % 4] & 0xfe);
+        }
+
+        // Pulse width and filter sweep
+        uint16_t pw = 0x200 + (f * 37) % 0xc00;
+        add(log, chip, line + 1, 10, 0x02, pw & 0xff);
+        add(log, chip, line + 1, 14, 0x03, pw >> 8);
+        add(log, chip, line + 1, 18, 0x09, (0x800 - pw) & 0xff);
+        add(log, chip, line + 1, 22, 0x0a, (0x800 - pw) >> 8);
+        uint16_t fc = (f * 13) % 0x800;
+        add(log, chip, line + 1, 30, 0x15, fc & 7);
+        add(log, chip, line + 1, 34, 0x16, fc >> 3);
+
+        // Filter mode changes every 64 frames (LP, BP, HP, LP+HP)
+        static const uint8_t modes[] = { 0x1f, 0x2f, 0x4f, 0x5f };
+        if (f % 64 == 0) {
+            add(log, chip, line + 2, 10, 0x18, modes[(f / 64) % 4]);
+        }
+
+        // 4-bit digi through the volume register, written twice per line
+        // (about 31 kHz) for 8 of every 64 frames
+        if (f % 64 >= 32 && f % 64 < 40) {
+            for (unsigned l = 3; l < TOTAL_RASTERS; ++l) {
+                for (unsigned w = 0; w < 2; ++w) {
+                    unsigned t = (f * TOTAL_RASTERS + l) * 2 + w;
+                    uint8_t vol = (uint8_t)(7.5f + 7.5f * sinf(t * (2.0f * 3.14159265f / (29 + chip * 4))) + 0.5f);
+                    add(log, chip, line + l, 8 + w * 31, 0x18, (modes[(f / 64) % 4] & 0xf0) | vol);
+                }
+            }
+            if (f % 64 == 39) {
+                add(log, chip, line + TOTAL_RASTERS - 1, 60, 0x18, modes[(f / 64) % 4]);
+            }
+        }
+    }
+    return log;
+}
+
+// The tunes of all SIDs, in the order of their raster lines
+static std::vector<SIDLogEntry> make_log(unsigned frames, unsigned chips = 1)
+{
+    std::vector<SIDLogEntry> log;
+    for (unsigned chip = 0; chip < chips; ++chip) {
+        std::vector<SIDLogEntry> chip_log = make_chip_log(frames, chip);
+        log.insert(log.end(), chip_log.begin(), chip_log.end());
+    }
+    std::stable_sort(log.begin(), log.end(), [](const SIDLogEntry &a, const SIDLogEntry &b) {
+        return a.line < b.line;
+    });
+    return log;
+}
+
+// Setup of a captured log
+struct CaptureInfo {
+    int sid_type;
+    uint16_t sid2_adr;
+    uint16_t sid3_adr;
+};
+
+// Read a log recorded with SID_CAPTURE; the silence before the first write
+// is dropped
+static bool load_capture(const char *path, std::vector<SIDLogEntry> &log, unsigned &frames, CaptureInfo &info)
+{
+    std::ifstream f(path, std::ios::binary);
+    if (!f) {
+        printf("Cannot open %s\n", path);
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+
+    const uint8_t *h = data.data();
+    if (data.size() < SID_CAPTURE_HEADER_SIZE || memcmp(h, "SIDL", 4) != 0 || h[4] != SID_CAPTURE_VERSION) {
+        printf("%s is not a SID capture log\n", path);
+        return false;
+    }
+    if (h[6] != CYCLES_PER_LINE || (h[8] | h[9] << 8) != TOTAL_RASTERS) {
+        printf("%s was recorded with %u cycles x %u lines, this build has %u x %u\n",
+               path, h[6], h[8] | h[9] << 8, CYCLES_PER_LINE, TOTAL_RASTERS);
+        return false;
+    }
+    info.sid_type = h[5];
+    info.sid2_adr = h[10] | h[11] << 8;
+    info.sid3_adr = h[12] | h[13] << 8;
+
+    // Record lines count the EmulateLine() calls before the write, replay()
+    // writes after EmulateLine() of the line
+    log.clear();
+    uint32_t line = 0;
+    for (size_t i = SID_CAPTURE_HEADER_SIZE; i + SID_CAPTURE_RECORD_SIZE <= data.size(); i += SID_CAPTURE_RECORD_SIZE) {
+        const uint8_t *r = &data[i];
+        if (r[0] == SID_CAPTURE_SKIP) {
+            line += r[1] | r[2] << 8 | r[3] << 16;
+        } else {
+            line += r[3];
+            add(log, r[0] >> 5, line, r[2], r[0] & 0x1f, r[1]);
+        }
+    }
+    if (log.empty()) {
+        printf("%s has no register writes\n", path);
+        return false;
+    }
+
+    uint32_t first = log.front().line;
+    for (SIDLogEntry &w : log) {
+        w.line -= first;
+    }
+    frames = (line - first) / TOTAL_RASTERS + 1;
+    return true;
+}
+
+struct Result {
+    uint64_t samples;
+    uint32_t hash;
+    double ns;
+    uint64_t cycles;
+};
+
+static uint64_t read_cycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static Result replay(const std::vector<SIDLogEntry> &log, unsigned frames, bool block, bool band_limit = false)
+{
+    MOS6581 *sid = TheC64->TheSID;
+
+    ThePrefs.SIDBlockRender = block;
+    ThePrefs.SIDBandLimit = band_limit;
+    sid->Reset();
+#if SID_WRITE_QUEUE
+    sid->RenderQueued();
+#endif
+    host_audio_reset();
+
+    size_t next = 0;
+    uint32_t lines = frames * TOTAL_RASTERS;
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t c0 = read_cycles();
+    for (uint32_t line = 0; line < lines; ++line) {
+        sid->EmulateLine();
+        for (; next < log.size() && log[next].line == line; ++next) {
+            const SIDLogEntry &w = log[next];
+            MOS6581 *target = w.chip == 0 ? sid : sid->ExtraSID(w.chip - 1);
+            target->WriteRegister(w.reg, w.val, w.cycle);
+        }
+#if SID_WRITE_QUEUE
+        sid->RenderQueued();
+#endif
+    }
+#if SID_WRITE_QUEUE
+    // No second core here to wait for; a reset renders the due samples
+    sid->Reset();
+    sid->RenderQueued();
+#else
+    sid->WaitRendered();
+#endif
+    uint64_t c1 = read_cycles();
+    auto end = std::chrono::steady_clock::now();
+
+    Result r;
+    r.samples = host_audio_samples();
+    r.hash = host_audio_hash();
+    r.ns = std::chrono::duration<double, std::nano>(end - start).count();
+    r.cycles = c1 - c0;
+    return r;
+}
+
+static void report(const char *name, const Result &r)
+{
+    printf("%-12s %10llu samples  %8.1f ns/sample", name,
+           (unsigned long long)r.samples, r.ns / r.samples);
+    if (r.cycles) {
+        printf("  %7.1f cycles/sample", (double)r.cycles / r.samples);
+    }
+    printf("  %.0f samples/s  pcm %08x\n", r.samples / (r.ns / 1e9), r.hash);
+}
+
+// Filter input: three full-scale voices (saw, pulse, noise) as the
+// renderer sums them, 8-bit envelope times signed 16-bit waveform
+static std::vector<int32_t> make_filter_input(unsigned count)
+{
+    std::vector<int32_t> in(count);
+    uint32_t saw = 0, pulse = 0, seed = 1;
+    for (unsigned i = 0; i < count; ++i) {
+        saw += 0x01000000 / 200;
+        pulse += 0x01000000 / 157;
+        seed = seed * 1103515245 + 12345;
+        int32_t v1 = (int16_t)(((saw >> 8) & 0xffff) ^ 0x8000);
+        int32_t v2 = (pulse & 0x800000) ? 32767 : -32768;
+        int32_t v3 = (int16_t)(seed >> 16);
+        in[i] = (v1 + v2 + v3) * 255;
+    }
+    return in;
+}
+
+static void set_filter_type(SIDFilter *filter, SIDFilterCurve *curve, bool is6581)
+{
+    curve->Build(is6581, 44100);
+    filter->SetCurve(curve);
+}
+
+static void set_filter_type(SIDFilterFloat *filter, SIDFilterCurve *, bool is6581)
+{
+    filter->SetType(is6581, 44100);
+}
+
+template <class Filter>
+static double run_filter(bool is6581, const std::vector<int32_t> &in, std::vector<int32_t> &out)
+{
+    static const uint8_t modes[] = { 0x10, 0x20, 0x40, 0x50 };
+    const unsigned sweep = in.size() / (16 * 4);
+
+    Filter *filter = new Filter;
+    SIDFilterCurve *curve = new SIDFilterCurve;
+    set_filter_type(filter, curve, is6581);
+    out.resize(in.size());
+
+    auto start = std::chrono::steady_clock::now();
+    unsigned i = 0;
+    for (unsigned res = 0; res < 16; ++res) {
+        for (uint8_t mode : modes) {
+            filter->Reset();
+            for (unsigned k = 0; k < sweep; ++k, ++i) {
+                if ((k & 7) == 0) {
+                    filter->SetRegs(k * 2048 / sweep, res);
+                }
+                out[i] = filter->Clock(in[i], mode);
+            }
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    delete curve;
+    delete filter;
+    return std::chrono::duration<double, std::nano>(end - start).count() / i;
+}
+
+static bool filter_parity(bool is6581)
+{
+    std::vector<int32_t> in = make_filter_input(16 * 4 * 16384);
+    std::vector<int32_t> fixed, ref;
+    double ns_fixed = run_filter<SIDFilter>(is6581, in, fixed);
+    double ns_float = run_filter<SIDFilterFloat>(is6581, in, ref);
+
+    double signal = 0, error = 0;
+    int64_t max_error = 0;
+    for (size_t i = 0; i < in.size(); ++i) {
+        int64_t d = (int64_t)fixed[i] - ref[i];
+        signal += (double)ref[i] * ref[i];
+        error += (double)d * d;
+        if (llabs(d) > max_error) {
+            max_error = llabs(d);
+        }
+    }
+    double snr = error > 0 ? 10 * log10(signal / error) : 999;
+
+    // Full scale of one voice at the output after master volume 15
+    const double full_scale = 32768.0 * 255;
+    printf("filter %s:  fixed %.1f ns/sample, float %.1f ns/sample, SNR %.1f dB, max error %.5f%% of a voice\n",
+           is6581 ? "6581" : "8580", ns_fixed, ns_float, snr, 100.0 * max_error / full_scale);
+    return snr >= 60.0;
+}
+
+// Expand the combined waveform tables of a SID type and compare them
+// with SID_wave_tables.h
+static bool wave_tables_match(int sid_type)
+{
+    bool is8580 = sid_type == SIDTYPE_DIGITAL_8580;
+    const uint16_t *ref[4] = {
+        is8580 ? MOS6581::TriSawTable_8580 : MOS6581::TriSawTable_6581,
+        is8580 ? MOS6581::TriRectTable_8580 : MOS6581::TriRectTable_6581,
+        is8580 ? MOS6581::SawRectTable_8580 : MOS6581::SawRectTable_6581,
+        is8580 ? MOS6581::TriSawRectTable_8580 : MOS6581::TriSawRectTable_6581
+    };
+
+    ThePrefs.SIDType = sid_type;
+    TheC64->TheSID->NewPrefs(&ThePrefs);
+
+    const MOS6581 *sid = TheC64->TheSID;
+    const uint8_t *table[4] = { sid->TriSawTable, sid->TriRectTable, sid->SawRectTable, sid->TriSawRectTable };
+    bool match = true;
+    for (unsigned t = 0; t < 4; ++t) {
+        for (unsigned i = 0; i < 0x1000; ++i) {
+            match = match && table[t][i] * 0x101 == ref[t][i];
+        }
+    }
+
+    printf("wave tables %s: expanded in %u us, %s\n", is8580 ? "8580" : "6581",
+           (unsigned)MOS6581::WaveTablesTime, match ? "match" : "MISMATCH");
+    return match;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned frames = 3000;
+    int sid_type = SIDTYPE_DIGITAL_6581;
+    bool type_given = false;
+    const char *log_file = nullptr;
+    uint32_t expect = 0;
+    bool check = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            frames = strtoul(argv[++i], nullptr, 0);
+        } else if (strcmp(argv[i], "-8580") == 0) {
+            sid_type = SIDTYPE_DIGITAL_8580;
+            type_given = true;
+        } else if (strcmp(argv[i], "-log") == 0 && i + 1 < argc) {
+            log_file = argv[++i];
+        } else if (strcmp(argv[i], "-expect") == 0 && i + 1 < argc) {
+            expect = strtoul(argv[++i], nullptr, 16);
+            check = true;
+        } else {
+            printf("Usage: %s [-n frames] [-8580] [-log sidcap.bin] [-expect pcm_hash]\n", argv[0]);
+            return 1;
+        }
+    }
+
+#if SID_CAPTURE
+    // The capture would replace the log in the SD root and slow down
+    // every register write
+    printf("Build murmc64_sidbench without SID_CAPTURE\n");
+    return 1;
+#endif
+
+    std::vector<SIDLogEntry> log;
+    CaptureInfo info = { sid_type, 0, 0 };
+    if (log_file != nullptr) {
+        if (!load_capture(log_file, log, frames, info)) {
+            return 1;
+        }
+        if (type_given) {
+            info.sid_type = sid_type;
+        }
+    } else {
+        log = make_log(frames);
+    }
+
+    c64_init();
+
+    ThePrefs.SIDType = info.sid_type;
+    ThePrefs.SID2Address = info.sid2_adr;
+    ThePrefs.SID3Address = info.sid3_adr;
+    TheC64->TheSID->NewPrefs(&ThePrefs);
+
+    printf("SID log:     %s, %u frames, %zu register writes, %s",
+           log_file != nullptr ? log_file : "generated", frames, log.size(),
+           info.sid_type == SIDTYPE_DIGITAL_8580 ? "8580" : "6581");
+    if (info.sid2_adr) {
+        printf(", SID2 at $%04x", info.sid2_adr);
+    }
+    if (info.sid3_adr) {
+        printf(", SID3 at $%04x", info.sid3_adr);
+    }
+    printf("\n");
+
+    Result single = replay(log, frames, false);
+    Result block = replay(log, frames, true);
+    report("per-sample", single);
+    report("block", block);
+    printf("speedup:     %.2fx\n", single.ns / block.ns);
+
+    bool same = single.samples == block.samples && single.hash == block.hash;
+    printf("%s\n", same ? "pcm: identical" : "pcm: MISMATCH");
+
+    if (check) {
+        bool expected = block.hash == expect;
+        if (expected) {
+            printf("pcm %08x: as expected\n", block.hash);
+        } else {
+            printf("pcm %08x: CHANGED, expected %08x\n", block.hash, expect);
+        }
+        same = same && expected;
+    }
+
+    // Band-limited oscillators, again with both renderers
+    Result bl_single = replay(log, frames, false, true);
+    Result bl_block = replay(log, frames, true, true);
+    report("band-limit", bl_block);
+    printf("             %.2fx the time of the naive oscillators\n", bl_block.ns / block.ns);
+    bool bl_same = bl_single.samples == bl_block.samples && bl_single.hash == bl_block.hash;
+    printf("%s\n", bl_same ? "band-limit pcm: identical" : "band-limit pcm: MISMATCH");
+    same = same && bl_same;
+
+    // Two and three SIDs in stereo
+    static const int extra_adr[2][2] = { { 0xd420, 0 }, { 0xd420, 0xd500 } };
+    for (unsigned chips = 2; log_file == nullptr && chips <= SID_MAX_CHIPS; ++chips) {
+        ThePrefs.SID2Address = extra_adr[chips - 2][0];
+        ThePrefs.SID3Address = extra_adr[chips - 2][1];
+        TheC64->TheSID->NewPrefs(&ThePrefs);
+
+        Result multi = replay(make_log(frames, chips), frames, true);
+        char name[16];
+        snprintf(name, sizeof(name), "%u SIDs", chips);
+        report(name, multi);
+        printf("             %.2fx the time of one SID\n", multi.ns / block.ns);
+    }
+    ThePrefs.SID2Address = ThePrefs.SID3Address = 0;
+    TheC64->TheSID->NewPrefs(&ThePrefs);
+
+    bool parity = filter_parity(info.sid_type != SIDTYPE_DIGITAL_8580);
+    printf("%s\n", parity ? "filter: matches float" : "filter: MISMATCH");
+
+    bool tables = wave_tables_match(SIDTYPE_DIGITAL_8580) && wave_tables_match(SIDTYPE_DIGITAL_6581);
+    return same && parity && tables ? 0 : 1;
+}
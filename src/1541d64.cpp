@@ -23,6 +23,15 @@
  *   - No support for relative files
  *   - Unimplemented commands: P
  *   - Impossible to implement: B-E, M-E
+ *
+ *  Notes:
+ *   - With IMAGE_CACHE, the sector data of the whole image is read into
+ *     memory when it is mounted and all block accesses are served from
+ *     there. Written sectors are marked dirty and written back to the
+ *     file in runs of consecutive sectors when the drive becomes idle (the
+ *     last file or buffer channel is closed), on reset, before formatting,
+ *     and when the image is unmounted. If the buffer can't be allocated or
+ *     the image is truncated, the file is accessed directly as before.
  */
 
 #include "sysdeps.h"
@@ -157,6 +166,9 @@ inline unsigned d81_accum_sectors(unsigned track) { return (track - 1) * D81_SEC
 static bool match(const uint8_t *p, int p_len, const uint8_t *n);
 static FILE *open_image_file(const std::string & path, bool write_mode);
 static bool parse_image_file(FILE *f, image_file_desc &desc);
+#if IMAGE_CACHE
+static void release_cache_slot(int slot);
+#endif
 
 
 /*
@@ -165,6 +177,13 @@ static bool parse_image_file(FILE *f, image_file_desc &desc);
 
 ImageDrive::ImageDrive(IEC *iec, const std::string & filepath) : Drive(iec), the_file(nullptr), bam(ram + 0x700), bam_dirty(false), bam2_dirty(false)
 {
+#if IMAGE_CACHE
+	cache = nullptr;
+	cache_slot = -1;
+	cache_sectors = 0;
+	cache_num_dirty = 0;
+#endif
+
 	desc.type = TYPE_D64;
 	desc.header_size = 0;
 	desc.num_tracks = 35;
@@ -223,6 +242,12 @@ void ImageDrive::close_image()
 				bam_dirty = false;
 			}
 		}
+#if IMAGE_CACHE
+		flush_cache();
+		release_cache_slot(cache_slot);
+		cache = nullptr;
+		cache_slot = -1;
+#endif
 		fclose(the_file);
 		the_file = nullptr;
 	}
@@ -254,6 +279,11 @@ bool ImageDrive::change_image(const std::string & path)
 			return false;
 		}
 
+#if IMAGE_CACHE
+		// Read sector data into memory
+		load_cache();
+#endif
+
 		// Read BAM
 		if (is_d81()) {
 			// D81: Read both BAM sectors (40/1 and 40/2)
@@ -822,6 +852,22 @@ free:		free_buffer(ch[channel].buf_num);
 			break;
 	}
 
+#if IMAGE_CACHE
+	// Drive idle? Then write modified sectors back to the file
+	if (cache_num_dirty) {
+		bool idle = true;
+		for (unsigned i = 0; i < 18; ++i) {
+			if (i != 15 && ch[i].mode != CHMOD_FREE) {
+				idle = false;
+				break;
+			}
+		}
+		if (idle) {
+			flush_cache();
+		}
+	}
+#endif
+
 	return ST_OK;
 }
 
@@ -1024,6 +1070,10 @@ void ImageDrive::Reset()
 		}
 	}
 
+#if IMAGE_CACHE
+	flush_cache();
+#endif
+
 	memset(ram, 0, sizeof(ram));
 
 	if (is_d81()) {
@@ -1604,10 +1654,151 @@ static int write_sector(FILE *f, const image_file_desc &desc, int track, int sec
 	}
 }
 
+#if IMAGE_CACHE
+
+// Number of sectors in image
+static unsigned image_num_sectors(const image_file_desc &desc)
+{
+	if (desc.type == TYPE_D81) {
+		return NUM_SECTORS_D81;
+	} else if (desc.num_tracks >= 1 && desc.num_tracks <= 40) {
+		return accum_num_sectors[desc.num_tracks] + num_sectors[desc.num_tracks];
+	} else {
+		return 0;
+	}
+}
+
+// Cache buffers, one slot per drive. Buffers in PSRAM can't be freed, so
+// they are kept when an image is unmounted and reused for the next one.
+struct cache_slot_desc {
+	uint8_t *buf;
+	size_t size;
+	bool in_use;
+};
+
+static cache_slot_desc cache_slots[4];
+
+// Get buffer of at least the given size, returns slot number or -1
+static int acquire_cache_slot(size_t size)
+{
+	int slot = -1;
+	for (int i = 0; i < 4; ++i) {
+		if (cache_slots[i].in_use)
+			continue;
+		if (cache_slots[i].size >= size) {
+			slot = i;
+			break;
+		}
+		if (slot < 0 || cache_slots[i].buf == nullptr) {
+			slot = i;
+		}
+	}
+	if (slot < 0)
+		return -1;
+
+	cache_slot_desc &c = cache_slots[slot];
+	if (c.size < size) {
+#ifdef PSRAM_MAX_FREQ_MHZ
+		uint8_t *buf = (uint8_t *)psram_malloc(size);
+#else
+		free(c.buf);
+		c.buf = nullptr;
+		c.size = 0;
+		uint8_t *buf = (uint8_t *)malloc(size);
+#endif
+		if (buf == nullptr)
+			return -1;
+		c.buf = buf;
+		c.size = size;
+	}
+	c.in_use = true;
+	return slot;
+}
+
+static void release_cache_slot(int slot)
+{
+	if (slot >= 0) {
+		cache_slots[slot].in_use = false;
+	}
+}
+
+// Read sector data of image file into memory
+void ImageDrive::load_cache()
+{
+	if (cache == nullptr) {
+		cache_sectors = image_num_sectors(desc);
+		if (cache_sectors == 0)
+			return;
+		cache_slot = acquire_cache_slot(cache_sectors << 8);
+		if (cache_slot < 0)
+			return;
+		cache = cache_slots[cache_slot].buf;
+	}
+
+	memset(cache_dirty, 0, sizeof(cache_dirty));
+	cache_num_dirty = 0;
+
+	fseek(the_file, desc.header_size, SEEK_SET);
+	if (fread(cache, 256, cache_sectors, the_file) != cache_sectors) {
+
+		// Truncated image, access file directly
+		release_cache_slot(cache_slot);
+		cache = nullptr;
+		cache_slot = -1;
+	}
+}
+
+// Write modified sectors back to image file
+void ImageDrive::flush_cache()
+{
+	if (cache == nullptr || cache_num_dirty == 0)
+		return;
+
+	unsigned i = 0;
+	while (i < cache_sectors) {
+		if (!(cache_dirty[i >> 3] & (1 << (i & 7)))) {
+			++i;
+			continue;
+		}
+
+		// Write run of consecutive modified sectors
+		unsigned first = i;
+		while (i < cache_sectors && (cache_dirty[i >> 3] & (1 << (i & 7)))) {
+			++i;
+		}
+		if (fseek(the_file, desc.header_size + (first << 8), SEEK_SET) != 0
+		 || fwrite(cache + (first << 8), 256, i - first, the_file) != i - first) {
+			set_error(ERR_WRITE25);
+			continue;	// Keep the run dirty, retried by the next flush
+		}
+
+		// Written, the run is clean now
+		for (unsigned j = first; j < i; ++j) {
+			cache_dirty[j >> 3] &= ~(1 << (j & 7));
+		}
+		cache_num_dirty -= i - first;
+	}
+	fflush(the_file);
+}
+
+#endif
+
 // Read sector and set error message, returns false on error
 bool ImageDrive::read_sector(int track, int sector, uint8_t *buffer)
 {
-	int error = ::read_sector(the_file, desc, track, sector, buffer);
+	int error;
+#if IMAGE_CACHE
+	if (cache) {
+		long offset = offset_from_ts(desc, track, sector);
+		if (offset < 0) {
+			error = ERR_ILLEGALTS;
+		} else {
+			memcpy(buffer, cache + (offset - desc.header_size), 256);
+			error = ConvErrorInfo(error_info_for_sector(desc, track, sector));
+		}
+	} else
+#endif
+	error = ::read_sector(the_file, desc, track, sector, buffer);
 	if (error) {
 		set_error(error, track, sector);
 	}
@@ -1617,7 +1808,26 @@ bool ImageDrive::read_sector(int track, int sector, uint8_t *buffer)
 // Write sector and set error message, returns false on error
 bool ImageDrive::write_sector(int track, int sector, uint8_t *buffer)
 {
-	int error = ::write_sector(the_file, desc, track, sector, buffer);
+	int error;
+#if IMAGE_CACHE
+	if (cache) {
+		long offset = offset_from_ts(desc, track, sector);
+		if (offset < 0) {
+			error = ERR_ILLEGALTS;
+		} else if (write_protected) {
+			error = ERR_WRITE25;	// Like a failed fwrite() to the read-only file
+		} else {
+			memcpy(cache + (offset - desc.header_size), buffer, 256);
+			unsigned num = (offset - desc.header_size) >> 8;
+			if (!(cache_dirty[num >> 3] & (1 << (num & 7)))) {
+				cache_dirty[num >> 3] |= 1 << (num & 7);
+				++cache_num_dirty;
+			}
+			error = ERR_OK;
+		}
+	} else
+#endif
+	error = ::write_sector(the_file, desc, track, sector, buffer);
 	if (error) {
 		set_error(error, track, sector);
 	}
@@ -2030,7 +2240,15 @@ void ImageDrive::new_cmd(const uint8_t *name, int name_len, const uint8_t *comma
 	}
 
 	// Format disk image
+#if IMAGE_CACHE
+	flush_cache();
 	format_image(the_file, desc, comma, id1, id2, name, name_len);
+	if (cache) {
+		load_cache();
+	}
+#else
+	format_image(the_file, desc, comma, id1, id2, name, name_len);
+#endif
 
 	// Re-read BAM
 	read_sector(DIR_TRACK, 0, bam);
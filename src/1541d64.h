@@ -36,6 +36,16 @@ constexpr unsigned NUM_SECTORS_35 = 683;	// Number of sectors in a 35-track imag
 constexpr unsigned NUM_SECTORS_40 = 768;	// Number of sectors in a 40-track image
 constexpr unsigned NUM_SECTORS_D81 = 3200;	// Number of sectors in a D81 image (80 tracks * 40 sectors)
 
+// Keep the sector data of the mounted image in memory (PSRAM on the
+// device) instead of seeking and reading the SD card for every block
+#ifndef IMAGE_CACHE
+#if defined(PSRAM_MAX_FREQ_MHZ) || defined(FRODO_HOST)
+#define IMAGE_CACHE 1
+#else
+#define IMAGE_CACHE 0
+#endif
+#endif
+
 // Disk image types
 enum {
 	TYPE_D64,			// D64 file
@@ -113,6 +123,11 @@ private:
 	bool write_sector(int track, int sector, uint8_t *buffer);
 	void write_error_info();
 
+#if IMAGE_CACHE
+	void load_cache();
+	void flush_cache();
+#endif
+
 	void block_read_cmd(int channel, int track, int sector, bool user_cmd = false) override;
 	void block_write_cmd(int channel, int track, int sector, bool user_cmd = false) override;
 	void block_allocate_cmd(int track, int sector) override;
@@ -138,6 +153,14 @@ private:
 	uint8_t bam2[256];		// Second BAM sector for D81 (tracks 41-80)
 	bool bam2_dirty;		// Flag: second BAM modified (D81 only)
 
+#if IMAGE_CACHE
+	uint8_t *cache;			// Sector data of the image (nullptr = read/write the file directly)
+	int cache_slot;			// Buffer slot the cache was taken from
+	unsigned cache_sectors;	// Number of sectors in cache
+	unsigned cache_num_dirty;	// Number of modified sectors not yet written to the file
+	uint8_t cache_dirty[(NUM_SECTORS_D81 + 7) / 8];	// Modified sectors (1 bit/sector)
+#endif
+
 	channel_desc ch[18];	// Descriptors for channels 0..17 (16 = internal read, 17 = internal write)
 	bool buf_free[4];		// Flags: buffer 0..3 free?
 
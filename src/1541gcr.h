@@ -50,6 +50,7 @@ public:
 	void NewPrefs(const Prefs * prefs);
 
 	void SetMotor(bool on) { motor_on = on; }
+	bool Quiet() const { return !motor_on && disk_change_seq == 0; }	// Motor off, no disk change in progress
 	void SetBitRate(uint8_t rate);
 	void MoveHeadOut();
 	void MoveHeadIn();
@@ -84,6 +84,9 @@ class Cartridge;
 class MOS6502_1541;
 class GCRDisk;
 class Tape;
+#ifdef FRODO_RP2350
+class Scheduler;
+#endif
 struct Snapshot;
 
 
@@ -162,6 +165,10 @@ public:
 
 	Tape * TheTape;				// Datasette object
 
+#ifdef FRODO_RP2350
+	Scheduler * TheScheduler;	// CIA timer and TOD events
+#endif
+
 #ifndef FRODO_RP2350
 	// Builtin ROM data (desktop: static members, defined in C64_ROM.cpp)
 	static const uint8_t BuiltinBasicROM[BASIC_ROM_SIZE];
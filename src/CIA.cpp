@@ -24,8 +24,13 @@
  *
  *  - The EmulateLine() function is called for every emulated raster line.
  *    It counts down the timers and triggers interrupts if necessary.
- *  - The TOD clocks are counted by CountTOD() during the VBlank, so the
- *    input frequency is 50Hz.
+ *  - With a Scheduler (SetScheduler()), EmulateLine() is not used. The
+ *    timers are counted when their registers are accessed, and CountTo()
+ *    is called when an underflow that raises an interrupt or counts
+ *    timer B is due. Underflows are counted exactly, also several in one
+ *    call, and the reload keeps the remaining cycles.
+ *  - The TOD clocks are counted by CountTOD() during the VBlank (or by a
+ *    scheduled event at the same rate), so the input frequency is 50Hz.
  *  - The fields KeyMatrix and RevMatrix contain one bit for each key on the
  *    C64 keyboard (0: key pressed, 1: key released). KeyMatrix is used for
  *    normal keyboard polling (PRA->PRB), RevMatrix for reversed polling
@@ -68,6 +73,11 @@ void MOS6526::Reset()
 	tod_halted = true;
 	tod_latched = false;
 	tod_alarm = false;
+
+	if (sched != nullptr) {
+		timer_cycle = sched->Now();
+		schedule_timers();
+	}
 }
 
 void MOS6526_1::Reset()
@@ -92,6 +102,7 @@ void MOS6526_2::Reset()
 
 	// IEC
 	IECLines = 0x38;	// DATA, CLK, ATN high
+	the_cpu_1541->WriteIECLines(the_cpu->CycleCounter(), IECLines);
 }
 
 
@@ -202,6 +213,11 @@ void MOS6526::SetState(const MOS6526State * s)
 
 	ta.pb_toggle = s->ta_pb_toggle;
 	tb.pb_toggle = s->tb_pb_toggle;
+
+	if (sched != nullptr) {
+		timer_cycle = sched->Now();
+		schedule_timers();
+	}
 }
 
 void MOS6526_2::SetState(const MOS6526State * s)
@@ -210,6 +226,7 @@ void MOS6526_2::SetState(const MOS6526State * s)
 
 	uint8_t inv_out = ~pra & ddra;
 	IECLines = inv_out & 0x38;
+	the_cpu_1541->WriteIECLines(the_cpu->CycleCounter(), IECLines);
 }
 
 
@@ -269,7 +286,7 @@ uint8_t MOS6526_2::ReadRegister(uint8_t reg)
 {
 	switch (reg) {
 		case 0: {	// Port A: IEC port
-			uint8_t in = ((the_cpu_1541->CalcIECLines() & 0x30) << 2)	// DATA and CLK from bus
+			uint8_t in = ((the_cpu_1541->ReadIECLines(the_cpu->CycleCounter()) & 0x30) << 2)	// DATA and CLK from bus
 			           | 0x3f;											// Other lines high
 			SetPAIn(in);
 			break;
@@ -323,10 +340,8 @@ inline void MOS6526_2::write_pa(uint8_t inv_out)
 	uint8_t old_lines = IECLines;
 	IECLines = inv_out & 0x38;
 
-	if ((IECLines ^ old_lines) & 0x08) {	// ATN changed
-		if (old_lines & 0x08) {				// ATN 1->0
-			the_cpu_1541->TriggerIECInterrupt();
-		}
+	if (IECLines != old_lines) {	// The drive sees it at this cycle, interrupt on ATN 1->0
+		the_cpu_1541->WriteIECLines(the_cpu->CycleCounter(), IECLines);
 	}
 }
 
@@ -349,43 +364,109 @@ void MOS6526_2::WriteRegister(uint8_t reg, uint8_t byte)
 
 void MOS6526::EmulateLine(int cycles)
 {
-	unsigned long tmp;
+	count_timers(cycles);
+}
 
-	// Timer A
-	if ((cra & 0x21) == 0x01) {		// Counting Phi2 and started?
-		ta.counter = tmp = ta.counter - cycles;		// Decrement timer
 
-		if (tmp > 0xffff) {			// Underflow?
-			ta.counter = ta.latch;	// Reload timer
+/*
+ *  Count a timer down by ticks, returns the number of underflows
+ */
 
-			if (cra & 8) {			// One-shot?
-				cra &= ~1;			// Stop timer
-			}
+static unsigned count_timer(uint16_t & counter, uint16_t latch, uint8_t & cr, uint32_t ticks)
+{
+	if (ticks <= counter) {
+		counter -= ticks;
+		return 0;
+	}
 
-			set_int_flag(1);
+	ticks -= counter + 1;		// Ticks after the first underflow
+	if (cr & 8) {				// One-shot?
+		cr &= ~1;				// Stop timer
+		counter = latch;
+		return 1;
+	}
 
-			if ((crb & 0x41) == 0x41) {		// Timer B counting underflows of Timer A and started?
-				tb.counter = tmp = tb.counter - 1;
-				if (tmp > 0xffff) goto tb_underflow;
-			}
+	uint32_t period = latch + 1;
+	counter = latch - ticks % period;	// Reload timer
+	return 1 + ticks / period;
+}
+
+
+/*
+ *  Count the timers down by the given number of cycles
+ */
+
+void MOS6526::count_timers(uint32_t cycles)
+{
+	unsigned ta_underflows = 0;
+
+	// Timer A
+	if ((cra & 0x21) == 0x01) {		// Counting Phi2 and started?
+		ta_underflows = count_timer(ta.counter, ta.latch, cra, cycles);
+		if (ta_underflows) {
+			set_int_flag(1);
 		}
 	}
 
 	// Timer B
+	uint32_t tb_ticks = 0;
 	if ((crb & 0x61) == 0x01) {		// Count Phi2 and started?
-		tb.counter = tmp = tb.counter - cycles;		// Decrement timer
+		tb_ticks = cycles;
+	} else if ((crb & 0x41) == 0x41) {	// Counting underflows of Timer A and started?
+		tb_ticks = ta_underflows;
+	}
+	if (tb_ticks && count_timer(tb.counter, tb.latch, crb, tb_ticks)) {
+		set_int_flag(2);
+	}
+}
 
-		if (tmp > 0xffff) {			// Underflow?
-tb_underflow:
-			tb.counter = tb.latch;	// Reload timer
 
-			if (crb & 8) {			// One-shot?
-				crb &= ~1;			// Stop timer
-			}
+/*
+ *  Let a scheduler drive the timers
+ */
 
-			set_int_flag(2);
-		}
+void MOS6526::SetScheduler(Scheduler * s, unsigned event)
+{
+	sched = s;
+	sched_event = event;
+	timer_cycle = sched->Now();
+	schedule_timers();
+}
+
+
+/*
+ *  Count the timers up to a scheduler cycle (when their event is due)
+ */
+
+void MOS6526::CountTo(uint32_t cycle)
+{
+	count_timers(cycle - timer_cycle);
+	timer_cycle = cycle;
+	schedule_timers();
+}
+
+
+/*
+ *  Schedule the next underflow that raises an interrupt or counts timer B.
+ *  Other underflows only set ICR bits and reload the counter, which is
+ *  done when the registers are read.
+ */
+
+void MOS6526::schedule_timers()
+{
+	if (sched == nullptr) {
+		return;
+	}
+
+	uint32_t next = EVENT_NEVER;
+	bool ta_counts_tb = (crb & 0x41) == 0x41;
+	if ((cra & 0x21) == 0x01 && ((int_mask & 1) || ta_counts_tb)) {
+		next = ta.counter + 1;
+	}
+	if ((crb & 0x61) == 0x01 && (int_mask & 2) && tb.counter + 1u < next) {
+		next = tb.counter + 1;
 	}
+	sched->Schedule(sched_event, timer_cycle + next);
 }
 
 
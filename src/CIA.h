@@ -22,6 +22,7 @@
 #define CIA_H
 
 #include "Prefs.h"
+#include "Scheduler.h"
 
 
 class MOS6510;
@@ -45,6 +46,8 @@ public:
 	void EmulateCycle();
 #else
 	void EmulateLine(int cycles);
+	void SetScheduler(Scheduler * sched, unsigned event);
+	void CountTo(uint32_t cycle);
 #endif
 	void CountTOD();
 
@@ -97,6 +100,18 @@ protected:
 
 #ifdef FRODO_SC
 	void emulate_timer(Timer & t, uint8_t & cr, bool input);
+#else
+	void count_timers(uint32_t cycles);
+	void sync_timers();
+	void schedule_timers();
+
+	// With a scheduler, the timers are counted up to the current cycle
+	// when they are read or written and when an underflow is due that
+	// raises an interrupt or counts timer B. Without one, EmulateLine()
+	// counts them.
+	Scheduler * sched = nullptr;
+	unsigned sched_event = 0;
+	uint32_t timer_cycle = 0;	// Scheduler cycle the counters are valid for
 #endif
 	uint8_t timer_on_pb(uint8_t prb) const;
 
@@ -259,6 +274,21 @@ inline void MOS6526::TriggerFlagLine()
 }
 
 
+#ifndef FRODO_SC
+/*
+ *  Count the timers up to the current scheduler cycle
+ */
+
+inline void MOS6526::sync_timers()
+{
+	if (sched != nullptr && sched->Now() != timer_cycle) {
+		count_timers(sched->Now() - timer_cycle);
+		timer_cycle = sched->Now();
+	}
+}
+#endif
+
+
 /*
  *  Check for TOD alarm
  */
@@ -283,6 +313,12 @@ inline void MOS6526::check_tod_alarm()
 
 inline uint8_t MOS6526::read_register(uint8_t reg)
 {
+#ifndef FRODO_SC
+	if ((reg >= 4 && reg <= 7) || reg >= 13) {
+		sync_timers();	// Counters, underflow flags, one-shot stop
+	}
+#endif
+
 	switch (reg) {
 		case 0:
 			return (pra & ddra) | (pa_in & ~ddra);
@@ -362,6 +398,13 @@ inline uint8_t MOS6526::read_register(uint8_t reg)
 
 inline void MOS6526::write_register(uint8_t reg, uint8_t byte)
 {
+#ifndef FRODO_SC
+	bool timers = (reg >= 4 && reg <= 7) || reg >= 13;
+	if (timers) {
+		sync_timers();
+	}
+#endif
+
 	switch (reg) {
 		case 0:
 			pra = byte;
@@ -555,6 +598,12 @@ inline void MOS6526::write_register(uint8_t reg, uint8_t byte)
 #endif
 			break;
 	}
+
+#ifndef FRODO_SC
+	if (timers) {
+		schedule_timers();
+	}
+#endif
 }
 
 
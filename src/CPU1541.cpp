@@ -51,6 +51,27 @@
  *  - Only the highest bit of the n_flag variable is used.
  *  - The $f2 opcode that would normally crash the 6502 is used to implement
  *    emulator-specific functions.
+ *  - On RP2350 the drive is run by the C64 clock instead of being
+ *    interleaved with the 6510: RunTo() emulates it up to a C64 cycle in
+ *    chunks of at most one line, counting the VIA timers per chunk. The C64
+ *    only needs the drive at its own cycle when it reads the IEC lines in
+ *    $dd00 (ReadIECLines()) or changes them (WriteIECLines()), and at the
+ *    end of a line (AdvanceTo()). On a single core these run the drive up
+ *    to that cycle. With DRIVE_IEC_QUEUE the drive runs on the second core
+ *    (RunQueued()): line changes are queued with their cycle and applied
+ *    when the drive gets there, and the drive may lag at most
+ *    DRIVE_MAX_SKEW cycles at a line end. The drive never runs ahead of
+ *    the C64. A read waits until the drive has reached it only within
+ *    DRIVE_EXACT_WINDOW cycles after the C64 changed its lines, where the
+ *    drive's answer to that change is polled, possibly at fixed delays;
+ *    other reads get the drive's lines last published by the second core,
+ *    at most DRIVE_MAX_SKEW cycles old. While the drive is dormant (see
+ *    below) and ATN has not changed since, the published lines are exact
+ *    and the drive may lag up to DRIVE_MAX_SKEW_QUIET cycles.
+ *  - While the drive sleeps in the DOS idle loop, RunTo() skips to the next
+ *    timer interrupt in one step. When it is dormant (motor off, ATN
+ *    released, no jobs) its periodic controller interrupt is skipped as
+ *    well, so the time up to the next ATN is skipped in one step.
  */
 
 #include "sysdeps.h"
@@ -60,10 +81,20 @@
 #include "C64.h"
 #include "CIA.h"
 #include "IEC.h"
+#include "Prefs.h"
 
 #include <format>
 
 
+#if DRIVE_IEC_QUEUE && defined(FRODO_HOST)
+// Host build: the drive thread may share the CPU with the emulation
+#include <thread>
+#define DRIVE_WAIT() std::this_thread::yield()
+#else
+#define DRIVE_WAIT()
+#endif
+
+
 /*
  *  6502 constructor: Initialize registers
  */
@@ -85,6 +116,10 @@ MOS6502_1541::MOS6502_1541(C64 * c64, GCRDisk * gcr, uint8_t * Ram, const uint8_
 
 	borrowed_cycles = 0;
 
+	c64_lines = 0x38;
+	c64_base = drive_base = 0;
+	sync_stats = {};
+
 	via1 = new MOS6522(this, INT_VIA1IRQ);
 	via2 = new MOS6522(this, INT_VIA2IRQ);
 
@@ -133,6 +168,9 @@ void MOS6502_1541::Reset()
 	// IEC lines and VIA registers
 	IECLines = 0x38;
 	atn_ack = 0x08;
+#if DRIVE_IEC_QUEUE
+	drive_out.store(IECLines | atn_ack << 8, std::memory_order_relaxed);
+#endif
 
 	via1->Reset();
 	via2->Reset();
@@ -225,13 +263,19 @@ void MOS6502_1541::SetState(const MOS6502State *s)
  *  Return physical state of IEC lines
  */
 
-uint8_t MOS6502_1541::CalcIECLines() const
+static inline uint8_t iec_bus(uint8_t drive_lines, uint8_t c64_lines, uint8_t atn_ack)
 {
-	uint8_t iec = IECLines & TheCIA2->IECLines;
+	uint8_t iec = drive_lines & c64_lines;
 	iec &= ((iec ^ atn_ack) << 2) | 0xdf;	// ATN acknowledge pulls DATA low
 	return iec;
 }
 
+// As seen by the drive
+uint8_t MOS6502_1541::CalcIECLines() const
+{
+	return iec_bus(IECLines, c64_lines, atn_ack);
+}
+
 
 /*
  *  Trigger VIA interrupt
@@ -263,6 +307,261 @@ void MOS6502_1541::CountVIATimers(int cycles)
 }
 
 
+/*
+ *  Emulate the drive up to a C64 cycle
+ */
+
+void MOS6502_1541::RunTo(uint32_t c64_cycle)
+{
+	if (!ThePrefs.Emul1541Proc) {
+		c64_base = c64_cycle;
+		drive_base = cycle_counter;
+		return;
+	}
+
+	int32_t elapsed = c64_cycle - c64_base;
+	if (elapsed <= 0) {
+		return;
+	}
+
+	// Convert to drive cycles, move the base by whole lines
+	int floppy_cycles = ThePrefs.FloppyCycles;
+	uint32_t lines = elapsed / CYCLES_PER_LINE;
+	uint32_t target = drive_base + lines * floppy_cycles + elapsed % CYCLES_PER_LINE * floppy_cycles / CYCLES_PER_LINE;
+	c64_base += lines * CYCLES_PER_LINE;
+	drive_base += lines * floppy_cycles;
+
+	int32_t left;
+	while ((left = target - cycle_counter) > 0) {
+		if (Idle) {
+			// Asleep in the DOS idle loop: skip to the target or to the next
+			// timer interrupt in one step. An interrupt (timer, ATN) or a disk
+			// change wakes the CPU. The disk rotation is computed from
+			// cycle_counter when the drive reads it.
+			uint32_t cycles = left;
+			bool quiet = dormant();
+			if (!quiet) {
+				uint32_t irq = via1->CyclesToIRQ();
+				if (via2->CyclesToIRQ() < irq) {
+					irq = via2->CyclesToIRQ();
+				}
+				if (irq < cycles) {
+					cycles = irq;
+				}
+			}
+			via1->SkipTimers(cycles, quiet);
+			via2->SkipTimers(cycles, quiet);
+			cycle_counter += cycles;
+			sync_stats.slept += cycles;
+			continue;
+		}
+
+		int cycles = left < floppy_cycles ? left : floppy_cycles;
+		CountVIATimers(cycles);
+		EmulateLine(cycles);
+	}
+}
+
+
+/*
+ *  Check whether the idle drive has nothing to do until the C64 pulls ATN:
+ *  motor off, no disk change in progress, no jobs for the disk controller
+ *  and no one-shot timer running. Its periodic controller interrupt would
+ *  then only find an empty job queue, so it is not emulated.
+ */
+
+bool MOS6502_1541::dormant() const
+{
+	uint8_t jobs = ram[0] | ram[1] | ram[2] | ram[3] | ram[4] | ram[5];	// Job codes of buffers 0..5
+	return the_gcr_disk->Quiet() && (c64_lines & 0x08) && !(jobs & 0x80)
+	    && via1->OnlyPeriodicIRQ() && via2->OnlyPeriodicIRQ();
+}
+
+
+/*
+ *  C64 side: return physical state of IEC lines at a C64 cycle
+ */
+
+uint8_t MOS6502_1541::ReadIECLines(uint32_t c64_cycle)
+{
+	if (ThePrefs.Emul1541Proc) {
+#if DRIVE_IEC_QUEUE
+		uint32_t reached = drive_time.load(std::memory_order_acquire);
+		uint32_t out = drive_out.load(std::memory_order_relaxed);
+		uint32_t lag = c64_cycle - reached;
+		bool quiet = (out & DRIVE_OUT_QUIET) && (int32_t)(reached - c64_atn_cycle) > 0;
+		bool recent_write = c64_cycle - c64_write_cycle < DRIVE_EXACT_WINDOW;
+		c64_time.store(c64_cycle, std::memory_order_release);	// The drive may run on
+		if (quiet || (lag <= DRIVE_MAX_SKEW && !recent_write)) {
+			sync_stats.published++;
+			return iec_bus(out & 0xff, TheCIA2->IECLines, out >> 8 & 0xff);
+		}
+
+		sync_stats.syncs++;
+		wait_drive(c64_cycle);
+#else
+		sync_stats.syncs++;
+		RunTo(c64_cycle);
+#endif
+	}
+	return iec_bus(IECLines, TheCIA2->IECLines, atn_ack);
+}
+
+
+/*
+ *  C64 side: IEC output lines of the C64 change at a C64 cycle
+ */
+
+void MOS6502_1541::WriteIECLines(uint32_t c64_cycle, uint8_t lines)
+{
+	if (!ThePrefs.Emul1541Proc) {
+		set_c64_lines(lines);
+		return;
+	}
+
+#if DRIVE_IEC_QUEUE
+	if ((lines ^ c64_queued_lines) & 0x08) {
+		c64_atn_cycle = c64_cycle;
+	}
+	c64_queued_lines = lines;
+	c64_write_cycle = c64_cycle;
+
+	unsigned head = iec_head.load(std::memory_order_relaxed);
+	if (head - iec_tail.load(std::memory_order_acquire) >= DRIVE_IEC_QUEUE) {
+		// Queue full, let the drive catch up
+		c64_time.store(c64_cycle, std::memory_order_release);
+		sync_stats.stalls++;
+		while (head - iec_tail.load(std::memory_order_acquire) >= DRIVE_IEC_QUEUE) {
+			sync_stats.stall_polls++;
+			DRIVE_WAIT();
+		}
+	}
+	iec_queue[head % DRIVE_IEC_QUEUE] = { c64_cycle, lines };
+	iec_head.store(head + 1, std::memory_order_release);
+	c64_time.store(c64_cycle, std::memory_order_release);
+#else
+	RunTo(c64_cycle);
+	set_c64_lines(lines);
+#endif
+}
+
+
+/*
+ *  C64 side: a raster line has been emulated up to the given C64 cycle
+ */
+
+void MOS6502_1541::AdvanceTo(uint32_t c64_cycle)
+{
+#if DRIVE_IEC_QUEUE
+	c64_time.store(c64_cycle, std::memory_order_release);
+	if (ThePrefs.Emul1541Proc) {
+		// Recorded before the wait, to show how far the drive falls behind
+		uint32_t reached = drive_time.load(std::memory_order_acquire);
+		uint32_t lag = c64_cycle - reached;
+		if (lag > sync_stats.max_lag_unthrottled) {
+			sync_stats.max_lag_unthrottled = lag;
+		}
+
+		// A dormant drive only needs to keep up loosely
+		bool quiet = (drive_out.load(std::memory_order_relaxed) & DRIVE_OUT_QUIET)
+		          && (int32_t)(reached - c64_atn_cycle) > 0;
+		uint32_t max_skew = quiet ? DRIVE_MAX_SKEW_QUIET : DRIVE_MAX_SKEW;
+		if (lag > max_skew) {
+			wait_drive(c64_cycle - max_skew);
+		}
+	}
+#else
+	RunTo(c64_cycle);
+#endif
+}
+
+
+/*
+ *  C64 side: wait until the drive has caught up with the C64, so its
+ *  state may be changed
+ */
+
+void MOS6502_1541::Sync()
+{
+#if DRIVE_IEC_QUEUE
+	wait_drive(c64_time.load(std::memory_order_relaxed));
+#endif
+}
+
+
+/*
+ *  C64 side: wait until the drive has reached a C64 cycle
+ */
+
+void MOS6502_1541::wait_drive(uint32_t c64_cycle)
+{
+#if DRIVE_IEC_QUEUE
+	if ((int32_t)(drive_time.load(std::memory_order_acquire) - c64_cycle) < 0) {
+		sync_stats.stalls++;
+		while ((int32_t)(drive_time.load(std::memory_order_acquire) - c64_cycle) < 0) {
+			sync_stats.stall_polls++;
+			DRIVE_WAIT();
+		}
+	}
+#endif
+}
+
+
+#if DRIVE_IEC_QUEUE
+/*
+ *  Second core: apply the queued C64 line changes and run the drive as far
+ *  as the C64 allows
+ */
+
+void MOS6502_1541::RunQueued()
+{
+	uint32_t limit = c64_time.load(std::memory_order_acquire);
+
+	unsigned tail = iec_tail.load(std::memory_order_relaxed);
+	while (tail != iec_head.load(std::memory_order_acquire)) {
+		const IECChange & c = iec_queue[tail % DRIVE_IEC_QUEUE];
+		RunTo(c.cycle);
+		set_c64_lines(c.lines);
+		iec_tail.store(++tail, std::memory_order_release);
+	}
+
+	RunTo(limit);
+	publish();
+	drive_time.store(limit, std::memory_order_release);
+}
+
+
+/*
+ *  Second core: publish the drive's IEC lines for the reads of the C64
+ *  that do not wait for the drive
+ */
+
+void MOS6502_1541::publish()
+{
+	uint32_t out = IECLines | atn_ack << 8;
+	if (Idle && dormant()) {
+		out |= DRIVE_OUT_QUIET;
+	}
+	drive_out.store(out, std::memory_order_relaxed);
+}
+#endif
+
+
+/*
+ *  Set state of IEC lines from C64 side, trigger interrupt on falling ATN
+ */
+
+void MOS6502_1541::set_c64_lines(uint8_t lines)
+{
+	uint8_t old_lines = c64_lines;
+	c64_lines = lines;
+
+	if ((old_lines & ~lines) & 0x08) {	// ATN 1->0
+		TriggerIECInterrupt();
+	}
+}
+
+
 /*
  *  Read a byte from the CPU's address space
  */
@@ -588,6 +887,7 @@ int MOS6502_1541::EmulateLine(int cycles_left)
 #define IS_CPU_1541
 #define RESET_PENDING (int_line[INT_RESET1541])
 #define IRQ_PENDING (int_line[INT_VIA1IRQ] || int_line[INT_VIA2IRQ])
+#define OPCODE_DONE cycle_counter += last_cycles
 #define CHECK_SO \
 	if (set_overflow_enabled() && the_gcr_disk->ByteReady(cycle_counter)) { \
 		v_flag = true; \
@@ -601,7 +901,7 @@ int MOS6502_1541::EmulateLine(int cycles_left)
 #include "CPU_emulline.h"
 
 		// Extension opcode
-		case 0xf2:
+		OPCODE(0xf2):
 			if (pc < 0xc000) {
 				illegal_op(pc - 1);
 			} else switch (read_byte_imm()) {
@@ -624,7 +924,7 @@ int MOS6502_1541::EmulateLine(int cycles_left)
 			ENDOP(2);
 		}
 
-		cycle_counter += last_cycles;
+		OPCODE_DONE;
 	}
 
 	return last_cycles;
@@ -23,6 +23,10 @@
 
 #include "VIA.h"
 
+#if DRIVE_IEC_QUEUE
+#include <atomic>
+#endif
+
 
 // Set this to 1 for more precise CPU cycle calculation
 #ifndef PRECISE_CPU_CYCLES
@@ -30,6 +34,29 @@
 #endif
 
 
+// Largest lag of the drive behind the C64 at the end of a raster line, in
+// C64 cycles, when the drive runs on the second core
+#ifndef DRIVE_MAX_SKEW
+#define DRIVE_MAX_SKEW 256
+#endif
+
+// Reads of $dd00 within this many C64 cycles after the C64 changed its IEC
+// lines wait for the drive to reach the reading cycle; later ones are
+// answered from the drive state last published by the second core. 0
+// makes every read wait. The drive's VIA timers advance per RunTo() step,
+// so the Kernal's EOI handshake needs fine steps for about 2000 cycles
+// after a change; loads hang below 2048.
+#ifndef DRIVE_EXACT_WINDOW
+#define DRIVE_EXACT_WINDOW 4096
+#endif
+
+// Largest lag at a line end while the drive is dormant (one PAL frame):
+// its IEC lines cannot change until the C64 pulls ATN
+#ifndef DRIVE_MAX_SKEW_QUIET
+#define DRIVE_MAX_SKEW_QUIET 19656
+#endif
+
+
 // Interrupt types
 enum {
 	INT_VIA1IRQ,
@@ -44,6 +71,17 @@ class MOS6526_2;
 struct MOS6502State;
 
 
+// Cost of keeping the drive in step with the C64
+struct DriveSyncStats {
+	uint32_t syncs;			// $dd00 reads that needed the drive at the C64's cycle
+	uint32_t published;		// $dd00 reads answered from the published drive state
+	uint32_t stalls;		// Times the C64 waited for the drive
+	uint32_t stall_polls;	// Polls of the drive's progress while waiting
+	uint32_t max_lag_unthrottled;	// Largest lag at a line end before throttling to DRIVE_MAX_SKEW (C64 cycles)
+	uint64_t slept;			// Drive cycles skipped while asleep in the DOS idle loop
+};
+
+
 // 6502 emulation (1541)
 class MOS6502_1541 {
 public:
@@ -56,6 +94,18 @@ public:
 #else
 	int EmulateLine(int cycles_left);	// Emulate until cycles_left underflows
 	void CountVIATimers(int cycles);
+
+	// Processor-level emulation driven by the C64 clock (cycles of
+	// MOS6510::CycleCounter()), see CPU1541.cpp
+	void RunTo(uint32_t c64_cycle);						// Drive side
+	uint8_t ReadIECLines(uint32_t c64_cycle);			// C64 side
+	void WriteIECLines(uint32_t c64_cycle, uint8_t lines);
+	void AdvanceTo(uint32_t c64_cycle);
+	void Sync();
+#if DRIVE_IEC_QUEUE
+	void RunQueued();									// Second core
+#endif
+	DriveSyncStats SyncStats() const { return sync_stats; }
 #endif
 	void Reset();
 	void AsyncReset();					// Reset the CPU asynchronously
@@ -94,6 +144,14 @@ private:
 	void write_byte_via2(uint16_t adr, uint8_t byte);
 
 	void set_iec_lines(uint8_t inv_out);
+#ifndef FRODO_SC
+	void set_c64_lines(uint8_t lines);
+	void wait_drive(uint32_t c64_cycle);
+	bool dormant() const;
+#if DRIVE_IEC_QUEUE
+	void publish();
+#endif
+#endif
 	bool set_overflow_enabled() const { return (via2->PCR() & 0x0e) == 0x0e; }	// CA2 high output
 
 	uint8_t read_zp(uint16_t adr);
@@ -137,6 +195,37 @@ private:
 	uint8_t rdbuf;			// Data buffer for RMW instructions
 #else
 	int borrowed_cycles;	// Borrowed cycles from next line
+
+	uint8_t c64_lines;		// IEC lines from C64 side as seen by the drive
+
+	// Drive cycle_counter corresponding to a C64 cycle, for converting
+	// between the clocks (FloppyCycles per C64 line)
+	uint32_t c64_base;
+	uint32_t drive_base;
+
+	DriveSyncStats sync_stats;
+
+#if DRIVE_IEC_QUEUE
+	// C64 IEC line changes queued for the drive on the second core
+	struct IECChange {
+		uint32_t cycle;		// C64 cycle
+		uint8_t lines;
+	};
+	IECChange iec_queue[DRIVE_IEC_QUEUE];
+	std::atomic<unsigned> iec_head{0};		// Written by the C64
+	std::atomic<unsigned> iec_tail{0};		// Written by the drive
+	std::atomic<uint32_t> c64_time{0};		// C64 cycle the drive may run to
+	std::atomic<uint32_t> drive_time{0};	// C64 cycle the drive has reached
+
+	// Drive state at drive_time for reads that do not wait: IECLines in
+	// bits 0-7, atn_ack in bits 8-15, bit 16 set while dormant
+	std::atomic<uint32_t> drive_out{0x0838};
+	static constexpr uint32_t DRIVE_OUT_QUIET = 0x10000;
+
+	uint8_t c64_queued_lines = 0x38;	// C64 lines of the last queued change
+	uint32_t c64_write_cycle = 0;	// Last change of the C64's IEC lines
+	uint32_t c64_atn_cycle = 0;		// Last change of the C64's ATN line
+#endif
 #endif
 
 	uint8_t atn_ack;		// ATN acknowledge: 0x00 or 0x08 (XOR value for IECLines ATN)
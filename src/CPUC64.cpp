@@ -27,11 +27,15 @@
  *    executed opcode and if the counter goes below zero, the function
  *    returns.
  *  - All memory accesses are done with the read_byte() and
- *    write_byte() functions which also do the memory address decoding. The
+ *    write_byte() functions. They look up the page in the read_page[] and
+ *    write_page[] tables and only fall back to read_byte_io() and
+ *    write_byte_io() for I/O and other pages that need a handler. The
  *    read_zp() and write_zp() functions allow faster access to the zero
  *    page, the pop_byte() and push_byte() macros for the stack.
  *  - If a write occurs to addresses 0 or 1, new_config() is called to check
- *    whether the memory configuration has changed
+ *    whether the memory configuration has changed. The page tables are
+ *    rebuilt by map_memory() when it has, or when a cartridge I/O access
+ *    has switched banks or /EXROM and /GAME.
  *  - The possible interrupt sources are:
  *      INT_VICIRQ: I flag is checked, jump to ($fffe)
  *      INT_CIAIRQ: I flag is checked, jump to ($fffe)
@@ -39,7 +43,8 @@
  *      INT_RESET: Jump to ($fffc)
  *  - Interrupts are not checked before every opcode but only at certain
  *    times:
- *      On entering EmulateLine()
+ *      On entering EmulateLine() (with PRECISE_CIA_IRQ, a line is
+ *      emulated in several calls split at CIA timer underflows)
  *      On CLI
  *      On PLP if the I flag was cleared
  *      On RTI if the I flag was cleared
@@ -64,6 +69,10 @@
 #include <format>
 
 
+// What line_cycles_left points to outside of EmulateLine()
+static const int line_end_cycles = 0;
+
+
 /*
  *  6510 constructor: Initialize registers
  */
@@ -90,6 +99,24 @@ MOS6510::MOS6510(C64 *c64, uint8_t *Ram, const uint8_t *Basic, const uint8_t *Ke
 
 	borrowed_cycles = 0;
 	dfff_byte = 0x55;
+
+	basic_in = kernal_in = char_in = io_in = false;
+	map_valid = false;
+
+	idle_state = 0;
+	idle_skipped = 0;
+
+	line_cycles_left = &line_end_cycles;
+	line_cycles_after = 0;
+
+#if CPU_BLOCK_CACHE
+	for (auto & b : block_cache) {
+		b.page = nullptr;
+	}
+	memset(page_gen, 0, sizeof(page_gen));
+	block_stats = {};
+	FlushBlockCache();
+#endif
 }
 
 
@@ -138,6 +165,9 @@ void MOS6510::Reset()
 	// Read reset vector
 	pc = read_word(0xfffc);
 	jammed = false;
+
+	// RAM and ROMs may have been reloaded
+	FlushBlockCache();
 }
 
 
@@ -218,6 +248,9 @@ void MOS6510::SetState(const MOS6510State *s)
 	nmi_triggered = s->nmi_triggered;
 
 	dfff_byte = s->dfff_byte;
+
+	// RAM was restored behind our back
+	FlushBlockCache();
 }
 
 
@@ -264,80 +297,211 @@ void MOS6510::new_config()
 	}
 	io_in = (port & 3) && (port & 4);
 
+	map_memory();
+
 	bool tape_motor = (port & 0x20) == 0;
-	the_tape->SetMotor(tape_motor);
+	if (the_tape) {		// No datasette on RP2350
+		the_tape->SetMotor(tape_motor);
+	}
 }
 
 
 /*
- *  Read a byte from I/O / ROM space
+ *  Build the page tables for the current memory configuration
  */
 
-inline uint8_t MOS6510::read_byte_io(uint16_t adr)
+// Handlers for pages that are not mapped directly
+enum {
+	PAGE_MAPPED,	// read_page/write_page pointer is used
+	PAGE_VIC,		// $d000-$d3ff
+	PAGE_SID,		// $d400-$d7ff
+	PAGE_COLOR,		// $d800-$dbff
+	PAGE_CIA1,		// $dc00-$dcff
+	PAGE_CIA2,		// $dd00-$ddff
+	PAGE_IO1,		// $de00-$deff
+	PAGE_IO2,		// $df00-$dfff
+	PAGE_ROML,		// $8000-$9fff with dynamic cartridge ROM
+	PAGE_ROMH_A,	// $a000-$bfff with dynamic cartridge ROM
+	PAGE_ROMH_E,	// $e000-$ffff with dynamic cartridge ROM (Ultimax)
+	PAGE_PORT,		// $0000-$00ff writes (processor port)
+	PAGE_FF00		// $ff00-$ffff writes (REU trigger)
+};
+
+static const uint8_t io_handler[16] = {
+	PAGE_VIC, PAGE_VIC, PAGE_VIC, PAGE_VIC,
+	PAGE_SID, PAGE_SID, PAGE_SID, PAGE_SID,
+	PAGE_COLOR, PAGE_COLOR, PAGE_COLOR, PAGE_COLOR,
+	PAGE_CIA1, PAGE_CIA2, PAGE_IO1, PAGE_IO2
+};
+
+// Map 'num' pages starting at 'first' to 'base', or to 'handler' if base is nullptr
+static void map_pages(const uint8_t ** page, uint8_t * handler, unsigned first, unsigned num, const uint8_t * base, uint8_t type)
 {
-	switch (adr >> 12) {
-		case 0x8:	// Cartridge ROML or RAM
-		case 0x9:
-			// ROML visible in: 8K mode (!notEXROM), 16K mode (!notEXROM && !notGAME), Ultimax (!notGAME && notEXROM)
-			// Simplified: ROML visible if !notEXROM OR !notGAME
-			if (!the_cart->notEXROM || !the_cart->notGAME) {
-				return the_cart->ReadROML(adr & 0x1fff, ram[adr], basic_in);
-			} else {
-				return ram[adr];
-			}
-		case 0xa:	// Cartridge ROMH or RAM or BASIC ROM
-		case 0xb:
-			if (the_cart->notEXROM || the_cart->notGAME) {
-				return basic_in ? basic_rom[adr & 0x1fff] : ram[adr];
-			} else {
-				return the_cart->ReadROMH(adr & 0x1fff, ram[adr], basic_rom[adr & 0x1fff], basic_in, kernal_in);
-			}
-		case 0xc:
-			return ram[adr];
-		case 0xd:
-			if (io_in) {
-				switch ((adr >> 8) & 0x0f) {
-					case 0x0:	// VIC
-					case 0x1:
-					case 0x2:
-					case 0x3:
-						return the_vic->ReadRegister(adr & 0x3f);
-					case 0x4:	// SID
-					case 0x5:
-					case 0x6:
-					case 0x7:
-						return the_sid->ReadRegister(adr & 0x1f);
-					case 0x8:	// Color RAM
-					case 0x9:
-					case 0xa:
-					case 0xb:
-						return color_ram[adr & 0x03ff] | (rand() & 0xf0);
-					case 0xc:	// CIA 1
-						return the_cia1->ReadRegister(adr & 0x0f);
-					case 0xd:	// CIA 2
-						return the_cia2->ReadRegister(adr & 0x0f);
-					case 0xe:	// Cartridge I/O 1 (or open)
-						return the_cart->ReadIO1(adr & 0xff, rand());
-					case 0xf:	// Cartridge I/O 2 (or open)
-						// Full $DF00-$DFFF access for cartridges
-						// EasyFlash needs all 256 bytes of RAM at this location
-						return the_cart->ReadIO2(adr & 0xff, rand());
-				}
-			} else if (char_in) {
-				return char_rom[adr & 0x0fff];
-			} else {
-				return ram[adr];
+	for (unsigned i = 0; i < num; ++i) {
+		page[first + i] = base ? base + i * 0x100 : nullptr;
+		handler[first + i] = base ? PAGE_MAPPED : type;
+	}
+}
+
+// Resolve a cartridge ROM area to a base pointer, nullptr = dynamic
+static const uint8_t * cart_base(CartMap map, const uint8_t * block, const uint8_t * ram, const uint8_t * sys_rom)
+{
+	switch (map) {
+		case CartMap::RAM:
+			return ram;
+		case CartMap::SysROM:
+			return sys_rom;
+		case CartMap::ROM:
+			return block;
+		default:
+			return nullptr;
+	}
+}
+
+void MOS6510::map_memory()
+{
+	MemoryMap m;
+	m.basic_in = basic_in;
+	m.kernal_in = kernal_in;
+	m.char_in = char_in;
+	m.io_in = io_in;
+	m.notEXROM = the_cart->notEXROM;
+	m.notGAME = the_cart->notGAME;
+	m.roml = m.romh = CartMap::RAM;
+	m.roml_block = m.romh_block = nullptr;
+
+	// ROML visible if !notEXROM or !notGAME, ROMH at $a000 in 16K mode
+	// and at $e000 in Ultimax mode (!notGAME && notEXROM)
+	if (!m.notEXROM || !m.notGAME) {
+		m.roml = the_cart->MapROML(basic_in, m.roml_block);
+	}
+	if (!m.notGAME) {
+		m.romh = the_cart->MapROMH(basic_in, kernal_in, m.romh_block);
+	}
+
+	if (map_valid && m == mapped) {
+		return;
+	}
+	mapped = m;
+
+#if CPU_BLOCK_CACHE
+	// Next instruction may come from a different ROM/RAM
+	block_end = block_op;
+#endif
+
+	const uint8_t ** rd = read_page;
+	const uint8_t ** wr = const_cast<const uint8_t **>(write_page);
+
+	if (! map_valid) {
+
+		// $0000-$7fff, $c000-$cfff: RAM
+		map_pages(rd, read_handler, 0x00, 0x80, ram, 0);
+		map_pages(rd, read_handler, 0xc0, 0x10, ram + 0xc000, 0);
+
+		// Writes below $d000 always go to RAM, above $e000 too
+		map_pages(wr, write_handler, 0x00, 0x100, ram, 0);
+		map_pages(wr, write_handler, 0x00, 1, nullptr, PAGE_PORT);
+		map_pages(wr, write_handler, 0xff, 1, nullptr, PAGE_FF00);
+		map_valid = true;
+	}
+
+	// $8000-$9fff: Cartridge ROML or RAM
+	map_pages(rd, read_handler, 0x80, 0x20, cart_base(m.roml, m.roml_block, ram + 0x8000, nullptr), PAGE_ROML);
+
+	// $a000-$bfff: Cartridge ROMH or BASIC ROM or RAM
+	if (m.notEXROM || m.notGAME) {
+		map_pages(rd, read_handler, 0xa0, 0x20, basic_in ? basic_rom : ram + 0xa000, 0);
+	} else {
+		map_pages(rd, read_handler, 0xa0, 0x20, cart_base(m.romh, m.romh_block, ram + 0xa000, basic_rom), PAGE_ROMH_A);
+	}
+
+	// $d000-$dfff: I/O or Char ROM or RAM
+	if (io_in) {
+		for (unsigned i = 0; i < 16; ++i) {
+			map_pages(rd, read_handler, 0xd0 + i, 1, nullptr, io_handler[i]);
+			map_pages(wr, write_handler, 0xd0 + i, 1, nullptr, io_handler[i]);
+		}
+	} else {
+		map_pages(rd, read_handler, 0xd0, 0x10, char_in ? char_rom : ram + 0xd000, 0);
+		map_pages(wr, write_handler, 0xd0, 0x10, ram + 0xd000, 0);
+	}
+
+	// $e000-$ffff: Cartridge ROMH (Ultimax) or Kernal ROM or RAM
+	if (!m.notGAME && m.notEXROM) {
+		map_pages(rd, read_handler, 0xe0, 0x20, cart_base(m.romh, m.romh_block, ram + 0xe000, kernal_rom), PAGE_ROMH_E);
+	} else {
+		map_pages(rd, read_handler, 0xe0, 0x20, kernal_in ? kernal_rom : ram + 0xe000, 0);
+	}
+}
+
+
+/*
+ *  Route the SID address slots: $d400-$d7ff mirrors the SID except where
+ *  an extra SID is fitted, $de00-$dfff only holds extra SIDs
+ */
+
+void MOS6510::map_sids()
+{
+	for (MOS6581 * & sid : sid_slot) {
+		sid = the_sid;
+	}
+	for (MOS6581 * & sid : io_sid) {
+		sid = nullptr;
+	}
+
+	for (unsigned i = 0; i < SID_MAX_CHIPS - 1; ++i) {
+		MOS6581 * extra = the_sid->ExtraSID(i);
+		uint16_t adr = the_sid->ExtraSIDAddress(i);
+		if (extra == nullptr) {
+			continue;
+		}
+		if (adr > 0xd400 && adr < 0xd800) {
+			sid_slot[(adr >> 5) & 0x1f] = extra;
+		} else if (adr >= 0xde00 && adr < 0xe000) {
+			io_sid[(adr >> 5) & 0x0f] = extra;
+		}
+	}
+}
+
+
+/*
+ *  Read a byte from an unmapped page (I/O, dynamic cartridge ROM)
+ */
+
+uint8_t MOS6510::read_byte_io(uint16_t adr)
+{
+	switch (read_handler[adr >> 8]) {
+		case PAGE_VIC:
+			return the_vic->ReadRegister(adr & 0x3f);
+		case PAGE_SID:
+			return sid_slot[(adr >> 5) & 0x1f]->ReadRegister(adr & 0x1f);
+		case PAGE_COLOR:
+			return color_ram[adr & 0x03ff] | (rand() & 0xf0);
+		case PAGE_CIA1:
+			return the_cia1->ReadRegister(adr & 0x0f);
+		case PAGE_CIA2:
+			return the_cia2->ReadRegister(adr & 0x0f);
+		case PAGE_IO1: {	// Cartridge I/O 1 (or open), reads may switch banks
+			if (MOS6581 * sid = io_sid[(adr >> 5) & 0x0f]) {
+				return sid->ReadRegister(adr & 0x1f);
 			}
-		case 0xe:
-		case 0xf:
-			// In Ultimax mode (!notGAME && notEXROM), ROMH is at $E000-$FFFF
-			if (!the_cart->notGAME && the_cart->notEXROM) {
-				return the_cart->ReadROMH(adr & 0x1fff, ram[adr], kernal_rom[adr & 0x1fff], basic_in, kernal_in);
-			} else if (kernal_in) {
-				return kernal_rom[adr & 0x1fff];
-			} else {
-				return ram[adr];
+			uint8_t byte = the_cart->ReadIO1(adr & 0xff, rand());
+			map_memory();
+			return byte;
+		}
+		case PAGE_IO2:		// Cartridge I/O 2 (or open)
+			if (MOS6581 * sid = io_sid[(adr >> 5) & 0x0f]) {
+				return sid->ReadRegister(adr & 0x1f);
 			}
+			// Full $DF00-$DFFF access for cartridges
+			// EasyFlash needs all 256 bytes of RAM at this location
+			return the_cart->ReadIO2(adr & 0xff, rand());
+		case PAGE_ROML:
+			return the_cart->ReadROML(adr & 0x1fff, ram[adr], basic_in);
+		case PAGE_ROMH_A:
+			return the_cart->ReadROMH(adr & 0x1fff, ram[adr], basic_rom[adr & 0x1fff], basic_in, kernal_in);
+		case PAGE_ROMH_E:
+			return the_cart->ReadROMH(adr & 0x1fff, ram[adr], kernal_rom[adr & 0x1fff], basic_in, kernal_in);
 		default:	// Can't happen
 			return 0;
 	}
@@ -350,8 +514,9 @@ inline uint8_t MOS6510::read_byte_io(uint16_t adr)
 
 uint8_t MOS6510::read_byte(uint16_t adr)
 {
-	if (adr < 0x8000) {
-		return ram[adr];
+	const uint8_t * page = read_page[adr >> 8];
+	if (page) {
+		return page[adr & 0xff];
 	} else {
 		return read_byte_io(adr);
 	}
@@ -390,43 +555,11 @@ uint8_t MOS6510::read_emulator_id(uint16_t adr)
 
 inline uint16_t MOS6510::read_word(uint16_t adr)
 {
-	switch (adr >> 12) {
-		case 0x0:
-		case 0x1:
-		case 0x2:
-		case 0x3:
-		case 0x4:
-		case 0x5:
-		case 0x6:
-		case 0x7:
-			return *(uint16_t *)&ram[adr];
-		case 0x8:
-		case 0x9:
-		case 0xa:
-		case 0xb:
-			return read_byte_io(adr) | (read_byte_io(adr + 1) << 8);
-		case 0xc:
-			return *(uint16_t *)&ram[adr];
-		case 0xd:
-			if (io_in) {
-				return read_byte_io(adr) | (read_byte_io(adr + 1) << 8);
-			} else if (char_in) {
-				return *(uint16_t *)&char_rom[adr & 0x0fff];
-			} else {
-				return *(uint16_t *)&ram[adr];
-			}
-		case 0xe:
-		case 0xf:
-			// In Ultimax mode, ROMH is at $E000-$FFFF
-			if (!the_cart->notGAME && the_cart->notEXROM) {
-				return read_byte_io(adr) | (read_byte_io(adr + 1) << 8);
-			} else if (kernal_in) {
-				return *(uint16_t *)&kernal_rom[adr & 0x1fff];
-			} else {
-				return *(uint16_t *)&ram[adr];
-			}
-		default:	// Can't happen
-			return 0;
+	const uint8_t * page = read_page[adr >> 8];
+	if (page && (adr & 0xff) != 0xff) {
+		return *(uint16_t *)&page[adr & 0xff];
+	} else {
+		return read_byte(adr) | (read_byte(adr + 1) << 8);
 	}
 }
 
@@ -441,57 +574,85 @@ inline uint16_t MOS6510::read_word(uint16_t adr)
 
 
 /*
- *  Write byte to I/O space
+ *  C64 clock cycle of the current instruction (stolen VIC cycles are
+ *  counted at the start of the line)
+ */
+
+uint32_t MOS6510::CycleCounter() const
+{
+	if (line_cycles_left == &line_end_cycles) {
+		return the_c64->CycleCounter();		// Between lines
+	}
+	return the_c64->CycleCounter() + CYCLES_PER_LINE - *line_cycles_left - line_cycles_after;
+}
+
+
+/*
+ *  Write a SID register with the cycle within the line, at which the
+ *  renderer applies it
+ */
+
+inline void MOS6510::write_sid(MOS6581 * sid, uint16_t adr, uint8_t byte)
+{
+	sid->WriteRegister(adr & 0x1f, byte, CYCLES_PER_LINE - *line_cycles_left - line_cycles_after);
+}
+
+
+/*
+ *  Write a byte to an unmapped page (I/O, processor port, $ff00)
  */
 
 void MOS6510::write_byte_io(uint16_t adr, uint8_t byte)
 {
-	if (adr >= 0xe000) {
-		ram[adr] = byte;
-		if (adr == 0xff00) {
-			the_cart->FF00Trigger();
-		}
-	} else if (io_in) {
-		switch ((adr >> 8) & 0x0f) {
-			case 0x0:	// VIC
-			case 0x1:
-			case 0x2:
-			case 0x3:
-				the_vic->WriteRegister(adr & 0x3f, byte);
-				return;
-			case 0x4:	// SID
-			case 0x5:
-			case 0x6:
-				the_sid->WriteRegister(adr & 0x1f, byte);
-				return;
-			case 0x7:
-				if (ThePrefs.TestBench && adr == 0xd7ff) {
-					the_c64->RequestQuit(byte);
-				} else {
-					the_sid->WriteRegister(adr & 0x1f, byte);
-				}
-				return;
-			case 0x8:	// Color RAM
-			case 0x9:
-			case 0xa:
-			case 0xb:
-				color_ram[adr & 0x03ff] = byte & 0x0f;
-				return;
-			case 0xc:	// CIA 1
-				the_cia1->WriteRegister(adr & 0x0f, byte);
-				return;
-			case 0xd:	// CIA 2
-				the_cia2->WriteRegister(adr & 0x0f, byte);
-				return;
-			case 0xe:	// Cartridge I/O 1 (or open)
-				the_cart->WriteIO1(adr & 0xff, byte);
+	switch (write_handler[adr >> 8]) {
+		case PAGE_PORT:
+			ram[adr] = byte;
+			if (adr < 2) {
+				new_config();
+			}
+			return;
+		case PAGE_FF00:
+			ram[adr] = byte;
+			if (adr == 0xff00) {
+				the_cart->FF00Trigger();
+				map_memory();
+			}
+			return;
+		case PAGE_VIC:
+			the_vic->WriteRegister(adr & 0x3f, byte);
+			return;
+		case PAGE_SID:
+			if (ThePrefs.TestBench && adr == 0xd7ff) {
+				the_c64->RequestQuit(byte);
+			} else {
+				write_sid(sid_slot[(adr >> 5) & 0x1f], adr, byte);
+			}
+			return;
+		case PAGE_COLOR:
+			color_ram[adr & 0x03ff] = byte & 0x0f;
+			return;
+		case PAGE_CIA1:
+			the_cia1->WriteRegister(adr & 0x0f, byte);
+			return;
+		case PAGE_CIA2:
+			the_cia2->WriteRegister(adr & 0x0f, byte);
+			return;
+		case PAGE_IO1:		// Cartridge I/O 1 (or open), may switch banks
+			if (MOS6581 * sid = io_sid[(adr >> 5) & 0x0f]) {
+				write_sid(sid, adr, byte);
 				return;
-			case 0xf:	// Cartridge I/O 2 (or open)
-				the_cart->WriteIO2(adr & 0xff, byte);
+			}
+			the_cart->WriteIO1(adr & 0xff, byte);
+			map_memory();
+			return;
+		case PAGE_IO2:		// Cartridge I/O 2 (or open), may switch banks
+			if (MOS6581 * sid = io_sid[(adr >> 5) & 0x0f]) {
+				write_sid(sid, adr, byte);
 				return;
-		}
-	} else {
-		ram[adr] = byte;
+			}
+			the_cart->WriteIO2(adr & 0xff, byte);
+			map_memory();
+			return;
 	}
 }
 
@@ -502,11 +663,15 @@ void MOS6510::write_byte_io(uint16_t adr, uint8_t byte)
 
 inline void MOS6510::write_byte(uint16_t adr, uint8_t byte)
 {
-	if (adr < 0xd000) {
-		ram[adr] = byte;
-		if (adr < 2) {
-			new_config();
-		}
+#if CPU_BLOCK_CACHE
+	if (code_pages[adr >> 13] & (1u << ((adr >> 8) & 31))) {
+		invalidate_code_page(adr >> 8);
+	}
+#endif
+
+	uint8_t * page = write_page[adr >> 8];
+	if (page) {
+		page[adr & 0xff] = byte;
 	} else {
 		write_byte_io(adr, byte);
 	}
@@ -563,12 +728,14 @@ uint8_t MOS6510::ExtReadByte(uint16_t adr)
 	kernal_in = ExtConfig & 2;
 	char_in = (ExtConfig & 3) && ~(ExtConfig & 4);
 	io_in = (ExtConfig & 3) && (ExtConfig & 4);
+	map_memory();
 
 	// Read byte
 	uint8_t byte = read_byte(adr);
 
 	// Restore old configuration
 	basic_in = bi; kernal_in = ki; char_in = ci; io_in = ii;
+	map_memory();
 
 	return byte;
 }
@@ -588,12 +755,14 @@ void MOS6510::ExtWriteByte(uint16_t adr, uint8_t byte)
 	kernal_in = ExtConfig & 2;
 	char_in = (ExtConfig & 3) && ~(ExtConfig & 4);
 	io_in = (ExtConfig & 3) && (ExtConfig & 4);
+	map_memory();
 
 	// Write byte
 	write_byte(adr, byte);
 
 	// Restore old configuration
 	basic_in = bi; kernal_in = ki; char_in = ci; io_in = ii;
+	map_memory();
 }
 
 
@@ -697,30 +866,442 @@ void MOS6510::illegal_op(uint16_t adr)
 
 
 /*
- *  Emulate cycles_left worth of 6510 instructions
+ *  Idle loop detection
+ *
+ *  Interrupts are only taken on entering EmulateLine(), and VIC and CIA
+ *  registers only change between calls (except the CIAs with
+ *  PRECISE_CIA_CYCLES). So a short loop that passes its closing branch
+ *  twice in the same call with identical registers and flags, and that
+ *  only reads RAM, ROM or VIC/CIA registers, will repeat exactly the same
+ *  way until the call ends at the end of the line or at a CIA underflow:
+ *  JMP *, LDA $d012/CMP/BNE raster waits, LDA $dc0d/BEQ polls, BIT
+ *  $d011/BPL etc. Whole passes are skipped by
+ *  taking their cycles off cycles_left, leaving the last (partial) pass to
+ *  run normally. IRQs, NMIs, raster matches and CIA underflows are all
+ *  seen at the start of the next call, exactly as without skipping.
+ */
+
+// Maximum distance from loop start to the closing branch/JMP
+const int IDLE_LOOP_SIZE = 32;
+
+enum {
+	IDLE_NONE,		// No pass recorded in this line
+	IDLE_SEEN,		// idle_pass holds the last pass
+	IDLE_REJECTED	// Loop at idle_pass has side effects, don't check again
+};
+
+// Addressing modes of the opcodes allowed in idle loops
+enum {
+	IDLE_OP_NO,		// Opcode not allowed
+	IDLE_OP_IMP,
+	IDLE_OP_IMM,
+	IDLE_OP_ZP,
+	IDLE_OP_ZPX,
+	IDLE_OP_ZPY,
+	IDLE_OP_ABS,
+	IDLE_OP_ABSX,
+	IDLE_OP_ABSY,
+	IDLE_OP_INDX,
+	IDLE_OP_INDY,
+	IDLE_OP_BRANCH,	// Only as the closing instruction
+	IDLE_OP_JMP		// Only as the closing instruction
+};
+
+// Loads, compares, BIT, AND/ORA/EOR, register transfers and flag
+// instructions; none of them write memory or touch the stack
+static int idle_op_mode(uint8_t op)
+{
+	switch (op) {
+		case 0xaa: case 0xa8: case 0x8a: case 0x98: case 0xba:	// TAX TAY TXA TYA TSX
+		case 0xea: case 0x18: case 0x38: case 0xb8:				// NOP CLC SEC CLV
+			return IDLE_OP_IMP;
+		case 0xa9: case 0xa2: case 0xa0: case 0xc9: case 0xe0: case 0xc0:
+		case 0x29: case 0x09: case 0x49:
+			return IDLE_OP_IMM;
+		case 0xa5: case 0xa6: case 0xa4: case 0xc5: case 0xe4: case 0xc4:
+		case 0x24: case 0x25: case 0x05: case 0x45:
+			return IDLE_OP_ZP;
+		case 0xb5: case 0xb4: case 0xd5: case 0x35: case 0x15: case 0x55:
+			return IDLE_OP_ZPX;
+		case 0xb6:
+			return IDLE_OP_ZPY;
+		case 0xad: case 0xae: case 0xac: case 0xcd: case 0xec: case 0xcc:
+		case 0x2c: case 0x2d: case 0x0d: case 0x4d:
+			return IDLE_OP_ABS;
+		case 0xbd: case 0xbc: case 0xdd: case 0x3d: case 0x1d: case 0x5d:
+			return IDLE_OP_ABSX;
+		case 0xb9: case 0xbe: case 0xd9: case 0x39: case 0x19: case 0x59:
+			return IDLE_OP_ABSY;
+		case 0xa1: case 0xc1: case 0x21: case 0x01: case 0x41:
+			return IDLE_OP_INDX;
+		case 0xb1: case 0xd1: case 0x31: case 0x11: case 0x51:
+			return IDLE_OP_INDY;
+		case 0x10: case 0x30: case 0x50: case 0x70:
+		case 0x90: case 0xb0: case 0xd0: case 0xf0:
+			return IDLE_OP_BRANCH;
+		case 0x4c:
+			return IDLE_OP_JMP;
+		default:
+			return IDLE_OP_NO;
+	}
+}
+
+/*
+ *  Check that the loop from head to the branch/JMP at end only executes
+ *  instructions and reads without side effects, with the current registers
+ */
+
+bool MOS6510::idle_loop_pure(uint16_t head, uint16_t end) const
+{
+	// Code must be in RAM/ROM and not cross into an unmapped page
+	const uint8_t * page = read_page[head >> 8];
+	if (page == nullptr || (head >> 8) != ((end + 2) >> 8)) {
+		return false;
+	}
+	const uint8_t * code = page - (head & 0xff00);
+
+	uint16_t adr = head;
+	while (true) {
+		uint8_t op = code[adr];
+		uint16_t ea = 0;
+		bool mem = true;
+
+		switch (idle_op_mode(op)) {
+			case IDLE_OP_IMP:
+				adr += 1;
+				mem = false;
+				break;
+			case IDLE_OP_IMM:
+				adr += 2;
+				mem = false;
+				break;
+			case IDLE_OP_ZP:		// Zero page is always RAM
+			case IDLE_OP_ZPX:
+			case IDLE_OP_ZPY:
+				adr += 2;
+				mem = false;
+				break;
+			case IDLE_OP_ABS:
+				ea = code[adr + 1] | (code[adr + 2] << 8);
+				adr += 3;
+				break;
+			case IDLE_OP_ABSX:
+				ea = (code[adr + 1] | (code[adr + 2] << 8)) + x;
+				adr += 3;
+				break;
+			case IDLE_OP_ABSY:
+				ea = (code[adr + 1] | (code[adr + 2] << 8)) + y;
+				adr += 3;
+				break;
+			case IDLE_OP_INDX: {
+				uint8_t zp = code[adr + 1] + x;
+				ea = ram[zp] | (ram[(zp + 1) & 0xff] << 8);
+				adr += 2;
+				break;
+			}
+			case IDLE_OP_INDY: {
+				uint8_t zp = code[adr + 1];
+				ea = (ram[zp] | (ram[(zp + 1) & 0xff] << 8)) + y;
+				adr += 2;
+				break;
+			}
+			case IDLE_OP_BRANCH:
+			case IDLE_OP_JMP:
+				return adr == end;
+			default:
+				return false;
+		}
+
+		if (mem && read_page[ea >> 8] == nullptr) {
+			switch (read_handler[ea >> 8]) {
+				case PAGE_VIC:
+#if !PRECISE_CIA_CYCLES
+				case PAGE_CIA1:
+#endif
+					break;
+#if !PRECISE_CIA_CYCLES
+				case PAGE_CIA2:
+					if (ThePrefs.Emul1541Proc) {
+						return false;	// The 1541 drives the IEC lines in $dd00
+					}
+					break;
+#endif
+				default:	// Color RAM (random bits), SID, cartridge
+					return false;
+			}
+		}
+
+		if (adr > end) {
+			return false;
+		}
+	}
+}
+
+/*
+ *  Taken branch or JMP from end back to head: skip whole passes of an idle
+ *  loop, returns the new cycles_left
+ */
+
+int MOS6510::idle_loop(uint16_t head, uint16_t end, int cycles_left)
+{
+	IdlePass pass = {
+		head, end, a, x, y, sp, n_flag, z_flag, v_flag, d_flag, i_flag, c_flag
+	};
+
+	if (idle_state == IDLE_NONE || !(pass == idle_pass)) {
+		idle_pass = pass;
+		idle_cycles_left = cycles_left;
+		idle_state = IDLE_SEEN;
+		return cycles_left;
+	}
+	if (idle_state == IDLE_REJECTED) {
+		return cycles_left;
+	}
+
+	int pass_cycles = idle_cycles_left - cycles_left;
+	idle_cycles_left = cycles_left;
+	if (pass_cycles <= 0) {
+		return cycles_left;
+	}
+	if (! idle_loop_pure(head, end)) {
+		idle_state = IDLE_REJECTED;
+		return cycles_left;
+	}
+
+	int skip = cycles_left - cycles_left % pass_cycles;
+	if (skip > 0) {
+#if PRECISE_CIA_CYCLES
+		the_cia1->EmulateLine(skip);
+		the_cia2->EmulateLine(skip);
+#endif
+		idle_skipped += skip;
+		cycles_left -= skip;
+		idle_cycles_left = cycles_left;
+	}
+	return cycles_left;
+}
+
+
+#if CPU_BLOCK_CACHE
+
+/*
+ *  Predecoded block cache
+ *
+ *  Instructions are decoded once into (opcode, operand) pairs, grouped in
+ *  blocks of straight-line code that end at the first JMP/JSR/RTS/RTI/BRK
+ *  or at the end of the page. Conditional branches don't end a block, a
+ *  taken branch simply leaves it. EmulateLine() then takes opcodes and
+ *  operands from the block instead of going through read_byte() for each
+ *  byte, which matters most for the Kernal and BASIC ROMs in flash.
+ *
+ *  Blocks are tagged with the read_page[] entry they were decoded from,
+ *  so a bank switch or different memory configuration simply misses, and
+ *  with the page generation: the first write to a page holding cached
+ *  code bumps page_gen[] and ends the current block, which also handles
+ *  self-modifying code within a block. Zero page, stack and I/O are never
+ *  cached since they are written without going through write_byte().
+ */
+
+// Instruction length, OP_END marks opcodes that always leave the block
+const uint8_t OP_END = 0x80;
+
+static const uint8_t op_info[256] = {
+	1|OP_END,2,1|OP_END,2,2,2,2,2,1,2,1,2,3,3,3,3,				// $00
+	2,2,1|OP_END,2,2,2,2,2,1,3,1,3,3,3,3,3,						// $10
+	3|OP_END,2,1|OP_END,2,2,2,2,2,1,2,1,2,3,3,3,3,				// $20
+	2,2,1|OP_END,2,2,2,2,2,1,3,1,3,3,3,3,3,						// $30
+	1|OP_END,2,1|OP_END,2,2,2,2,2,1,2,1,2,3|OP_END,3,3,3,		// $40
+	2,2,1|OP_END,2,2,2,2,2,1,3,1,3,3,3,3,3,						// $50
+	1|OP_END,2,1|OP_END,2,2,2,2,2,1,2,1,2,3|OP_END,3,3,3,		// $60
+	2,2,1|OP_END,2,2,2,2,2,1,3,1,3,3,3,3,3,						// $70
+	2,2,2,2,2,2,2,2,1,2,1,2,3,3,3,3,							// $80
+	2,2,1|OP_END,2,2,2,2,2,1,3,1,3,3,3,3,3,						// $90
+	2,2,2,2,2,2,2,2,1,2,1,2,3,3,3,3,							// $a0
+	2,2,1|OP_END,2,2,2,2,2,1,3,1,3,3,3,3,3,						// $b0
+	2,2,2,2,2,2,2,2,1,2,1,2,3,3,3,3,							// $c0
+	2,2,1|OP_END,2,2,2,2,2,1,3,1,3,3,3,3,3,						// $d0
+	2,2,2,2,2,2,2,2,1,2,1,2,3,3,3,3,							// $e0
+	2,2,2|OP_END,2,2,2,2,2,1,3,1,3,3,3,3,3,						// $f0 ($f2 = emulator trap)
+};
+
+inline unsigned op_len(uint8_t op)
+{
+	return op_info[op] & 3;
+}
+
+
+/*
+ *  Fetch next opcode and its operand
+ */
+
+inline uint8_t MOS6510::fetch_opcode(uint16_t & operand)
+{
+	if (block_op == block_end || pc != block_pc) {
+		enter_block();
+	}
+	const DecodedOp * op = block_op++;
+	block_pc = pc + op->len;
+	pc++;
+	operand = op->operand;
+	return op->opcode;
+}
+
+
+/*
+ *  Look up (or decode) the block starting at pc
+ */
+
+void MOS6510::enter_block()
+{
+	uint8_t page_num = pc >> 8;
+	const uint8_t * page = read_page[page_num];
+
+	if (page != nullptr && page_num >= 2 && (pc & 0xff) + op_len(page[pc & 0xff]) <= 0x100) {
+		CodeBlock & b = block_cache[(pc ^ (pc >> 8)) & (CPU_BLOCK_CACHE - 1)];
+		if (b.page == page && b.pc == pc && b.gen == page_gen[page_num]) {
+			block_stats.hits++;
+		} else {
+			decode_block(b, page);
+			block_stats.misses++;
+		}
+		block_op = b.ops;
+		block_end = b.ops + b.count;
+		block_pc = pc;
+		return;
+	}
+
+	// Decode single instruction through the normal memory access path
+	uncached_op.opcode = read_byte(pc);
+	uncached_op.len = op_len(uncached_op.opcode);
+	uncached_op.operand = 0;
+	if (uncached_op.len > 1) {
+		uncached_op.operand = read_byte(pc + 1);
+	}
+	if (uncached_op.len > 2) {
+		uncached_op.operand |= read_byte(pc + 2) << 8;
+	}
+	block_op = &uncached_op;
+	block_end = block_op + 1;
+	block_pc = pc;
+	block_stats.uncached++;
+}
+
+
+/*
+ *  Decode block at pc into b
+ */
+
+void MOS6510::decode_block(CodeBlock & b, const uint8_t * page)
+{
+	unsigned ofs = pc & 0xff;
+	unsigned n = 0;
+
+	while (n < CPU_BLOCK_OPS && ofs < 0x100) {
+		uint8_t op = page[ofs];
+		unsigned len = op_len(op);
+		if (ofs + len > 0x100) {
+			break;	// Crosses into next page
+		}
+
+		DecodedOp & d = b.ops[n++];
+		d.opcode = op;
+		d.len = len;
+		d.operand = 0;
+		if (len > 1) {
+			d.operand = page[ofs + 1];
+		}
+		if (len > 2) {
+			d.operand |= page[ofs + 2] << 8;
+		}
+		ofs += len;
+
+		if (op_info[op] & OP_END) {
+			break;
+		}
+	}
+
+	b.page = page;
+	b.gen = page_gen[pc >> 8];
+	b.pc = pc;
+	b.count = n;
+	code_pages[pc >> 13] |= 1u << ((pc >> 8) & 31);
+}
+
+
+/*
+ *  Write to a page holding cached code: drop its blocks
+ */
+
+void MOS6510::invalidate_code_page(uint8_t page)
+{
+	code_pages[page >> 5] &= ~(1u << (page & 31));
+	page_gen[page]++;
+	block_end = block_op;		// Current block may have been modified
+	block_stats.invalidations++;
+}
+
+
+/*
+ *  Drop all cached blocks
+ */
+
+void MOS6510::FlushBlockCache()
+{
+	for (auto & gen : page_gen) {
+		gen++;
+	}
+	memset(code_pages, 0, sizeof(code_pages));
+	block_op = block_end = &uncached_op;
+}
+
+#endif
+
+
+/*
+ *  Emulate cycles_left worth of 6510 instructions, cycles_after CPU cycles
+ *  of the raster line remain after them
  *  Returns number of cycles of last instruction
  */
 
-int MOS6510::EmulateLine(int cycles_left)
+int MOS6510::EmulateLine(int cycles_left, int cycles_after)
 {
 	uint8_t tmp, tmp2;
 	uint16_t adr, tmp_adr;
 
 	int last_cycles = 0;
 
+#if CPU_BLOCK_CACHE
+	uint16_t operand = 0;	// Operand of the current instruction
+
+#define FETCH_OPCODE() fetch_opcode(operand)
+#define read_byte_imm() (pc++, (uint8_t)operand)
+#define read_adr_abs() (pc += 2, operand)
+#define peek_operand_lo() ((uint8_t)operand)
+#define peek_operand_hi() ((uint8_t)(operand >> 8))
+#endif
+
 #define RESET_PENDING (int_line[INT_RESET])
 #define IRQ_PENDING (int_line[INT_VICIRQ] || int_line[INT_CIAIRQ])
 #define CHECK_SO ;
+#define IDLE_LOOP_CHECK(op_adr, target) \
+	if ((target) <= (op_adr) && (op_adr) - (target) < IDLE_LOOP_SIZE && ThePrefs.SkipIdleLoops) { \
+		cycles_left = idle_loop(target, op_adr, cycles_left); \
+	}
 
 	if (interrupt_delay > 0) {
 		interrupt_delay--;
 		return 0; // Return immediately to let EmulateLine be called again
 	}
 
+	idle_state = IDLE_NONE;
+
+	line_cycles_left = &cycles_left;
+	line_cycles_after = cycles_after;
+
 #include "CPU_emulline.h"
 
 		// Extension opcode
-		case 0xf2:
+		OPCODE(0xf2):
 			if ((pc < 0xa000) || (pc >= 0xc000 && pc < 0xe000)) {
 				illegal_op(pc - 1);
 			} else switch (read_byte_imm()) {
@@ -773,5 +1354,7 @@ int MOS6510::EmulateLine(int cycles_left)
 		}
 	}
 
+	line_cycles_left = &line_end_cycles;
+	line_cycles_after = 0;
 	return last_cycles;
 }
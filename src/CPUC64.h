@@ -34,6 +34,23 @@
 #define PRECISE_CIA_CYCLES 0
 #endif
 
+// Set this to 1 to split the line-based CPU emulation at CIA timer
+// underflows, so their interrupts are taken at the cycle they occur
+#ifndef PRECISE_CIA_IRQ
+#define PRECISE_CIA_IRQ 1
+#endif
+
+// Number of predecoded instruction blocks cached by the 6510 (power of
+// two, 0 = fetch and decode every instruction from memory)
+#ifndef CPU_BLOCK_CACHE
+#define CPU_BLOCK_CACHE 0
+#endif
+
+// Maximum number of instructions in a cached block
+#ifndef CPU_BLOCK_OPS
+#define CPU_BLOCK_OPS 8
+#endif
+
 
 // Interrupt types
 enum {
@@ -52,6 +69,7 @@ class Cartridge;
 class IEC;
 class Tape;
 struct MOS6510State;
+enum class CartMap : uint8_t;
 
 
 // 6510 emulation (C64)
@@ -70,12 +88,17 @@ public:
 		the_cart = cart;
 		the_iec = iec;
 		the_tape = tape;
+#ifndef FRODO_SC
+		map_sids();
+		map_valid = false;	// Cartridge may have changed
+		map_memory();
+#endif
 	}
 
 #ifdef FRODO_SC
 	void EmulateCycle();				// Emulate one clock cycle
 #else
-	int EmulateLine(int cycles_left);	// Emulate until cycles_left underflows
+	int EmulateLine(int cycles_left, int cycles_after = 0);	// Emulate until cycles_left underflows, cycles_after remain of the line
 #endif
 
 	void Reset();
@@ -139,6 +162,26 @@ public:
 
 	int ExtConfig;			// Memory configuration for ExtRead/WriteByte (0..7)
 
+#ifndef FRODO_SC
+	uint64_t SkippedIdleCycles() const { return idle_skipped; }	// Cycles fast-forwarded in idle loops
+	uint32_t CycleCounter() const;		// C64 clock cycle of the current instruction
+
+	// Block cache statistics, counted per block entered
+	struct BlockCacheStats {
+		uint64_t hits;			// Block found and still valid
+		uint64_t misses;		// Block (re)decoded
+		uint64_t uncached;		// Instruction in I/O, zero page or stack, or crossing a page
+		uint64_t invalidations;	// Writes to pages holding cached code
+	};
+
+#if CPU_BLOCK_CACHE
+	void FlushBlockCache();		// Call after writing RAM or ROM behind the CPU's back
+	const BlockCacheStats & GetBlockCacheStats() const { return block_stats; }
+#else
+	void FlushBlockCache() {}
+#endif
+#endif
+
 #ifdef FRODO_SC
 	bool BALow;				// BA line for Frodo SC
 #endif
@@ -210,6 +253,87 @@ private:
 	bool tape_sense;			// Tape sense line (true = button pressed)
 	int	borrowed_cycles;		// Borrowed cycles from next line
 	uint8_t dfff_byte;			// Byte at $dfff for emulator ID
+
+	void map_memory();			// Update page tables from *_in flags and cartridge
+	void map_sids();			// Update sid_slot/io_sid from the SID's extra SIDs
+	void write_sid(MOS6581 * sid, uint16_t adr, uint8_t byte);
+
+	// SID answering each 32-byte slot of $d400-$d7ff (the_sid, unless an
+	// extra SID sits there) and of $de00-$dfff (nullptr = cartridge I/O)
+	MOS6581 * sid_slot[32];
+	MOS6581 * io_sid[16];
+
+	// Page tables: pointer to the 256 bytes mapped at each page, or
+	// nullptr if accesses go through read/write_handler (PAGE_*)
+	const uint8_t * read_page[256];
+	uint8_t * write_page[256];
+	uint8_t read_handler[256];
+	uint8_t write_handler[256];
+
+	// Configuration the page tables were built for
+	struct MemoryMap {
+		bool basic_in, kernal_in, char_in, io_in;
+		bool notEXROM, notGAME;
+		CartMap roml, romh;			// ROML at $8000, ROMH at $a000 or $e000
+		const uint8_t * roml_block;
+		const uint8_t * romh_block;
+		bool operator==(const MemoryMap &) const = default;
+	};
+	MemoryMap mapped;
+	bool map_valid;
+
+	int idle_loop(uint16_t head, uint16_t end, int cycles_left);
+	bool idle_loop_pure(uint16_t head, uint16_t end) const;
+
+	// Idle loop detection: CPU state at the last pass through a loop
+	struct IdlePass {
+		uint16_t head, end;		// Loop start, address of closing branch/JMP
+		uint8_t a, x, y, sp, n_flag, z_flag;
+		bool v_flag, d_flag, i_flag, c_flag;
+		bool operator==(const IdlePass &) const = default;
+	};
+	IdlePass idle_pass;
+	int idle_cycles_left;		// cycles_left at that pass
+	uint8_t idle_state;			// IDLE_* (CPUC64.cpp), reset every line
+	uint64_t idle_skipped;		// Total cycles skipped
+
+	// cycles_left of the running EmulateLine() and the cycles of the line
+	// after it, timestamp SID writes and IEC accesses
+	const int * line_cycles_left;
+	int line_cycles_after;
+
+#if CPU_BLOCK_CACHE
+	// Predecoded instruction, operand bytes in little-endian order
+	struct DecodedOp {
+		uint8_t opcode;
+		uint8_t len;			// Instruction length in bytes
+		uint16_t operand;
+	};
+
+	// Straight-line run of instructions within one page, ended by the
+	// first JMP/JSR/RTS/RTI/BRK/JAM or after CPU_BLOCK_OPS instructions
+	struct CodeBlock {
+		const uint8_t * page;	// read_page[] entry the block was decoded from
+		uint32_t gen;			// page_gen[] at decode time
+		uint16_t pc;			// Address of first instruction
+		uint8_t count;			// Number of instructions
+		DecodedOp ops[CPU_BLOCK_OPS];
+	};
+
+	uint8_t fetch_opcode(uint16_t & operand);
+	void enter_block();
+	void decode_block(CodeBlock & b, const uint8_t * page);
+	void invalidate_code_page(uint8_t page);
+
+	CodeBlock block_cache[CPU_BLOCK_CACHE];	// Direct-mapped by start address
+	uint32_t page_gen[256];		// Bumped on writes to pages with cached code
+	uint32_t code_pages[8];		// Bitmap of pages that have blocks at the current page_gen
+	const DecodedOp * block_op;	// Next instruction of the current block
+	const DecodedOp * block_end;
+	uint16_t block_pc;			// Address block_op was decoded from
+	DecodedOp uncached_op;		// Instruction decoded outside the cache
+	BlockCacheStats block_stats;
+#endif
 #endif
 
 	bool basic_in, kernal_in, char_in, io_in;
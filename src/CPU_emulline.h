@@ -21,12 +21,43 @@
  */
 
 
+// Set this to 1 to dispatch opcodes through a GCC computed-goto table
+// instead of a switch statement
+#ifndef CPU_THREADED_DISPATCH
+#define CPU_THREADED_DISPATCH 0
+#endif
+
+
 /*
- *  Addressing mode macros
+ *  Instruction stream macros (the 6510 replaces these to execute from
+ *  its predecoded block cache)
  */
 
+// Fetch opcode
+#ifndef FETCH_OPCODE
+#define FETCH_OPCODE() read_byte(pc++)
+#endif
+
 // Read immediate operand
+#ifndef read_byte_imm
 #define read_byte_imm() read_byte(pc++)
+#endif
+
+// Read absolute operand address
+#ifndef read_adr_abs
+#define read_adr_abs() (tmp_adr = read_word(pc), pc+=2, tmp_adr)
+#endif
+
+// First/second operand byte without advancing PC
+#ifndef peek_operand_lo
+#define peek_operand_lo() read_byte(pc)
+#define peek_operand_hi() read_byte(pc + 1)
+#endif
+
+
+/*
+ *  Addressing mode macros
+ */
 
 // Read zeropage operand address
 #define read_adr_zero() ((uint16_t)read_byte_imm())
@@ -37,9 +68,6 @@
 // Read zeropage y-indexed operand address
 #define read_adr_zero_y() ((read_byte_imm() + y) & 0xff)
 
-// Read absolute operand address
-#define read_adr_abs() (tmp_adr = read_word(pc), pc+=2, tmp_adr)
-
 // Read absolute x-indexed operand address
 #define read_adr_abs_x() (read_adr_abs() + x)
 
@@ -136,9 +164,68 @@
 // Jump to address
 #define jump(adr) pc = (adr)
 
+/*
+ *  Opcode dispatch
+ *
+ *  With CPU_THREADED_DISPATCH the opcode handlers are labels and every
+ *  handler ends with its own copy of the cycle accounting and an indirect
+ *  jump through opcode_table[] to the next one (GCC computed goto).
+ *  Otherwise they are the cases of one switch statement in a loop.
+ *  OPCODE_DONE is run after every opcode (the 1541 counts its cycles there).
+ */
+
+#ifndef OPCODE_DONE
+#define OPCODE_DONE
+#endif
+
+// Called for taken branches and JMP abs, before the cycles are counted
+#ifndef IDLE_LOOP_CHECK
+#define IDLE_LOOP_CHECK(op_adr, target)
+#endif
+
+#if CPU_THREADED_DISPATCH
+
+#define OPCODE(op) op_##op
+
+#if PRECISE_CPU_CYCLES
+#if PRECISE_CIA_CYCLES && !defined(IS_CPU_1541)
+#define OPCODE_CIA_CYCLES \
+	the_cia1->EmulateLine(last_cycles); \
+	the_cia2->EmulateLine(last_cycles);
+#else
+#define OPCODE_CIA_CYCLES
+#endif
+
+// End of opcode, decrement cycles left and jump to next opcode
+#define ENDOP(cyc) \
+	last_cycles = cyc; \
+	OPCODE_DONE; \
+	last_cycles += page_cycles; \
+	page_cycles = 0; \
+	OPCODE_CIA_CYCLES \
+	if ((cycles_left -= last_cycles) < 0) { \
+		borrowed_cycles = -cycles_left; \
+		break; \
+	} \
+	goto *opcode_table[FETCH_OPCODE()];
+#else
+#define ENDOP(cyc) \
+	last_cycles = cyc; \
+	OPCODE_DONE; \
+	if ((cycles_left -= last_cycles) < 0) \
+		break; \
+	goto *opcode_table[FETCH_OPCODE()];
+#endif
+
+#else
+
+#define OPCODE(op) case op
+
 // End of opcode, decrement cycles left
 #define ENDOP(cyc) last_cycles = cyc; break;
 
+#endif
+
 
 	// Handle pending interrupts
 handle_int:
@@ -188,466 +275,506 @@ handle_int:
 	while ((cycles_left -= last_cycles) >= 0) {
 #endif
 
-		switch (read_byte_imm()) {
+#if CPU_THREADED_DISPATCH
+		static const void * const opcode_table[256] = {
+			&&op_0x00, &&op_0x01, &&op_0x02, &&op_0x03, &&op_0x04, &&op_0x05, &&op_0x06, &&op_0x07,
+			&&op_0x08, &&op_0x09, &&op_0x0a, &&op_0x0b, &&op_0x0c, &&op_0x0d, &&op_0x0e, &&op_0x0f,
+			&&op_0x10, &&op_0x11, &&op_0x12, &&op_0x13, &&op_0x14, &&op_0x15, &&op_0x16, &&op_0x17,
+			&&op_0x18, &&op_0x19, &&op_0x1a, &&op_0x1b, &&op_0x1c, &&op_0x1d, &&op_0x1e, &&op_0x1f,
+			&&op_0x20, &&op_0x21, &&op_0x22, &&op_0x23, &&op_0x24, &&op_0x25, &&op_0x26, &&op_0x27,
+			&&op_0x28, &&op_0x29, &&op_0x2a, &&op_0x2b, &&op_0x2c, &&op_0x2d, &&op_0x2e, &&op_0x2f,
+			&&op_0x30, &&op_0x31, &&op_0x32, &&op_0x33, &&op_0x34, &&op_0x35, &&op_0x36, &&op_0x37,
+			&&op_0x38, &&op_0x39, &&op_0x3a, &&op_0x3b, &&op_0x3c, &&op_0x3d, &&op_0x3e, &&op_0x3f,
+			&&op_0x40, &&op_0x41, &&op_0x42, &&op_0x43, &&op_0x44, &&op_0x45, &&op_0x46, &&op_0x47,
+			&&op_0x48, &&op_0x49, &&op_0x4a, &&op_0x4b, &&op_0x4c, &&op_0x4d, &&op_0x4e, &&op_0x4f,
+			&&op_0x50, &&op_0x51, &&op_0x52, &&op_0x53, &&op_0x54, &&op_0x55, &&op_0x56, &&op_0x57,
+			&&op_0x58, &&op_0x59, &&op_0x5a, &&op_0x5b, &&op_0x5c, &&op_0x5d, &&op_0x5e, &&op_0x5f,
+			&&op_0x60, &&op_0x61, &&op_0x62, &&op_0x63, &&op_0x64, &&op_0x65, &&op_0x66, &&op_0x67,
+			&&op_0x68, &&op_0x69, &&op_0x6a, &&op_0x6b, &&op_0x6c, &&op_0x6d, &&op_0x6e, &&op_0x6f,
+			&&op_0x70, &&op_0x71, &&op_0x72, &&op_0x73, &&op_0x74, &&op_0x75, &&op_0x76, &&op_0x77,
+			&&op_0x78, &&op_0x79, &&op_0x7a, &&op_0x7b, &&op_0x7c, &&op_0x7d, &&op_0x7e, &&op_0x7f,
+			&&op_0x80, &&op_0x81, &&op_0x82, &&op_0x83, &&op_0x84, &&op_0x85, &&op_0x86, &&op_0x87,
+			&&op_0x88, &&op_0x89, &&op_0x8a, &&op_0x8b, &&op_0x8c, &&op_0x8d, &&op_0x8e, &&op_0x8f,
+			&&op_0x90, &&op_0x91, &&op_0x92, &&op_0x93, &&op_0x94, &&op_0x95, &&op_0x96, &&op_0x97,
+			&&op_0x98, &&op_0x99, &&op_0x9a, &&op_0x9b, &&op_0x9c, &&op_0x9d, &&op_0x9e, &&op_0x9f,
+			&&op_0xa0, &&op_0xa1, &&op_0xa2, &&op_0xa3, &&op_0xa4, &&op_0xa5, &&op_0xa6, &&op_0xa7,
+			&&op_0xa8, &&op_0xa9, &&op_0xaa, &&op_0xab, &&op_0xac, &&op_0xad, &&op_0xae, &&op_0xaf,
+			&&op_0xb0, &&op_0xb1, &&op_0xb2, &&op_0xb3, &&op_0xb4, &&op_0xb5, &&op_0xb6, &&op_0xb7,
+			&&op_0xb8, &&op_0xb9, &&op_0xba, &&op_0xbb, &&op_0xbc, &&op_0xbd, &&op_0xbe, &&op_0xbf,
+			&&op_0xc0, &&op_0xc1, &&op_0xc2, &&op_0xc3, &&op_0xc4, &&op_0xc5, &&op_0xc6, &&op_0xc7,
+			&&op_0xc8, &&op_0xc9, &&op_0xca, &&op_0xcb, &&op_0xcc, &&op_0xcd, &&op_0xce, &&op_0xcf,
+			&&op_0xd0, &&op_0xd1, &&op_0xd2, &&op_0xd3, &&op_0xd4, &&op_0xd5, &&op_0xd6, &&op_0xd7,
+			&&op_0xd8, &&op_0xd9, &&op_0xda, &&op_0xdb, &&op_0xdc, &&op_0xdd, &&op_0xde, &&op_0xdf,
+			&&op_0xe0, &&op_0xe1, &&op_0xe2, &&op_0xe3, &&op_0xe4, &&op_0xe5, &&op_0xe6, &&op_0xe7,
+			&&op_0xe8, &&op_0xe9, &&op_0xea, &&op_0xeb, &&op_0xec, &&op_0xed, &&op_0xee, &&op_0xef,
+			&&op_0xf0, &&op_0xf1, &&op_0xf2, &&op_0xf3, &&op_0xf4, &&op_0xf5, &&op_0xf6, &&op_0xf7,
+			&&op_0xf8, &&op_0xf9, &&op_0xfa, &&op_0xfb, &&op_0xfc, &&op_0xfd, &&op_0xfe, &&op_0xff
+		};
+
+		goto *opcode_table[FETCH_OPCODE()];
+		{
+#else
+		switch (FETCH_OPCODE()) {
+#endif
 
 
 		// Load group
-		case 0xa9:	// LDA #imm
+		OPCODE(0xa9):	// LDA #imm
 			set_nz(a = read_byte_imm());
 			ENDOP(2);
 
-		case 0xa5:	// LDA zero
+		OPCODE(0xa5):	// LDA zero
 			set_nz(a = read_byte_zero());
 			ENDOP(3);
 
-		case 0xb5:	// LDA zero,X
+		OPCODE(0xb5):	// LDA zero,X
 			set_nz(a = read_byte_zero_x());
 			ENDOP(4);
 
-		case 0xad:	// LDA abs
+		OPCODE(0xad):	// LDA abs
 			set_nz(a = read_byte_abs());
 			ENDOP(4);
 
-		case 0xbd:	// LDA abs,X
+		OPCODE(0xbd):	// LDA abs,X
 			set_nz(a = read_byte_abs_x());
 			ENDOP(4);
 
-		case 0xb9:	// LDA abs,Y
+		OPCODE(0xb9):	// LDA abs,Y
 			set_nz(a = read_byte_abs_y());
 			ENDOP(4);
 
-		case 0xa1:	// LDA (ind,X)
+		OPCODE(0xa1):	// LDA (ind,X)
 			set_nz(a = read_byte_ind_x());
 			ENDOP(6);
 		
-		case 0xb1:	// LDA (ind),Y
+		OPCODE(0xb1):	// LDA (ind),Y
 			set_nz(a = read_byte_ind_y());
 			ENDOP(5);
 
-		case 0xa2:	// LDX #imm
+		OPCODE(0xa2):	// LDX #imm
 			set_nz(x = read_byte_imm());
 			ENDOP(2);
 
-		case 0xa6:	// LDX zero
+		OPCODE(0xa6):	// LDX zero
 			set_nz(x = read_byte_zero());
 			ENDOP(3);
 
-		case 0xb6:	// LDX zero,Y
+		OPCODE(0xb6):	// LDX zero,Y
 			set_nz(x = read_byte_zero_y());
 			ENDOP(4);
 
-		case 0xae:	// LDX abs
+		OPCODE(0xae):	// LDX abs
 			set_nz(x = read_byte_abs());
 			ENDOP(4);
 
-		case 0xbe:	// LDX abs,Y
+		OPCODE(0xbe):	// LDX abs,Y
 			set_nz(x = read_byte_abs_y());
 			ENDOP(4);
 
-		case 0xa0:	// LDY #imm
+		OPCODE(0xa0):	// LDY #imm
 			set_nz(y = read_byte_imm());
 			ENDOP(2);
 
-		case 0xa4:	// LDY zero
+		OPCODE(0xa4):	// LDY zero
 			set_nz(y = read_byte_zero());
 			ENDOP(3);
 
-		case 0xb4:	// LDY zero,X
+		OPCODE(0xb4):	// LDY zero,X
 			set_nz(y = read_byte_zero_x());
 			ENDOP(4);
 
-		case 0xac:	// LDY abs
+		OPCODE(0xac):	// LDY abs
 			set_nz(y = read_byte_abs());
 			ENDOP(4);
 
-		case 0xbc:	// LDY abs,X
+		OPCODE(0xbc):	// LDY abs,X
 			set_nz(y = read_byte_abs_x());
 			ENDOP(4);
 
 
 		// Store group
-		case 0x85:	// STA zero
+		OPCODE(0x85):	// STA zero
 			write_byte(read_adr_zero(), a);
 			ENDOP(3);
 
-		case 0x95:	// STA zero,X
+		OPCODE(0x95):	// STA zero,X
 			write_byte(read_adr_zero_x(), a);
 			ENDOP(4);
 
-		case 0x8d:	// STA abs
+		OPCODE(0x8d):	// STA abs
 			write_byte(read_adr_abs(), a);
 			ENDOP(4);
 
-		case 0x9d:	// STA abs,X
+		OPCODE(0x9d):	// STA abs,X
 			write_byte(read_adr_abs_x(), a);
 			ENDOP(5);
 
-		case 0x99:	// STA abs,Y
+		OPCODE(0x99):	// STA abs,Y
 			write_byte(read_adr_abs_y(), a);
 			ENDOP(5);
 
-		case 0x81:	// STA (ind,X)
+		OPCODE(0x81):	// STA (ind,X)
 			write_byte(read_adr_ind_x(), a);
 			ENDOP(6);
 
-		case 0x91:	// STA (ind),Y
+		OPCODE(0x91):	// STA (ind),Y
 			write_byte(read_adr_ind_y(), a);
 			ENDOP(6);
 
-		case 0x86:	// STX zero
+		OPCODE(0x86):	// STX zero
 			write_byte(read_adr_zero(), x);
 			ENDOP(3);
 
-		case 0x96:	// STX zero,Y
+		OPCODE(0x96):	// STX zero,Y
 			write_byte(read_adr_zero_y(), x);
 			ENDOP(4);
 
-		case 0x8e:	// STX abs
+		OPCODE(0x8e):	// STX abs
 			write_byte(read_adr_abs(), x);
 			ENDOP(4);
 
-		case 0x84:	// STY zero
+		OPCODE(0x84):	// STY zero
 			write_byte(read_adr_zero(), y);
 			ENDOP(3);
 
-		case 0x94:	// STY zero,X
+		OPCODE(0x94):	// STY zero,X
 			write_byte(read_adr_zero_x(), y);
 			ENDOP(4);
 
-		case 0x8c:	// STY abs
+		OPCODE(0x8c):	// STY abs
 			write_byte(read_adr_abs(), y);
 			ENDOP(4);
 
 
 		// Transfer group
-		case 0xaa:	// TAX
+		OPCODE(0xaa):	// TAX
 			set_nz(x = a);
 			ENDOP(2);
 
-		case 0x8a:	// TXA
+		OPCODE(0x8a):	// TXA
 			set_nz(a = x);
 			ENDOP(2);
 
-		case 0xa8:	// TAY
+		OPCODE(0xa8):	// TAY
 			set_nz(y = a);
 			ENDOP(2);
 
-		case 0x98:	// TYA
+		OPCODE(0x98):	// TYA
 			set_nz(a = y);
 			ENDOP(2);
 
-		case 0xba:	// TSX
+		OPCODE(0xba):	// TSX
 			set_nz(x = sp);
 			ENDOP(2);
 
-		case 0x9a:	// TXS
+		OPCODE(0x9a):	// TXS
 			sp = x;
 			ENDOP(2);
 
 
 		// Arithmetic group
-		case 0x69:	// ADC #imm
+		OPCODE(0x69):	// ADC #imm
 			do_adc(read_byte_imm());
 			ENDOP(2);
 
-		case 0x65:	// ADC zero
+		OPCODE(0x65):	// ADC zero
 			do_adc(read_byte_zero());
 			ENDOP(3);
 
-		case 0x75:	// ADC zero,X
+		OPCODE(0x75):	// ADC zero,X
 			do_adc(read_byte_zero_x());
 			ENDOP(4);
 
-		case 0x6d:	// ADC abs
+		OPCODE(0x6d):	// ADC abs
 			do_adc(read_byte_abs());
 			ENDOP(4);
 
-		case 0x7d:	// ADC abs,X
+		OPCODE(0x7d):	// ADC abs,X
 			do_adc(read_byte_abs_x());
 			ENDOP(4);
 
-		case 0x79:	// ADC abs,Y
+		OPCODE(0x79):	// ADC abs,Y
 			do_adc(read_byte_abs_y());
 			ENDOP(4);
 
-		case 0x61:	// ADC (ind,X)
+		OPCODE(0x61):	// ADC (ind,X)
 			do_adc(read_byte_ind_x());
 			ENDOP(6);
 
-		case 0x71:	// ADC (ind),Y
+		OPCODE(0x71):	// ADC (ind),Y
 			do_adc(read_byte_ind_y());
 			ENDOP(5);
 
-		case 0xe9:	// SBC #imm
-		case 0xeb:	// Undocumented opcode
+		OPCODE(0xe9):	// SBC #imm
+		OPCODE(0xeb):	// Undocumented opcode
 			do_sbc(read_byte_imm());
 			ENDOP(2);
 
-		case 0xe5:	// SBC zero
+		OPCODE(0xe5):	// SBC zero
 			do_sbc(read_byte_zero());
 			ENDOP(3);
 
-		case 0xf5:	// SBC zero,X
+		OPCODE(0xf5):	// SBC zero,X
 			do_sbc(read_byte_zero_x());
 			ENDOP(4);
 
-		case 0xed:	// SBC abs
+		OPCODE(0xed):	// SBC abs
 			do_sbc(read_byte_abs());
 			ENDOP(4);
 
-		case 0xfd:	// SBC abs,X
+		OPCODE(0xfd):	// SBC abs,X
 			do_sbc(read_byte_abs_x());
 			ENDOP(4);
 
-		case 0xf9:	// SBC abs,Y
+		OPCODE(0xf9):	// SBC abs,Y
 			do_sbc(read_byte_abs_y());
 			ENDOP(4);
 
-		case 0xe1:	// SBC (ind,X)
+		OPCODE(0xe1):	// SBC (ind,X)
 			do_sbc(read_byte_ind_x());
 			ENDOP(6);
 
-		case 0xf1:	// SBC (ind),Y
+		OPCODE(0xf1):	// SBC (ind),Y
 			do_sbc(read_byte_ind_y());
 			ENDOP(5);
 
 
 		// Increment/decrement group
-		case 0xe8:	// INX
+		OPCODE(0xe8):	// INX
 			set_nz(++x);
 			ENDOP(2);
 
-		case 0xca:	// DEX
+		OPCODE(0xca):	// DEX
 			set_nz(--x);
 			ENDOP(2);
 
-		case 0xc8:	// INY
+		OPCODE(0xc8):	// INY
 			set_nz(++y);
 			ENDOP(2);
 
-		case 0x88:	// DEY
+		OPCODE(0x88):	// DEY
 			set_nz(--y);
 			ENDOP(2);
 
-		case 0xe6:	// INC zero
+		OPCODE(0xe6):	// INC zero
 			adr = read_adr_zero();
 			write_zp(adr, set_nz(read_zp(adr) + 1));
 			ENDOP(5);
 
-		case 0xf6:	// INC zero,X
+		OPCODE(0xf6):	// INC zero,X
 			adr = read_adr_zero_x();
 			write_zp(adr, set_nz(read_zp(adr) + 1));
 			ENDOP(6);
 
-		case 0xee:	// INC abs
+		OPCODE(0xee):	// INC abs
 			adr = read_adr_abs();
 			write_byte(adr, set_nz(read_byte(adr) + 1));
 			ENDOP(6);
 
-		case 0xfe:	// INC abs,X
+		OPCODE(0xfe):	// INC abs,X
 			adr = read_adr_abs_x();
 			write_byte(adr, set_nz(read_byte(adr) + 1));
 			ENDOP(7);
 
-		case 0xc6:	// DEC zero
+		OPCODE(0xc6):	// DEC zero
 			adr = read_adr_zero();
 			write_zp(adr, set_nz(read_zp(adr) - 1));
 			ENDOP(5);
 
-		case 0xd6:	// DEC zero,X
+		OPCODE(0xd6):	// DEC zero,X
 			adr = read_adr_zero_x();
 			write_zp(adr, set_nz(read_zp(adr) - 1));
 			ENDOP(6);
 
-		case 0xce:	// DEC abs
+		OPCODE(0xce):	// DEC abs
 			adr = read_adr_abs();
 			write_byte(adr, set_nz(read_byte(adr) - 1));
 			ENDOP(6);
 
-		case 0xde:	// DEC abs,X
+		OPCODE(0xde):	// DEC abs,X
 			adr = read_adr_abs_x();
 			write_byte(adr, set_nz(read_byte(adr) - 1));
 			ENDOP(7);
 
 
 		// Logic group
-		case 0x29:	// AND #imm
+		OPCODE(0x29):	// AND #imm
 			set_nz(a &= read_byte_imm());
 			ENDOP(2);
 
-		case 0x25:	// AND zero
+		OPCODE(0x25):	// AND zero
 			set_nz(a &= read_byte_zero());
 			ENDOP(3);
 
-		case 0x35:	// AND zero,X
+		OPCODE(0x35):	// AND zero,X
 			set_nz(a &= read_byte_zero_x());
 			ENDOP(4);
 
-		case 0x2d:	// AND abs
+		OPCODE(0x2d):	// AND abs
 			set_nz(a &= read_byte_abs());
 			ENDOP(4);
 
-		case 0x3d:	// AND abs,X
+		OPCODE(0x3d):	// AND abs,X
 			set_nz(a &= read_byte_abs_x());
 			ENDOP(4);
 
-		case 0x39:	// AND abs,Y
+		OPCODE(0x39):	// AND abs,Y
 			set_nz(a &= read_byte_abs_y());
 			ENDOP(4);
 
-		case 0x21:	// AND (ind,X)
+		OPCODE(0x21):	// AND (ind,X)
 			set_nz(a &= read_byte_ind_x());
 			ENDOP(6);
 
-		case 0x31:	// AND (ind),Y
+		OPCODE(0x31):	// AND (ind),Y
 			set_nz(a &= read_byte_ind_y());
 			ENDOP(5);
 
-		case 0x09:	// ORA #imm
+		OPCODE(0x09):	// ORA #imm
 			set_nz(a |= read_byte_imm());
 			ENDOP(2);
 
-		case 0x05:	// ORA zero
+		OPCODE(0x05):	// ORA zero
 			set_nz(a |= read_byte_zero());
 			ENDOP(3);
 
-		case 0x15:	// ORA zero,X
+		OPCODE(0x15):	// ORA zero,X
 			set_nz(a |= read_byte_zero_x());
 			ENDOP(4);
 
-		case 0x0d:	// ORA abs
+		OPCODE(0x0d):	// ORA abs
 			set_nz(a |= read_byte_abs());
 			ENDOP(4);
 
-		case 0x1d:	// ORA abs,X
+		OPCODE(0x1d):	// ORA abs,X
 			set_nz(a |= read_byte_abs_x());
 			ENDOP(4);
 
-		case 0x19:	// ORA abs,Y
+		OPCODE(0x19):	// ORA abs,Y
 			set_nz(a |= read_byte_abs_y());
 			ENDOP(4);
 
-		case 0x01:	// ORA (ind,X)
+		OPCODE(0x01):	// ORA (ind,X)
 			set_nz(a |= read_byte_ind_x());
 			ENDOP(6);
 
-		case 0x11:	// ORA (ind),Y
+		OPCODE(0x11):	// ORA (ind),Y
 			set_nz(a |= read_byte_ind_y());
 			ENDOP(5);
 
-		case 0x49:	// EOR #imm
+		OPCODE(0x49):	// EOR #imm
 			set_nz(a ^= read_byte_imm());
 			ENDOP(2);
 
-		case 0x45:	// EOR zero
+		OPCODE(0x45):	// EOR zero
 			set_nz(a ^= read_byte_zero());
 			ENDOP(3);
 
-		case 0x55:	// EOR zero,X
+		OPCODE(0x55):	// EOR zero,X
 			set_nz(a ^= read_byte_zero_x());
 			ENDOP(4);
 
-		case 0x4d:	// EOR abs
+		OPCODE(0x4d):	// EOR abs
 			set_nz(a ^= read_byte_abs());
 			ENDOP(4);
 
-		case 0x5d:	// EOR abs,X
+		OPCODE(0x5d):	// EOR abs,X
 			set_nz(a ^= read_byte_abs_x());
 			ENDOP(4);
 
-		case 0x59:	// EOR abs,Y
+		OPCODE(0x59):	// EOR abs,Y
 			set_nz(a ^= read_byte_abs_y());
 			ENDOP(4);
 
-		case 0x41:	// EOR (ind,X)
+		OPCODE(0x41):	// EOR (ind,X)
 			set_nz(a ^= read_byte_ind_x());
 			ENDOP(6);
 
-		case 0x51:	// EOR (ind),Y
+		OPCODE(0x51):	// EOR (ind),Y
 			set_nz(a ^= read_byte_ind_y());
 			ENDOP(5);
 
 
 		// Compare group
-		case 0xc9:	// CMP #imm
+		OPCODE(0xc9):	// CMP #imm
 			set_nz(adr = a - read_byte_imm());
 			c_flag = adr < 0x100;
 			ENDOP(2);
 
-		case 0xc5:	// CMP zero
+		OPCODE(0xc5):	// CMP zero
 			set_nz(adr = a - read_byte_zero());
 			c_flag = adr < 0x100;
 			ENDOP(3);
 
-		case 0xd5:	// CMP zero,X
+		OPCODE(0xd5):	// CMP zero,X
 			set_nz(adr = a - read_byte_zero_x());
 			c_flag = adr < 0x100;
 			ENDOP(4);
 
-		case 0xcd:	// CMP abs
+		OPCODE(0xcd):	// CMP abs
 			set_nz(adr = a - read_byte_abs());
 			c_flag = adr < 0x100;
 			ENDOP(4);
 
-		case 0xdd:	// CMP abs,X
+		OPCODE(0xdd):	// CMP abs,X
 			set_nz(adr = a - read_byte_abs_x());
 			c_flag = adr < 0x100;
 			ENDOP(4);
 
-		case 0xd9:	// CMP abs,Y
+		OPCODE(0xd9):	// CMP abs,Y
 			set_nz(adr = a - read_byte_abs_y());
 			c_flag = adr < 0x100;
 			ENDOP(4);
 
-		case 0xc1:	// CMP (ind,X)
+		OPCODE(0xc1):	// CMP (ind,X)
 			set_nz(adr = a - read_byte_ind_x());
 			c_flag = adr < 0x100;
 			ENDOP(6);
 
-		case 0xd1:	// CMP (ind),Y
+		OPCODE(0xd1):	// CMP (ind),Y
 			set_nz(adr = a - read_byte_ind_y());
 			c_flag = adr < 0x100;
 			ENDOP(5);
 
-		case 0xe0:	// CPX #imm
+		OPCODE(0xe0):	// CPX #imm
 			set_nz(adr = x - read_byte_imm());
 			c_flag = adr < 0x100;
 			ENDOP(2);
 
-		case 0xe4:	// CPX zero
+		OPCODE(0xe4):	// CPX zero
 			set_nz(adr = x - read_byte_zero());
 			c_flag = adr < 0x100;
 			ENDOP(3);
 
-		case 0xec:	// CPX abs
+		OPCODE(0xec):	// CPX abs
 			set_nz(adr = x - read_byte_abs());
 			c_flag = adr < 0x100;
 			ENDOP(4);
 
-		case 0xc0:	// CPY #imm
+		OPCODE(0xc0):	// CPY #imm
 			set_nz(adr = y - read_byte_imm());
 			c_flag = adr < 0x100;
 			ENDOP(2);
 
-		case 0xc4:	// CPY zero
+		OPCODE(0xc4):	// CPY zero
 			set_nz(adr = y - read_byte_zero());
 			c_flag = adr < 0x100;
 			ENDOP(3);
 
-		case 0xcc:	// CPY abs
+		OPCODE(0xcc):	// CPY abs
 			set_nz(adr = y - read_byte_abs());
 			c_flag = adr < 0x100;
 			ENDOP(4);
 
 
 		// Bit-test group
-		case 0x24:	// BIT zero
+		OPCODE(0x24):	// BIT zero
 			z_flag = a & (tmp = read_byte_zero());
 			n_flag = tmp;
 			v_flag = tmp & 0x40;
 			ENDOP(3);
 
-		case 0x2c:	// BIT abs
+		OPCODE(0x2c):	// BIT abs
 			z_flag = a & (tmp = read_byte_abs());
 			n_flag = tmp;
 			v_flag = tmp & 0x40;
@@ -655,126 +782,126 @@ handle_int:
 
 
 		// Shift/rotate group
-		case 0x0a:	// ASL A
+		OPCODE(0x0a):	// ASL A
 			c_flag = a & 0x80;
 			set_nz(a <<= 1);
 			ENDOP(2);
 
-		case 0x06:	// ASL zero
+		OPCODE(0x06):	// ASL zero
 			tmp = read_zp(adr = read_adr_zero());
 			c_flag = tmp & 0x80;
 			write_zp(adr, set_nz(tmp << 1));
 			ENDOP(5);
 
-		case 0x16:	// ASL zero,X
+		OPCODE(0x16):	// ASL zero,X
 			tmp = read_zp(adr = read_adr_zero_x());
 			c_flag = tmp & 0x80;
 			write_zp(adr, set_nz(tmp << 1));
 			ENDOP(6);
 
-		case 0x0e:	// ASL abs
+		OPCODE(0x0e):	// ASL abs
 			tmp = read_byte(adr = read_adr_abs());
 			c_flag = tmp & 0x80;
 			write_byte(adr, set_nz(tmp << 1));
 			ENDOP(6);
 
-		case 0x1e:	// ASL abs,X
+		OPCODE(0x1e):	// ASL abs,X
 			tmp = read_byte(adr = read_adr_abs_x());
 			c_flag = tmp & 0x80;
 			write_byte(adr, set_nz(tmp << 1));
 			ENDOP(7);
 
-		case 0x4a:	// LSR A
+		OPCODE(0x4a):	// LSR A
 			c_flag = a & 0x01;
 			set_nz(a >>= 1);
 			ENDOP(2);
 
-		case 0x46:	// LSR zero
+		OPCODE(0x46):	// LSR zero
 			tmp = read_zp(adr = read_adr_zero());
 			c_flag = tmp & 0x01;
 			write_zp(adr, set_nz(tmp >> 1));
 			ENDOP(5);
 
-		case 0x56:	// LSR zero,X
+		OPCODE(0x56):	// LSR zero,X
 			tmp = read_zp(adr = read_adr_zero_x());
 			c_flag = tmp & 0x01;
 			write_zp(adr, set_nz(tmp >> 1));
 			ENDOP(6);
 
-		case 0x4e:	// LSR abs
+		OPCODE(0x4e):	// LSR abs
 			tmp = read_byte(adr = read_adr_abs());
 			c_flag = tmp & 0x01;
 			write_byte(adr, set_nz(tmp >> 1));
 			ENDOP(6);
 
-		case 0x5e:	// LSR abs,X
+		OPCODE(0x5e):	// LSR abs,X
 			tmp = read_byte(adr = read_adr_abs_x());
 			c_flag = tmp & 0x01;
 			write_byte(adr, set_nz(tmp >> 1));
 			ENDOP(7);
 
-		case 0x2a:	// ROL A
+		OPCODE(0x2a):	// ROL A
 			tmp2 = a & 0x80;
 			set_nz(a = c_flag ? (a << 1) | 0x01 : a << 1);
 			c_flag = tmp2;
 			ENDOP(2);
 
-		case 0x26:	// ROL zero
+		OPCODE(0x26):	// ROL zero
 			tmp = read_zp(adr = read_adr_zero());
 			tmp2 = tmp & 0x80;
 			write_zp(adr, set_nz(c_flag ? (tmp << 1) | 0x01 : tmp << 1));
 			c_flag = tmp2;
 			ENDOP(5);
 
-		case 0x36:	// ROL zero,X
+		OPCODE(0x36):	// ROL zero,X
 			tmp = read_zp(adr = read_adr_zero_x());
 			tmp2 = tmp & 0x80;
 			write_zp(adr, set_nz(c_flag ? (tmp << 1) | 0x01 : tmp << 1));
 			c_flag = tmp2;
 			ENDOP(6);
 
-		case 0x2e:	// ROL abs
+		OPCODE(0x2e):	// ROL abs
 			tmp = read_byte(adr = read_adr_abs());
 			tmp2 = tmp & 0x80;
 			write_byte(adr, set_nz(c_flag ? (tmp << 1) | 0x01 : tmp << 1));
 			c_flag = tmp2;
 			ENDOP(6);
 
-		case 0x3e:	// ROL abs,X
+		OPCODE(0x3e):	// ROL abs,X
 			tmp = read_byte(adr = read_adr_abs_x());
 			tmp2 = tmp & 0x80;
 			write_byte(adr, set_nz(c_flag ? (tmp << 1) | 0x01 : tmp << 1));
 			c_flag = tmp2;
 			ENDOP(7);
 
-		case 0x6a:	// ROR A
+		OPCODE(0x6a):	// ROR A
 			tmp2 = a & 0x01;
 			set_nz(a = (c_flag ? (a >> 1) | 0x80 : a >> 1));
 			c_flag = tmp2;
 			ENDOP(2);
 
-		case 0x66:	// ROR zero
+		OPCODE(0x66):	// ROR zero
 			tmp = read_zp(adr = read_adr_zero());
 			tmp2 = tmp & 0x01;
 			write_zp(adr, set_nz(c_flag ? (tmp >> 1) | 0x80 : tmp >> 1));
 			c_flag = tmp2;
 			ENDOP(5);
 
-		case 0x76:	// ROR zero,X
+		OPCODE(0x76):	// ROR zero,X
 			tmp = read_zp(adr = read_adr_zero_x());
 			tmp2 = tmp & 0x01;
 			write_zp(adr, set_nz(c_flag ? (tmp >> 1) | 0x80 : tmp >> 1));
 			c_flag = tmp2;
 			ENDOP(6);
 
-		case 0x6e:	// ROR abs
+		OPCODE(0x6e):	// ROR abs
 			tmp = read_byte(adr = read_adr_abs());
 			tmp2 = tmp & 0x01;
 			write_byte(adr, set_nz(c_flag ? (tmp >> 1) | 0x80 : tmp >> 1));
 			c_flag = tmp2;
 			ENDOP(6);
 
-		case 0x7e:	// ROR abs,X
+		OPCODE(0x7e):	// ROR abs,X
 			tmp = read_byte(adr = read_adr_abs_x());
 			tmp2 = tmp & 0x01;
 			write_byte(adr, set_nz(c_flag ? (tmp >> 1) | 0x80 : tmp >> 1));
@@ -783,19 +910,19 @@ handle_int:
 
 
 		// Stack group
-		case 0x48:	// PHA
+		OPCODE(0x48):	// PHA
 			push_byte(a);
 			ENDOP(3);
 
-		case 0x68:	// PLA
+		OPCODE(0x68):	// PLA
 			set_nz(a = pop_byte());
 			ENDOP(4);
 
-		case 0x08:	// PHP
+		OPCODE(0x08):	// PHP
 			push_flags(true);
 			ENDOP(3);
 
-		case 0x28:	// PLP
+		OPCODE(0x28):	// PLP
 			pop_flags();
 			if (IRQ_PENDING && !i_flag)
 				//goto handle_int;
@@ -804,31 +931,32 @@ handle_int:
 
 
 		// Jump/branch group
-		case 0x4c:	// JMP abs
+		OPCODE(0x4c):	// JMP abs
 			adr = read_adr_abs();
+			IDLE_LOOP_CHECK(pc - 3, adr);
 			jump(adr);
 			ENDOP(3);
 
-		case 0x6c:	// JMP (ind)
+		OPCODE(0x6c):	// JMP (ind)
 			adr = read_adr_abs();
 			adr = read_byte(adr) | (read_byte(((adr + 1) & 0xff) | (adr & 0xff00)) << 8);
 			jump(adr);
 			ENDOP(5);
 
-		case 0x20:	// JSR abs
+		OPCODE(0x20):	// JSR abs
 			push_byte((pc + 1) >> 8);
 			push_byte(pc + 1);
 			adr = read_adr_abs();
 			jump(adr);
 			ENDOP(6);
 
-		case 0x60:	// RTS
+		OPCODE(0x60):	// RTS
 			adr = pop_byte();	// Split because of pop_byte ++sp side-effect
 			adr = (adr | (pop_byte() << 8)) + 1;
 			jump(adr);
 			ENDOP(6);
 
-		case 0x40:	// RTI
+		OPCODE(0x40):	// RTI
 			pop_flags();
 			adr = pop_byte();	// Split because of pop_byte ++sp side-effect
 			adr = adr | (pop_byte() << 8);
@@ -838,7 +966,7 @@ handle_int:
 				interrupt_delay = 1;
 			ENDOP(6);
 
-		case 0x00:	// BRK
+		OPCODE(0x00):	// BRK
 			push_byte((pc + 1) >> 8);
 			push_byte(pc + 1);
 			push_flags(true);
@@ -850,7 +978,8 @@ handle_int:
 #define Branch(flag) \
 	if (flag) { \
 		uint16_t old_pc = pc; \
-		pc += (int8_t)read_byte(pc) + 1; \
+		pc += (int8_t)peek_operand_lo() + 1; \
+		IDLE_LOOP_CHECK(old_pc - 1, pc); \
 		if ((pc ^ old_pc) & 0xff00) { \
 			ENDOP(4); \
 		} else { \
@@ -861,68 +990,68 @@ handle_int:
 		ENDOP(2); \
 	}
 
-		case 0xb0:	// BCS rel
+		OPCODE(0xb0):	// BCS rel
 			Branch(c_flag);
 
-		case 0x90:	// BCC rel
+		OPCODE(0x90):	// BCC rel
 			Branch(!c_flag);
 
-		case 0xf0:	// BEQ rel
+		OPCODE(0xf0):	// BEQ rel
 			Branch(!z_flag);
 
-		case 0xd0:	// BNE rel
+		OPCODE(0xd0):	// BNE rel
 			Branch(z_flag);
 
-		case 0x70:	// BVS rel
+		OPCODE(0x70):	// BVS rel
 			CHECK_SO;	// Handle SO (GCR byte ready) input on 1541
 			Branch(v_flag);
 
-		case 0x50:	// BVC rel
+		OPCODE(0x50):	// BVC rel
 			CHECK_SO;	// Handle SO (GCR byte ready) input on 1541
 			Branch(!v_flag);
 
-		case 0x30:	// BMI rel
+		OPCODE(0x30):	// BMI rel
 			Branch(n_flag & 0x80);
 
-		case 0x10:	// BPL rel
+		OPCODE(0x10):	// BPL rel
 			Branch(!(n_flag & 0x80));
 
 
 		// Flags group
-		case 0x38:	// SEC
+		OPCODE(0x38):	// SEC
 			c_flag = true;
 			ENDOP(2);
 
-		case 0x18:	// CLC
+		OPCODE(0x18):	// CLC
 			c_flag = false;
 			ENDOP(2);
 
-		case 0xf8:	// SED
+		OPCODE(0xf8):	// SED
 			d_flag = true;
 			ENDOP(2);
 
-		case 0xd8:	// CLD
+		OPCODE(0xd8):	// CLD
 			d_flag = false;
 			ENDOP(2);
 
-		case 0x78:	// SEI
+		OPCODE(0x78):	// SEI
 			i_flag = true;
 			ENDOP(2);
 
-		case 0x58:	// CLI
+		OPCODE(0x58):	// CLI
 			i_flag = false;
 			if (IRQ_PENDING)
 				//goto handle_int;
 				interrupt_delay = 1;
 			ENDOP(2);
 
-		case 0xb8:	// CLV
+		OPCODE(0xb8):	// CLV
 			v_flag = false;
 			ENDOP(2);
 
 
 		// NOP group
-		case 0xea:	// NOP
+		OPCODE(0xea):	// NOP
 			ENDOP(2);
 
 
@@ -931,47 +1060,47 @@ handle_int:
  */
 
 		// NOP group
-		case 0x1a:	// NOP
-		case 0x3a:
-		case 0x5a:
-		case 0x7a:
-		case 0xda:
-		case 0xfa:
+		OPCODE(0x1a):	// NOP
+		OPCODE(0x3a):
+		OPCODE(0x5a):
+		OPCODE(0x7a):
+		OPCODE(0xda):
+		OPCODE(0xfa):
 			ENDOP(2);
 
-		case 0x80:	// NOP #imm
-		case 0x82:
-		case 0x89:
-		case 0xc2:
-		case 0xe2:
+		OPCODE(0x80):	// NOP #imm
+		OPCODE(0x82):
+		OPCODE(0x89):
+		OPCODE(0xc2):
+		OPCODE(0xe2):
 			pc++;
 			ENDOP(2);
 
-		case 0x04:	// NOP zero
-		case 0x44:
-		case 0x64:
+		OPCODE(0x04):	// NOP zero
+		OPCODE(0x44):
+		OPCODE(0x64):
 			pc++;
 			ENDOP(3);
 
-		case 0x14:	// NOP zero,X
-		case 0x34:
-		case 0x54:
-		case 0x74:
-		case 0xd4:
-		case 0xf4:
+		OPCODE(0x14):	// NOP zero,X
+		OPCODE(0x34):
+		OPCODE(0x54):
+		OPCODE(0x74):
+		OPCODE(0xd4):
+		OPCODE(0xf4):
 			pc++;
 			ENDOP(4);
 
-		case 0x0c:	// NOP abs
+		OPCODE(0x0c):	// NOP abs
 			pc+=2;
 			ENDOP(4);
 
-		case 0x1c:	// NOP abs,X
-		case 0x3c:
-		case 0x5c:
-		case 0x7c:
-		case 0xdc:
-		case 0xfc:
+		OPCODE(0x1c):	// NOP abs,X
+		OPCODE(0x3c):
+		OPCODE(0x5c):
+		OPCODE(0x7c):
+		OPCODE(0xdc):
+		OPCODE(0xfc):
 #if PRECISE_CPU_CYCLES
 			read_byte_abs_x();
 #else
@@ -981,45 +1110,45 @@ handle_int:
 
 
 		// Load A/X group
-		case 0xa7:	// LAX zero
+		OPCODE(0xa7):	// LAX zero
 			set_nz(a = x = read_byte_zero());
 			ENDOP(3);
 
-		case 0xb7:	// LAX zero,Y
+		OPCODE(0xb7):	// LAX zero,Y
 			set_nz(a = x = read_byte_zero_y());
 			ENDOP(4);
 
-		case 0xaf:	// LAX abs
+		OPCODE(0xaf):	// LAX abs
 			set_nz(a = x = read_byte_abs());
 			ENDOP(4);
 
-		case 0xbf:	// LAX abs,Y
+		OPCODE(0xbf):	// LAX abs,Y
 			set_nz(a = x = read_byte_abs_y());
 			ENDOP(4);
 
-		case 0xa3:	// LAX (ind,X)
+		OPCODE(0xa3):	// LAX (ind,X)
 			set_nz(a = x = read_byte_ind_x());
 			ENDOP(6);
 
-		case 0xb3:	// LAX (ind),Y
+		OPCODE(0xb3):	// LAX (ind),Y
 			set_nz(a = x = read_byte_ind_y());
 			ENDOP(5);
 
 
 		// Store A/X group
-		case 0x87:	// SAX zero
+		OPCODE(0x87):	// SAX zero
 			write_byte(read_adr_zero(), a & x);
 			ENDOP(3);
 
-		case 0x97:	// SAX zero,Y
+		OPCODE(0x97):	// SAX zero,Y
 			write_byte(read_adr_zero_y(), a & x);
 			ENDOP(4);
 
-		case 0x8f:	// SAX abs
+		OPCODE(0x8f):	// SAX abs
 			write_byte(read_adr_abs(), a & x);
 			ENDOP(4);
 
-		case 0x83:	// SAX (ind,X)
+		OPCODE(0x83):	// SAX (ind,X)
 			write_byte(read_adr_ind_x(), a & x);
 			ENDOP(6);
 
@@ -1030,43 +1159,43 @@ handle_int:
 	tmp <<= 1; \
 	set_nz(a |= tmp);
 
-		case 0x07:	// SLO zero
+		OPCODE(0x07):	// SLO zero
 			tmp = read_zp(adr = read_adr_zero());
 			ShiftLeftOr;
 			write_zp(adr, tmp);
 			ENDOP(5);
 
-		case 0x17:	// SLO zero,X
+		OPCODE(0x17):	// SLO zero,X
 			tmp = read_zp(adr = read_adr_zero_x());
 			ShiftLeftOr;
 			write_zp(adr, tmp);
 			ENDOP(6);
 
-		case 0x0f:	// SLO abs
+		OPCODE(0x0f):	// SLO abs
 			tmp = read_byte(adr = read_adr_abs());
 			ShiftLeftOr;
 			write_byte(adr, tmp);
 			ENDOP(6);
 
-		case 0x1f:	// SLO abs,X
+		OPCODE(0x1f):	// SLO abs,X
 			tmp = read_byte(adr = read_adr_abs_x());
 			ShiftLeftOr;
 			write_byte(adr, tmp);
 			ENDOP(7);
 
-		case 0x1b:	// SLO abs,Y
+		OPCODE(0x1b):	// SLO abs,Y
 			tmp = read_byte(adr = read_adr_abs_y());
 			ShiftLeftOr;
 			write_byte(adr, tmp);
 			ENDOP(7);
 
-		case 0x03:	// SLO (ind,X)
+		OPCODE(0x03):	// SLO (ind,X)
 			tmp = read_byte(adr = read_adr_ind_x());
 			ShiftLeftOr;
 			write_byte(adr, tmp);
 			ENDOP(8);
 
-		case 0x13:	// SLO (ind),Y
+		OPCODE(0x13):	// SLO (ind),Y
 			tmp = read_byte(adr = read_adr_ind_y());
 			ShiftLeftOr;
 			write_byte(adr, tmp);
@@ -1080,43 +1209,43 @@ handle_int:
 	set_nz(a &= tmp); \
 	c_flag = tmp2;
 
-		case 0x27:	// RLA zero
+		OPCODE(0x27):	// RLA zero
 			tmp = read_zp(adr = read_adr_zero());
 			RoLeftAnd;
 			write_zp(adr, tmp);
 			ENDOP(5);
 
-		case 0x37:	// RLA zero,X
+		OPCODE(0x37):	// RLA zero,X
 			tmp = read_zp(adr = read_adr_zero_x());
 			RoLeftAnd;
 			write_zp(adr, tmp);
 			ENDOP(6);
 
-		case 0x2f:	// RLA abs
+		OPCODE(0x2f):	// RLA abs
 			tmp = read_byte(adr = read_adr_abs());
 			RoLeftAnd;
 			write_byte(adr, tmp);
 			ENDOP(6);
 
-		case 0x3f:	// RLA abs,X
+		OPCODE(0x3f):	// RLA abs,X
 			tmp = read_byte(adr = read_adr_abs_x());
 			RoLeftAnd;
 			write_byte(adr, tmp);
 			ENDOP(7);
 
-		case 0x3b:	// RLA abs,Y
+		OPCODE(0x3b):	// RLA abs,Y
 			tmp = read_byte(adr = read_adr_abs_y());
 			RoLeftAnd;
 			write_byte(adr, tmp);
 			ENDOP(7);
 
-		case 0x23:	// RLA (ind,X)
+		OPCODE(0x23):	// RLA (ind,X)
 			tmp = read_byte(adr = read_adr_ind_x());
 			RoLeftAnd;
 			write_byte(adr, tmp);
 			ENDOP(8);
 
-		case 0x33:	// RLA (ind),Y
+		OPCODE(0x33):	// RLA (ind),Y
 			tmp = read_byte(adr = read_adr_ind_y());
 			RoLeftAnd;
 			write_byte(adr, tmp);
@@ -1129,43 +1258,43 @@ handle_int:
 	tmp >>= 1; \
 	set_nz(a ^= tmp);
 
-		case 0x47:	// SRE zero
+		OPCODE(0x47):	// SRE zero
 			tmp = read_zp(adr = read_adr_zero());
 			ShiftRightEor;
 			write_zp(adr, tmp);
 			ENDOP(5);
 
-		case 0x57:	// SRE zero,X
+		OPCODE(0x57):	// SRE zero,X
 			tmp = read_zp(adr = read_adr_zero_x());
 			ShiftRightEor;
 			write_zp(adr, tmp);
 			ENDOP(6);
 
-		case 0x4f:	// SRE abs
+		OPCODE(0x4f):	// SRE abs
 			tmp = read_byte(adr = read_adr_abs());
 			ShiftRightEor;
 			write_byte(adr, tmp);
 			ENDOP(6);
 
-		case 0x5f:	// SRE abs,X
+		OPCODE(0x5f):	// SRE abs,X
 			tmp = read_byte(adr = read_adr_abs_x());
 			ShiftRightEor;
 			write_byte(adr, tmp);
 			ENDOP(7);
 
-		case 0x5b:	// SRE abs,Y
+		OPCODE(0x5b):	// SRE abs,Y
 			tmp = read_byte(adr = read_adr_abs_y());
 			ShiftRightEor;
 			write_byte(adr, tmp);
 			ENDOP(7);
 
-		case 0x43:	// SRE (ind,X)
+		OPCODE(0x43):	// SRE (ind,X)
 			tmp = read_byte(adr = read_adr_ind_x());
 			ShiftRightEor;
 			write_byte(adr, tmp);
 			ENDOP(8);
 
-		case 0x53:	// SRE (ind),Y
+		OPCODE(0x53):	// SRE (ind),Y
 			tmp = read_byte(adr = read_adr_ind_y());
 			ShiftRightEor;
 			write_byte(adr, tmp);
@@ -1179,43 +1308,43 @@ handle_int:
 	c_flag = tmp2; \
 	do_adc(tmp);
 
-		case 0x67:	// RRA zero
+		OPCODE(0x67):	// RRA zero
 			tmp = read_zp(adr = read_adr_zero());
 			RoRightAdc;
 			write_zp(adr, tmp);
 			ENDOP(5);
 
-		case 0x77:	// RRA zero,X
+		OPCODE(0x77):	// RRA zero,X
 			tmp = read_zp(adr = read_adr_zero_x());
 			RoRightAdc;
 			write_zp(adr, tmp);
 			ENDOP(6);
 
-		case 0x6f:	// RRA abs
+		OPCODE(0x6f):	// RRA abs
 			tmp = read_byte(adr = read_adr_abs());
 			RoRightAdc;
 			write_byte(adr, tmp);
 			ENDOP(6);
 
-		case 0x7f:	// RRA abs,X
+		OPCODE(0x7f):	// RRA abs,X
 			tmp = read_byte(adr = read_adr_abs_x());
 			RoRightAdc;
 			write_byte(adr, tmp);
 			ENDOP(7);
 
-		case 0x7b:	// RRA abs,Y
+		OPCODE(0x7b):	// RRA abs,Y
 			tmp = read_byte(adr = read_adr_abs_y());
 			RoRightAdc;
 			write_byte(adr, tmp);
 			ENDOP(7);
 
-		case 0x63:	// RRA (ind,X)
+		OPCODE(0x63):	// RRA (ind,X)
 			tmp = read_byte(adr = read_adr_ind_x());
 			RoRightAdc;
 			write_byte(adr, tmp);
 			ENDOP(8);
 
-		case 0x73:	// RRA (ind),Y
+		OPCODE(0x73):	// RRA (ind),Y
 			tmp = read_byte(adr = read_adr_ind_y());
 			RoRightAdc;
 			write_byte(adr, tmp);
@@ -1227,43 +1356,43 @@ handle_int:
 	set_nz(adr = a - tmp); \
 	c_flag = adr < 0x100;
 
-		case 0xc7:	// DCP zero
+		OPCODE(0xc7):	// DCP zero
 			tmp = read_zp(adr = read_adr_zero()) - 1;
 			write_zp(adr, tmp);
 			DecCompare;
 			ENDOP(5);
 
-		case 0xd7:	// DCP zero,X
+		OPCODE(0xd7):	// DCP zero,X
 			tmp = read_zp(adr = read_adr_zero_x()) - 1;
 			write_zp(adr, tmp);
 			DecCompare;
 			ENDOP(6);
 
-		case 0xcf:	// DCP abs
+		OPCODE(0xcf):	// DCP abs
 			tmp = read_byte(adr = read_adr_abs()) - 1;
 			write_byte(adr, tmp);
 			DecCompare;
 			ENDOP(6);
 
-		case 0xdf:	// DCP abs,X
+		OPCODE(0xdf):	// DCP abs,X
 			tmp = read_byte(adr = read_adr_abs_x()) - 1;
 			write_byte(adr, tmp);
 			DecCompare;
 			ENDOP(7);
 
-		case 0xdb:	// DCP abs,Y
+		OPCODE(0xdb):	// DCP abs,Y
 			tmp = read_byte(adr = read_adr_abs_y()) - 1;
 			write_byte(adr, tmp);
 			DecCompare;
 			ENDOP(7);
 
-		case 0xc3:	// DCP (ind,X)
+		OPCODE(0xc3):	// DCP (ind,X)
 			tmp = read_byte(adr = read_adr_ind_x()) - 1;
 			write_byte(adr, tmp);
 			DecCompare;
 			ENDOP(8);
 
-		case 0xd3:	// DCP (ind),Y
+		OPCODE(0xd3):	// DCP (ind),Y
 			tmp = read_byte(adr = read_adr_ind_y()) - 1;
 			write_byte(adr, tmp);
 			DecCompare;
@@ -1271,43 +1400,43 @@ handle_int:
 
 
 		// INC/SBC group
-		case 0xe7:	// ISB zero
+		OPCODE(0xe7):	// ISB zero
 			tmp = read_zp(adr = read_adr_zero()) + 1;
 			do_sbc(tmp);
 			write_zp(adr, tmp);
 			ENDOP(5);
 
-		case 0xf7:	// ISB zero,X
+		OPCODE(0xf7):	// ISB zero,X
 			tmp = read_zp(adr = read_adr_zero_x()) + 1;
 			do_sbc(tmp);
 			write_zp(adr, tmp);
 			ENDOP(6);
 
-		case 0xef:	// ISB abs
+		OPCODE(0xef):	// ISB abs
 			tmp = read_byte(adr = read_adr_abs()) + 1;
 			do_sbc(tmp);
 			write_byte(adr, tmp);
 			ENDOP(6);
 
-		case 0xff:	// ISB abs,X
+		OPCODE(0xff):	// ISB abs,X
 			tmp = read_byte(adr = read_adr_abs_x()) + 1;
 			do_sbc(tmp);
 			write_byte(adr, tmp);
 			ENDOP(7);
 
-		case 0xfb:	// ISB abs,Y
+		OPCODE(0xfb):	// ISB abs,Y
 			tmp = read_byte(adr = read_adr_abs_y()) + 1;
 			do_sbc(tmp);
 			write_byte(adr, tmp);
 			ENDOP(7);
 
-		case 0xe3:	// ISB (ind,X)
+		OPCODE(0xe3):	// ISB (ind,X)
 			tmp = read_byte(adr = read_adr_ind_x()) + 1;
 			do_sbc(tmp);
 			write_byte(adr, tmp);
 			ENDOP(8);
 
-		case 0xf3:	// ISB (ind),Y
+		OPCODE(0xf3):	// ISB (ind),Y
 			tmp = read_byte(adr = read_adr_ind_y()) + 1;
 			do_sbc(tmp);
 			write_byte(adr, tmp);
@@ -1315,19 +1444,19 @@ handle_int:
 
 
 		// Complex functions
-		case 0x0b:	// ANC #imm
-		case 0x2b:
+		OPCODE(0x0b):	// ANC #imm
+		OPCODE(0x2b):
 			set_nz(a &= read_byte_imm());
 			c_flag = n_flag & 0x80;
 			ENDOP(2);
 
-		case 0x4b:	// ASR #imm
+		OPCODE(0x4b):	// ASR #imm
 			a &= read_byte_imm();
 			c_flag = a & 0x01;
 			set_nz(a >>= 1);
 			ENDOP(2);
 
-		case 0x6b:	// ARR #imm
+		OPCODE(0x6b):	// ARR #imm
 			tmp2 = read_byte_imm() & a;
 			a = (c_flag ? (tmp2 >> 1) | 0x80 : tmp2 >> 1);
 			if (!d_flag) {
@@ -1347,12 +1476,12 @@ handle_int:
 			}
 			ENDOP(2);
 
-		case 0x8b:	// ANE #imm
+		OPCODE(0x8b):	// ANE #imm
 			set_nz(a = read_byte_imm() & x & (a | 0xee));
 			ENDOP(2);
 
-		case 0x93:	// SHA (ind),Y
-			tmp2 = read_zp(read_byte(pc) + 1);
+		OPCODE(0x93):	// SHA (ind),Y
+			tmp2 = read_zp(peek_operand_lo() + 1);
 			adr = read_adr_ind_y();
  			if ((adr & 0xff) < y) {	// Page crossed?
 				adr &= ((a & x) << 8) | 0xff;
@@ -1360,8 +1489,8 @@ handle_int:
 			write_byte(adr, a & x & (tmp2 + 1));
 			ENDOP(6);
 
-		case 0x9b:	// SHS abs,Y
-			tmp2 = read_byte(pc + 1);
+		OPCODE(0x9b):	// SHS abs,Y
+			tmp2 = peek_operand_hi();
 			adr = read_adr_abs_y();
  			if ((adr & 0xff) < y) {	// Page crossed?
 				adr &= ((a & x) << 8) | 0xff;
@@ -1370,8 +1499,8 @@ handle_int:
 			sp = a & x;
 			ENDOP(5);
 
-		case 0x9c:	// SHY abs,X
-			tmp2 = read_byte(pc + 1);
+		OPCODE(0x9c):	// SHY abs,X
+			tmp2 = peek_operand_hi();
 			adr = read_adr_abs_x();
  			if ((adr & 0xff) < x) {	// Page crossed?
 				adr &= (y << 8) | 0xff;
@@ -1379,8 +1508,8 @@ handle_int:
 			write_byte(adr, y & (tmp2 + 1));
 			ENDOP(5);
 
-		case 0x9e:	// SHX abs,Y
-			tmp2 = read_byte(pc + 1);
+		OPCODE(0x9e):	// SHX abs,Y
+			tmp2 = peek_operand_hi();
 			adr = read_adr_abs_y();
  			if ((adr & 0xff) < y) {	// Page crossed?
 				adr &= (x << 8) | 0xff;
@@ -1388,8 +1517,8 @@ handle_int:
 			write_byte(adr, x & (tmp2 + 1));
 			ENDOP(5);
 
-		case 0x9f:	// SHA abs,Y
-			tmp2 = read_byte(pc + 1);
+		OPCODE(0x9f):	// SHA abs,Y
+			tmp2 = peek_operand_hi();
 			adr = read_adr_abs_y();
  			if ((adr & 0xff) < y) {	// Page crossed?
 				adr &= ((a & x) << 8) | 0xff;
@@ -1397,31 +1526,31 @@ handle_int:
 			write_byte(adr, a & x & (tmp2+1));
 			ENDOP(5);
 
-		case 0xab:	// LXA #imm
+		OPCODE(0xab):	// LXA #imm
 			set_nz(a = x = (a | 0xee) & read_byte_imm());
 			ENDOP(2);
 
-		case 0xbb:	// LAS abs,Y
+		OPCODE(0xbb):	// LAS abs,Y
 			set_nz(a = x = sp = read_byte_abs_y() & sp);
 			ENDOP(4);
 
-		case 0xcb:	// SBX #imm
+		OPCODE(0xcb):	// SBX #imm
 			x &= a;
 			adr = x - read_byte_imm();
 			c_flag = adr < 0x100;
 			set_nz(x = adr);
 			ENDOP(2);
 
-		case 0x02:
-		case 0x12:
-		case 0x22:
-		case 0x32:
-		case 0x42:
-		case 0x52:
-		case 0x62:
-		case 0x72:
-		case 0x92:
-		case 0xb2:
-		case 0xd2:
+		OPCODE(0x02):
+		OPCODE(0x12):
+		OPCODE(0x22):
+		OPCODE(0x32):
+		OPCODE(0x42):
+		OPCODE(0x52):
+		OPCODE(0x62):
+		OPCODE(0x72):
+		OPCODE(0x92):
+		OPCODE(0xb2):
+		OPCODE(0xd2):
 			illegal_op(pc - 1);
 			ENDOP(2);
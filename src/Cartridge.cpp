@@ -126,6 +126,12 @@ uint8_t Cartridge8K::ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram)
 	return notLoram ? rom[adr] : ram_byte;
 }
 
+CartMap Cartridge8K::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	block = rom;
+	return notLoram ? CartMap::ROM : CartMap::RAM;
+}
+
 
 // 16K ROM cartridge (EXROM = 0, GAME = 0)
 Cartridge16K::Cartridge16K() : ROMCartridge(1, 0x4000)
@@ -144,6 +150,18 @@ uint8_t Cartridge16K::ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t basic_byt
 	return notHiram ? rom[adr + 0x2000] : ram_byte;
 }
 
+CartMap Cartridge16K::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	block = rom;
+	return notLoram ? CartMap::ROM : CartMap::RAM;
+}
+
+CartMap Cartridge16K::MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const
+{
+	block = rom + 0x2000;
+	return notHiram ? CartMap::ROM : CartMap::RAM;
+}
+
 
 // Simons' BASIC cartridge (switchable 8K/16K ROM cartridge)
 CartridgeSimonsBasic::CartridgeSimonsBasic() : ROMCartridge(1, 0x4000)
@@ -167,6 +185,18 @@ uint8_t CartridgeSimonsBasic::ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t b
 	return notHiram ? rom[adr + 0x2000] : ram_byte;
 }
 
+CartMap CartridgeSimonsBasic::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	block = rom;
+	return notLoram ? CartMap::ROM : CartMap::RAM;
+}
+
+CartMap CartridgeSimonsBasic::MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const
+{
+	block = rom + 0x2000;
+	return notHiram ? CartMap::ROM : CartMap::RAM;
+}
+
 uint8_t CartridgeSimonsBasic::ReadIO1(uint16_t adr, uint8_t bus_byte)
 {
 	notGAME = true;		// 8K mode
@@ -201,6 +231,18 @@ uint8_t CartridgeOcean::ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t basic_b
 	return notHiram ? rom[adr + bank * bankSize] : ram_byte;
 }
 
+CartMap CartridgeOcean::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	block = rom + bank * bankSize;
+	return notLoram ? CartMap::ROM : CartMap::RAM;
+}
+
+CartMap CartridgeOcean::MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const
+{
+	block = rom + bank * bankSize;
+	return notHiram ? CartMap::ROM : CartMap::RAM;
+}
+
 void CartridgeOcean::WriteIO1(uint16_t adr, uint8_t byte)
 {
 	bank = byte & 0x3f;
@@ -225,6 +267,12 @@ uint8_t CartridgeFunPlay::ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram
 	return notLoram ? rom[adr + bank * bankSize] : ram_byte;
 }
 
+CartMap CartridgeFunPlay::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	block = rom + bank * bankSize;
+	return notLoram ? CartMap::ROM : CartMap::RAM;
+}
+
 void CartridgeFunPlay::WriteIO1(uint16_t adr, uint8_t byte)
 {
 	bank = byte & 0x39;
@@ -258,6 +306,18 @@ uint8_t CartridgeSuperGames::ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t ba
 	return notHiram ? rom[adr + bank * bankSize + 0x2000] : ram_byte;
 }
 
+CartMap CartridgeSuperGames::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	block = rom + bank * bankSize;
+	return notLoram ? CartMap::ROM : CartMap::RAM;
+}
+
+CartMap CartridgeSuperGames::MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const
+{
+	block = rom + bank * bankSize + 0x2000;
+	return notHiram ? CartMap::ROM : CartMap::RAM;
+}
+
 void CartridgeSuperGames::WriteIO2(uint16_t adr, uint8_t byte)
 {
 	if (! disableIO2) {
@@ -284,6 +344,12 @@ uint8_t CartridgeC64GS::ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram)
 	return notLoram ? rom[adr + bank * bankSize] : ram_byte;
 }
 
+CartMap CartridgeC64GS::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	block = rom + bank * bankSize;
+	return notLoram ? CartMap::ROM : CartMap::RAM;
+}
+
 uint8_t CartridgeC64GS::ReadIO1(uint16_t adr, uint8_t bus_byte)
 {
 	bank = adr & 0x3f;
@@ -312,6 +378,12 @@ uint8_t CartridgeDinamic::ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram
 	return notLoram ? rom[adr + bank * bankSize] : ram_byte;
 }
 
+CartMap CartridgeDinamic::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	block = rom + bank * bankSize;
+	return notLoram ? CartMap::ROM : CartMap::RAM;
+}
+
 uint8_t CartridgeDinamic::ReadIO1(uint16_t adr, uint8_t bus_byte)
 {
 	bank = adr & 0x0f;
@@ -351,6 +423,17 @@ uint8_t CartridgeZaxxon::ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t basic_
 	return notHiram ? rom[adr + bank * bankSize + 0x2000] : ram_byte;
 }
 
+// ROML reads switch the ROMH bank
+CartMap CartridgeZaxxon::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	return notLoram ? CartMap::Dynamic : CartMap::RAM;
+}
+
+CartMap CartridgeZaxxon::MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const
+{
+	return notHiram ? CartMap::Dynamic : CartMap::RAM;
+}
+
 
 // Magic Desk / Marina64 cartridge (banked 8K ROM cartridge)
 CartridgeMagicDesk::CartridgeMagicDesk() : ROMCartridge(128, 0x2000)
@@ -370,6 +453,12 @@ uint8_t CartridgeMagicDesk::ReadROML(uint16_t adr, uint8_t ram_byte, bool notLor
 	return notLoram ? rom[adr + bank * bankSize] : ram_byte;
 }
 
+CartMap CartridgeMagicDesk::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	block = rom + bank * bankSize;
+	return notLoram ? CartMap::ROM : CartMap::RAM;
+}
+
 void CartridgeMagicDesk::WriteIO1(uint16_t adr, uint8_t byte)
 {
 	bank = byte & 0x7f;
@@ -399,6 +488,18 @@ uint8_t CartridgeComal80::ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t basic
 	return notHiram ? rom[adr + bank * bankSize + 0x2000] : ram_byte;
 }
 
+CartMap CartridgeComal80::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	block = rom + bank * bankSize;
+	return notLoram ? CartMap::ROM : CartMap::RAM;
+}
+
+CartMap CartridgeComal80::MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const
+{
+	block = rom + bank * bankSize + 0x2000;
+	return notHiram ? CartMap::ROM : CartMap::RAM;
+}
+
 void CartridgeComal80::WriteIO1(uint16_t adr, uint8_t byte)
 {
 	bank = byte & 0x03;
@@ -567,6 +668,28 @@ uint8_t CartridgeEasyFlash::ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t bas
 	return notLoram ? basic_byte : ram_byte;
 }
 
+CartMap CartridgeEasyFlash::MapROML(bool notLoram, const uint8_t *& block) const
+{
+	block = roml + bank * BANK_SIZE;
+	if (!notEXROM) {
+		return notLoram ? CartMap::ROM : CartMap::RAM;
+	} else if (!notGAME) {
+		return CartMap::ROM;
+	}
+	return CartMap::RAM;
+}
+
+CartMap CartridgeEasyFlash::MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const
+{
+	block = romh + bank * BANK_SIZE;
+	if (!notGAME && !notEXROM) {
+		return notHiram ? CartMap::ROM : CartMap::RAM;
+	} else if (!notGAME && notEXROM) {
+		return CartMap::ROM;
+	}
+	return notLoram ? CartMap::SysROM : CartMap::RAM;
+}
+
 uint8_t CartridgeEasyFlash::ReadIO1(uint16_t adr, uint8_t bus_byte)
 {
 	// Per official docs: $DE00 and $DE02 are write-only registers
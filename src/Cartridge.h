@@ -26,6 +26,16 @@
 #include <string>
 
 
+// How ReadROML()/ReadROMH() resolve in the current cartridge state, so the
+// CPU can map the ROM areas directly instead of calling them on every read
+enum class CartMap : uint8_t {
+	RAM,		// Returns ram_byte
+	SysROM,		// Returns basic_byte (Kernal byte in Ultimax mode)
+	ROM,		// Returns the 8K block passed back in 'block'
+	Dynamic		// Reads have side effects, call ReadROMx() every time
+};
+
+
 // Base class for cartridges
 class Cartridge {
 public:
@@ -48,6 +58,19 @@ public:
 		return notLoram ? basic_byte : ram_byte;
 	}
 
+	// Describe what ReadROML()/ReadROMH() return, must be kept in sync with
+	// them. The CPU re-queries these after every I/O 1/2 access and $ff00
+	// write, which is where banking and /EXROM//GAME changes happen.
+	virtual CartMap MapROML(bool notLoram, const uint8_t *& block) const
+	{
+		return CartMap::RAM;
+	}
+
+	virtual CartMap MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const
+	{
+		return notLoram ? CartMap::SysROM : CartMap::RAM;
+	}
+
 	// Default for I/O 1 and 2 is open bus
 	virtual uint8_t ReadIO1(uint16_t adr, uint8_t bus_byte) { return bus_byte; }
 	virtual void WriteIO1(uint16_t adr, uint8_t byte) { }
@@ -100,6 +123,7 @@ public:
 	Cartridge8K();
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
 };
 
 
@@ -110,6 +134,8 @@ public:
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
 	uint8_t ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t basic_byte, bool notLoram, bool notHiram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
+	CartMap MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const override;
 };
 
 
@@ -122,6 +148,8 @@ public:
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
 	uint8_t ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t basic_byte, bool notLoram, bool notHiram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
+	CartMap MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const override;
 
 	uint8_t ReadIO1(uint16_t adr, uint8_t bus_byte) override;
 	void WriteIO1(uint16_t adr, uint8_t byte) override;
@@ -140,6 +168,8 @@ public:
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
 	uint8_t ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t basic_byte, bool notLoram, bool notHiram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
+	CartMap MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const override;
 
 	void WriteIO1(uint16_t adr, uint8_t byte) override;
 
@@ -156,6 +186,7 @@ public:
 	void Reset() override;
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
 
 	void WriteIO1(uint16_t adr, uint8_t byte) override;
 
@@ -173,6 +204,8 @@ public:
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
 	uint8_t ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t basic_byte, bool notLoram, bool notHiram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
+	CartMap MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const override;
 
 	void WriteIO2(uint16_t adr, uint8_t byte) override;
 
@@ -190,6 +223,7 @@ public:
 	void Reset() override;
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
 
 	uint8_t ReadIO1(uint16_t adr, uint8_t bus_byte) override;
 	void WriteIO1(uint16_t adr, uint8_t byte) override;
@@ -207,6 +241,7 @@ public:
 	void Reset() override;
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
 
 	uint8_t ReadIO1(uint16_t adr, uint8_t bus_byte) override;
 
@@ -224,6 +259,8 @@ public:
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
 	uint8_t ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t basic_byte, bool notLoram, bool notHiram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
+	CartMap MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const override;
 
 protected:
 	unsigned bank = 0;	// Selected ROMH bank
@@ -238,6 +275,7 @@ public:
 	void Reset() override;
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
 
 	void WriteIO1(uint16_t adr, uint8_t byte) override;
 
@@ -255,6 +293,8 @@ public:
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
 	uint8_t ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t basic_byte, bool notLoram, bool notHiram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
+	CartMap MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const override;
 
 	void WriteIO1(uint16_t adr, uint8_t byte) override;
 
@@ -273,6 +313,8 @@ public:
 
 	uint8_t ReadROML(uint16_t adr, uint8_t ram_byte, bool notLoram) override;
 	uint8_t ReadROMH(uint16_t adr, uint8_t ram_byte, uint8_t basic_byte, bool notLoram, bool notHiram) override;
+	CartMap MapROML(bool notLoram, const uint8_t *& block) const override;
+	CartMap MapROMH(bool notLoram, bool notHiram, const uint8_t *& block) const override;
 
 	uint8_t ReadIO1(uint16_t adr, uint8_t bus_byte) override;
 	void WriteIO1(uint16_t adr, uint8_t byte) override;
@@ -50,6 +50,11 @@ Prefs::Prefs()
 	TestMaxFrames = 0;
 
 	SIDType = SIDTYPE_DIGITAL_6581;
+	SID2Address = 0;
+	SID3Address = 0;
+	SIDPan[0] = -12;
+	SIDPan[1] = 12;
+	SIDPan[2] = 0;
 	REUType = REU_NONE;
 	DisplayType = DISPTYPE_WINDOW;
 	Palette = PALETTE_PEPTO;
@@ -65,6 +70,9 @@ Prefs::Prefs()
 	CIAIRQHack = false;
 	MapSlash = true;
 	Emul1541Proc = true;
+	SkipIdleLoops = true;
+	SIDBlockRender = true;
+	SIDBandLimit = false;
 	ShowLEDs = true;
 	AutoStart = false;
 	TestBench = false;
@@ -75,6 +83,15 @@ Prefs::Prefs()
  *  Check preferences for validity and correct if necessary
  */
 
+// Extra SIDs sit at a 32-byte boundary in $d420..$d7e0 or $de00..$dfe0
+static bool valid_sid_address(int adr)
+{
+	if (adr == 0) {
+		return true;
+	}
+	return (adr & 0x1f) == 0 && ((adr > 0xd400 && adr < 0xd800) || (adr >= 0xde00 && adr < 0xe000));
+}
+
 void Prefs::Check()
 {
 	if (ScalingNumerator <= 0) {
@@ -93,6 +110,20 @@ void Prefs::Check()
 		SIDType = SIDTYPE_NONE;
 	}
 
+	if (!valid_sid_address(SID2Address)) {
+		SID2Address = 0;
+	}
+
+	if (!valid_sid_address(SID3Address) || SID3Address == SID2Address) {
+		SID3Address = 0;
+	}
+
+	for (int & pan : SIDPan) {
+		if (pan < -16 || pan > 16) {
+			pan = 0;
+		}
+	}
+
 	if (REUType < REU_NONE || REUType > REU_GEORAM) {
 		REUType = REU_NONE;
 	}
@@ -258,6 +289,16 @@ void Prefs::ParseItem(std::string item)
 		} else {
 			SIDType = SIDTYPE_NONE;
 		}
+	} else if (keyword == "SID2Address") {
+		SID2Address = strtol(value.c_str(), nullptr, 0);
+	} else if (keyword == "SID3Address") {
+		SID3Address = strtol(value.c_str(), nullptr, 0);
+	} else if (keyword == "SID1Pan") {
+		SIDPan[0] = atoi(value.c_str());
+	} else if (keyword == "SID2Pan") {
+		SIDPan[1] = atoi(value.c_str());
+	} else if (keyword == "SID3Pan") {
+		SIDPan[2] = atoi(value.c_str());
 	} else if (keyword == "REUType") {
 		if (value == "128K") {
 			REUType = REU_128K;
@@ -303,6 +344,12 @@ void Prefs::ParseItem(std::string item)
 		MapSlash = (value == "true");
 	} else if (keyword == "Emul1541Proc") {
 		Emul1541Proc = (value == "true");
+	} else if (keyword == "SkipIdleLoops") {
+		SkipIdleLoops = (value == "true");
+	} else if (keyword == "SIDBlockRender") {
+		SIDBlockRender = (value == "true");
+	} else if (keyword == "SIDBandLimit") {
+		SIDBandLimit = (value == "true");
 	} else if (keyword == "ShowLEDs") {
 		ShowLEDs = (value == "true");
 	} else if (keyword == "AutoStart") {
@@ -357,6 +404,11 @@ bool Prefs::Save(fs::path prefs_path)
 		case SIDTYPE_DIGITAL_8580: file << "8580\n"; break;
 		case SIDTYPE_SIDCARD:      file << "SIDCARD\n"; break;
 	}
+	file << "SID2Address = " << SID2Address << std::endl;
+	file << "SID3Address = " << SID3Address << std::endl;
+	file << "SID1Pan = " << SIDPan[0] << std::endl;
+	file << "SID2Pan = " << SIDPan[1] << std::endl;
+	file << "SID3Pan = " << SIDPan[2] << std::endl;
 	file << "REUType = ";
 	switch (REUType) {
 		case REU_NONE:   file << "NONE\n"; break;
@@ -398,6 +450,9 @@ bool Prefs::Save(fs::path prefs_path)
 	file << "CIAIRQHack = " << CIAIRQHack << std::endl;
 	file << "MapSlash = " << MapSlash << std::endl;
 	file << "Emul1541Proc = " << Emul1541Proc << std::endl;
+	file << "SkipIdleLoops = " << SkipIdleLoops << std::endl;
+	file << "SIDBlockRender = " << SIDBlockRender << std::endl;
+	file << "SIDBandLimit = " << SIDBandLimit << std::endl;
 	file << "ShowLEDs = " << ShowLEDs << std::endl;
 
 	return true;
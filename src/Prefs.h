@@ -100,6 +100,9 @@ public:
 	std::string TapePath;		// Path for drive 1
 
 	int SIDType;				// SID emulation type
+	int SID2Address;			// Address of a second SID ($d420..$d7e0, $de00..$dfe0; 0 = none)
+	int SID3Address;			// Address of a third SID (0 = none)
+	int SIDPan[3];				// Stereo position of each SID, -16 (left) .. 16 (right)
 	int REUType;				// Type of RAM expansion
 	int DisplayType;			// Display type (windowed or full-screen)
 	int Palette;				// Color palette to use
@@ -118,6 +121,9 @@ public:
 	bool CIAIRQHack;			// Write to CIA ICR clears IRQ
 	bool MapSlash;				// Map '/' in C64 filenames
 	bool Emul1541Proc;			// Enable processor-level 1541 emulation
+	bool SkipIdleLoops;			// Fast-forward 6510 idle loops to the end of the line
+	bool SIDBlockRender;		// Render SID samples in per-voice blocks
+	bool SIDBandLimit;			// Band-limited saw, pulse and triangle waveforms
 	bool ShowLEDs;				// Show status bar
 	bool AutoStart;				// Auto-start from drive 8 after reset (not saved to preferences file)
 	bool TestBench;				// Enable features for automatic regression tests (not saved to preferences file)
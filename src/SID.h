@@ -24,6 +24,25 @@
 #include <stdlib.h>
 
 
+// Size of the register write queue to a renderer on the second core
+// (0 = audio is rendered inline by EmulateLine())
+#ifndef SID_WRITE_QUEUE
+#define SID_WRITE_QUEUE 0
+#endif
+
+// Log all register writes to a file on the SD card (sid_capture.h)
+#ifndef SID_CAPTURE
+#define SID_CAPTURE 0
+#endif
+
+#if SID_CAPTURE
+#include "sid_capture.h"
+#endif
+
+// Number of SIDs one renderer can mix (the SID at $d400 plus extra SIDs
+// at the addresses in Prefs::SID2Address/SID3Address)
+constexpr unsigned SID_MAX_CHIPS = 3;
+
 class SIDRenderer;
 class Prefs;
 struct MOS6581State;
@@ -36,21 +55,38 @@ public:
 
 	void Reset();
 	uint8_t ReadRegister(uint16_t adr);
-	void WriteRegister(uint16_t adr, uint8_t byte);
+	void WriteRegister(uint16_t adr, uint8_t byte, unsigned line_cycle = 0);
 	void NewPrefs(const Prefs * prefs);
 	void PauseSound();
 	void ResumeSound();
 	void GetState(MOS6581State * s) const;
 	void SetState(const MOS6581State * s);
 	void EmulateLine();
+	void RenderQueued();		// Render queued register writes (on the audio core)
+	void WaitRendered();		// Wait until all queued writes are rendered
+
+	// Extra SIDs (index 0 = SID2, 1 = SID3), nullptr if not fitted
+	MOS6581 * ExtraSID(unsigned i) const { return extra_sid[i]; }
+	uint16_t ExtraSIDAddress(unsigned i) const { return extra_adr[i]; }
 
 	static const int16_t EGDivTable[16];	// Clock divisors for A/D/R settings
 	static const uint8_t EGDRShift[256];	// For exponential approximation of D/R
 
+#ifdef FRODO_RP2350
+	// Combined waveforms of the active SID type, expanded into SRAM from
+	// run-length coded tables; entry n stands for n * 0x101
+	const uint8_t * TriSawTable = nullptr;
+	const uint8_t * TriRectTable = nullptr;
+	const uint8_t * SawRectTable = nullptr;
+	const uint8_t * TriSawRectTable = nullptr;
+
+	static uint32_t WaveTablesTime;		// Time of the last expansion in microseconds
+#else
 	const uint16_t * TriSawTable = nullptr;
 	const uint16_t * TriRectTable = nullptr;
 	const uint16_t * SawRectTable = nullptr;
 	const uint16_t * TriSawRectTable = nullptr;
+#endif
 
 	static const uint16_t TriSawTable_6581[0x1000];
 	static const uint16_t TriRectTable_6581[0x1000];
@@ -63,8 +99,12 @@ public:
 	static const uint16_t TriSawRectTable_8580[0x1000];
 
 private:
+	MOS6581(MOS6581 * primary, unsigned chip);
+
 	void open_close_renderer(int old_type, int new_type);
 	void set_wave_tables(int sid_type);
+	void set_extra_sids(const Prefs * prefs);
+	void write_renderer_regs();
 
 	uint8_t v3_random();
 	void update_osc3();
@@ -73,6 +113,14 @@ private:
 
 	SIDRenderer *the_renderer;	// Pointer to current renderer
 
+	// An extra SID has no renderer of its own, its writes go to the
+	// renderer of the primary SID as chip number chip_base >> 5
+	MOS6581 * render_sid = this;	// SID owning the renderer
+	uint8_t chip_base = 0;			// Chip number << 5
+
+	MOS6581 * extra_sid[SID_MAX_CHIPS - 1] = {};	// Extra SIDs of the primary SID
+	uint16_t extra_adr[SID_MAX_CHIPS - 1] = {};		// Their base addresses
+
 	uint8_t regs[32];			// Copies of the 25 write-only SID registers
 
 	unsigned last_sid_seq;		// SID data bus leakage sequence step (counts down to 0)
@@ -91,7 +139,9 @@ private:
 };
 
 
-// Renderers do the actual audio data processing
+// Renderers do the actual audio data processing. Register numbers passed
+// to a renderer carry the chip number (0 = SID at $d400, 1/2 = extra SIDs)
+// in bits 5..6.
 class SIDRenderer {
 public:
 	virtual ~SIDRenderer() {}
@@ -101,6 +151,14 @@ public:
 	virtual void NewPrefs(const Prefs * prefs) = 0;
 	virtual void Pause() = 0;
 	virtual void Resume() = 0;
+
+	// Write with the cycle within the raster line, for renderers that
+	// place register changes between the samples of a line
+	virtual void WriteRegisterAt(uint16_t adr, uint8_t byte, unsigned line_cycle) { WriteRegister(adr, byte); }
+
+	// Renderers running on another core
+	virtual void RenderQueued() {}
+	virtual void WaitRendered() {}
 };
 
 
@@ -176,6 +234,12 @@ inline void MOS6581::EmulateLine()
 	// from the OSC3 and ENV3 read-back registers, we run another "fake"
 	// emulation of the voice 3 oscillator and EG once per line.
 
+#if SID_CAPTURE
+	if (chip_base == 0) {
+		sid_capture_line();
+	}
+#endif
+
 	// Simulate voice 3 envelope generator
 	switch (fake_v3_eg_state) {
 		case EG_ATTACK:
@@ -217,6 +281,13 @@ inline void MOS6581::EmulateLine()
 	if (the_renderer != nullptr) {
 		the_renderer->EmulateLine();
 	}
+
+	// Read-back emulation of the extra SIDs
+	for (MOS6581 * sid : extra_sid) {
+		if (sid != nullptr) {
+			sid->EmulateLine();
+		}
+	}
 }
 
 
@@ -251,10 +322,11 @@ inline uint8_t MOS6581::ReadRegister(uint16_t adr)
 
 
 /*
- *  Write to register
+ *  Write to register, line_cycle is the cycle within the current raster
+ *  line (the renderer applies the write at the sample it falls on)
  */
 
-inline void MOS6581::WriteRegister(uint16_t adr, uint8_t byte)
+inline void MOS6581::WriteRegister(uint16_t adr, uint8_t byte, unsigned line_cycle)
 {
 	// Handle fake voice 3 oscillator
 	if (adr == 0x0e || adr == 0x0f || adr == 0x12) {	// Voice 3 frequency or control register
@@ -281,8 +353,38 @@ inline void MOS6581::WriteRegister(uint16_t adr, uint8_t byte)
 	last_sid_seq = 8;	// 8 bits to leak
 	last_sid_cycles = sid_leakage_cycles[last_sid_seq];
 
+#if SID_CAPTURE
+	sid_capture_write(chip_base | adr, byte, line_cycle);
+#endif
+
+	SIDRenderer * renderer = render_sid->the_renderer;
+	if (renderer != nullptr) {
+		renderer->WriteRegisterAt(chip_base | adr, byte, line_cycle);
+	}
+}
+
+
+/*
+ *  Render the register writes queued for the renderer (SID_WRITE_QUEUE > 0),
+ *  called in a loop by the second core
+ */
+
+inline void MOS6581::RenderQueued()
+{
+	if (the_renderer != nullptr) {
+		the_renderer->RenderQueued();
+	}
+}
+
+
+/*
+ *  Wait until the renderer has processed all queued register writes
+ */
+
+inline void MOS6581::WaitRendered()
+{
 	if (the_renderer != nullptr) {
-		the_renderer->WriteRegister(adr, byte);
+		the_renderer->WaitRendered();
 	}
 }
 
@@ -0,0 +1,83 @@
+/*
+ *  Scheduler.h - Next-event scheduler for the line-based emulation
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Each event source has the CIA clock cycle of its next event (a timer
+ *  underflow, a TOD tick). The frame loop advances the clock by one raster
+ *  line and only calls into the sources when the earliest of those cycles
+ *  has been reached, so chips with nothing to do cost one compare per
+ *  line. The sources reschedule themselves when their registers are
+ *  written. There are only a few sources, so the earliest cycle is found
+ *  by scanning them on every change.
+ *
+ *  Cycles are compared as signed differences, so the clock may wrap.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+
+// Event sources
+enum {
+	EVENT_CIA1,		// Timer underflow of CIA 1 with a consumer (IRQ, timer B)
+	EVENT_CIA2,		// Same for CIA 2
+	EVENT_TOD,		// TOD tick of both CIAs
+	NUM_EVENTS
+};
+
+// Distance of "no event" from the current cycle
+constexpr uint32_t EVENT_NEVER = 0x40000000;
+
+
+class Scheduler {
+public:
+	Scheduler() { Reset(); }
+
+	void Reset()
+	{
+		now = 0;
+		for (unsigned i = 0; i < NUM_EVENTS; ++i) {
+			due[i] = EVENT_NEVER;
+		}
+		next = EVENT_NEVER;
+	}
+
+	uint32_t Now() const { return now; }
+	void Advance(uint32_t cycles) { now += cycles; }
+
+	// True if an event is due at the current cycle
+	bool Pending() const { return (int32_t)(now - next) >= 0; }
+	bool Due(unsigned event) const { return (int32_t)(now - due[event]) >= 0; }
+
+	uint32_t Next() const { return next; }
+	uint32_t NextOf(unsigned event) const { return due[event]; }
+
+	// Set the cycle of the next event of a source
+	void Schedule(unsigned event, uint32_t cycle)
+	{
+		due[event] = cycle;
+		next = due[0];
+		for (unsigned i = 1; i < NUM_EVENTS; ++i) {
+			if ((int32_t)(due[i] - next) < 0) {
+				next = due[i];
+			}
+		}
+	}
+
+private:
+	uint32_t now;				// Current CIA clock cycle
+	uint32_t next;				// Earliest of due[]
+	uint32_t due[NUM_EVENTS];	// Next event of each source
+};
+
+
+#endif // ndef SCHEDULER_H
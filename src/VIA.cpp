@@ -160,3 +160,75 @@ void MOS6522::CountTimers(int cycles)
 		}
 	}
 }
+
+
+/*
+ *  Count VIA timers over a longer time in one step: like CountTimers(),
+ *  but T1 keeps its phase over any number of underflows. Used while the
+ *  CPU sleeps, up to CyclesToIRQ() at most. With quiet set, the IRQs of a
+ *  free-running T1 are taken to be acknowledged by a handler that has
+ *  nothing to do, so they are not raised and the time is not limited.
+ */
+
+void MOS6522::SkipTimers(uint32_t cycles, bool quiet)
+{
+	if (cycles <= t1c) {
+		t1c -= cycles;
+	} else {
+		if (quiet && (acr & 0x40) && (ier & 0x40)) {
+			// Handler reads T1C-L, which clears the flag
+		} else if (!t1_irq_blocked) {
+			ifr |= 0x40;
+			if (ier & 0x40) {
+				trigger_irq();
+			}
+		}
+		if ((acr & 0x40) == 0) {	// One-shot mode
+			t1_irq_blocked = true;
+		}
+		uint32_t after = cycles - t1c - 1;		// Since the first underflow
+		t1c = t1l - after % (t1l + 1u);			// Reloaded from latch on every underflow
+	}
+
+	if ((acr & 0x20) == 0) {		// Only count in one-shot mode
+		bool underflow = cycles > t2c;
+		t2c -= cycles;				// Keeps counting after the underflow
+		if (underflow && !t2_irq_blocked) {
+			t2_irq_blocked = true;
+			ifr |= 0x20;
+			if (ier & 0x20) {
+				trigger_irq();
+			}
+		}
+	}
+}
+
+
+/*
+ *  Cycles until the next timer underflow that raises an IRQ, 0xffffffff if
+ *  none can
+ */
+
+uint32_t MOS6522::CyclesToIRQ() const
+{
+	uint32_t cycles = 0xffffffff;
+	if ((ier & 0x40) && !t1_irq_blocked) {
+		cycles = t1c + 1u;
+	}
+	if ((ier & 0x20) && !t2_irq_blocked && (acr & 0x20) == 0 && t2c + 1u < cycles) {
+		cycles = t2c + 1u;
+	}
+	return cycles;
+}
+
+
+/*
+ *  Check that only a free-running T1 can raise a timer IRQ
+ */
+
+bool MOS6522::OnlyPeriodicIRQ() const
+{
+	bool t1_once = (ier & 0x40) && !t1_irq_blocked && (acr & 0x40) == 0;
+	bool t2_once = (ier & 0x20) && !t2_irq_blocked && (acr & 0x20) == 0;
+	return !t1_once && !t2_once;
+}
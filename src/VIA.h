@@ -41,6 +41,9 @@ public:
 	void EmulateCycle();			// Emulate one clock cycle
 #else
 	void CountTimers(int cycles);	// Emulate timers
+	void SkipTimers(uint32_t cycles, bool quiet = false);	// Same for any number of underflows (sleeping CPU)
+	uint32_t CyclesToIRQ() const;		// Cycles until a timer raises an IRQ
+	bool OnlyPeriodicIRQ() const;		// No one-shot timer IRQ pending
 #endif
 
 	uint8_t ReadRegister(uint16_t adr);
@@ -66,6 +66,29 @@
 // Test alignment on run-time for processors that can't access unaligned:
 #undef ALIGNMENT_CHECK
 
+#ifndef DISPLAY_CROPPED
+#define DISPLAY_CROPPED 0
+#endif
+
+#if DISPLAY_CROPPED
+// The frame buffer only holds the FRAME_X x FRAME_Y window at FRAME_LEFT/
+// FRAME_TOP of the VIC output, which horizontally is exactly the 40
+// column display window (see render_line())
+
+// Sprite pixel i at position x of the line is inside the window
+#define SPR_VISIBLE(x, i) ((unsigned)((x) - FRAME_LEFT + (i)) < FRAME_X)
+#else
+#define SPR_VISIBLE(x, i) true
+#endif
+
+#if VIC_RENDER_QUEUE && defined(FRODO_HOST)
+// Host build: the rendering thread may share the CPU with the emulation
+#include <thread>
+#define RENDER_WAIT() std::this_thread::yield()
+#else
+#define RENDER_WAIT()
+#endif
+
 // First and last displayed line
 const unsigned FIRST_DISP_LINE = 0x10;
 const unsigned LAST_DISP_LINE = 0x11f;
@@ -85,6 +108,11 @@ const int COL40_XSTOP = 0x160;
 const int COL38_XSTART = 0x27;
 const int COL38_XSTOP = 0x157;
 
+#if DISPLAY_CROPPED
+static_assert(FRAME_LEFT == COL40_XSTART && FRAME_LEFT + FRAME_X == COL40_XSTOP,
+              "Cropped frame must match the 40 column display window");
+#endif
+
 
 // Tables for sprite X expansion
 uint16_t ExpTable[256] = {
@@ -166,43 +194,31 @@ typedef union {
 } TextColorEntry;
 
 #ifdef FRODO_RP2350
-// For RP2350: compute colors on the fly instead of using 512KB lookup table
-// This is slower but avoids PSRAM access issues
+// For RP2350: expand the 8 pixels of a character through a 2 KB mask
+// table instead of the 512 KB TextColorTable, which doesn't fit in SRAM
 #define USE_DYNAMIC_TEXT_COLOR 1
 
-static uint8_t text_colors[16];  // Palette colors for text rendering
+static uint32_t text_colors4[16];		// Palette color in all four bytes
+static uint32_t text_mask[256][2];		// $ff in each byte whose pixel is set
 
-// Compute text color on the fly - replaces TextColorTable[fg][bg][data][half]
-static inline uint32_t compute_text_color(uint8_t fg, uint8_t bg, uint8_t data, int half)
-{
-	uint8_t fg_col = text_colors[fg];
-	uint8_t bg_col = text_colors[bg];
-	TextColorEntry entry;
-	if (half == 0) {
-		entry.a.a = (data & 0x80) ? fg_col : bg_col;
-		entry.a.b = (data & 0x40) ? fg_col : bg_col;
-		entry.a.c = (data & 0x20) ? fg_col : bg_col;
-		entry.a.d = (data & 0x10) ? fg_col : bg_col;
-	} else {
-		entry.a.a = (data & 0x08) ? fg_col : bg_col;
-		entry.a.b = (data & 0x04) ? fg_col : bg_col;
-		entry.a.c = (data & 0x02) ? fg_col : bg_col;
-		entry.a.d = (data & 0x01) ? fg_col : bg_col;
-	}
-	return entry.b;
-}
+// Replicate color into a word of 4 pixels
+#define TEXT_EXPAND(c) text_colors4[c]
 
-// Macro to access TextColorTable - uses compute on RP2350, direct access on desktop
-#define TEXT_COLOR(fg, bg, data, half) compute_text_color(fg, bg, data, half)
+// 4 pixels of data (half 0 = bits 7..4, half 1 = bits 3..0) in expanded colors
+#define TEXT_BLEND(fg4, bg4, data, half) \
+	((text_mask[data][half] & (fg4)) | (~text_mask[data][half] & (bg4)))
 #else
 // For desktop: static allocation of 512KB lookup table
 static TextColorEntry TextColorTable[16][16][256][2];
 #define USE_DYNAMIC_TEXT_COLOR 0
 
-// Macro to access TextColorTable - direct access on desktop
-#define TEXT_COLOR(fg, bg, data, half) TextColorTable[fg][bg][data][half].b
+#define TEXT_EXPAND(c) (c)
+#define TEXT_BLEND(fg, bg, data, half) TextColorTable[fg][bg][data][half].b
 #endif
 
+// 4 pixels of data in color fg on background bg
+#define TEXT_COLOR(fg, bg, data, half) TEXT_BLEND(TEXT_EXPAND(fg), TEXT_EXPAND(bg), data, half)
+
 
 /*
  *  Constructor: Initialize variables
@@ -211,10 +227,21 @@ static TextColorEntry TextColorTable[16][16][256][2];
 static void init_text_color_table(uint8_t *colors)
 {
 #if USE_DYNAMIC_TEXT_COLOR
-	// For RP2350: just save the color palette for on-the-fly computation
-	printf("Using dynamic text color computation (no TextColorTable)\n");
 	for (int i = 0; i < 16; i++) {
-		text_colors[i] = colors[i];
+		text_colors4[i] = colors[i] * 0x01010101u;
+	}
+
+	// Leftmost pixel goes to the lowest address
+	for (int k = 0; k < 256; k++) {
+		for (int half = 0; half < 2; half++) {
+			uint32_t mask = 0;
+			for (int bit = 0; bit < 4; bit++) {
+				if (k & (0x80 >> (half * 4 + bit))) {
+					mask |= 0xffu << (bit * 8);
+				}
+			}
+			text_mask[k][half] = mask;
+		}
 	}
 #else
 	// For desktop: fill the 512KB lookup table
@@ -281,6 +308,11 @@ MOS6569::MOS6569(C64 *c64, Display *disp, MOS6510 *CPU, uint8_t *RAM, const uint
 	// Clear foreground mask
 	memset(fore_mask_buf, 0, DISPLAY_X/8);
 
+#if VIC_RENDER_QUEUE
+	render_head = render_tail = 0;
+	render_coll = 0;
+#endif
+
 	// Set one-to-one palette for VIC
 	// TODO: This is obsolete code for direct access to indexed frame
 	// buffers and should probably be removed
@@ -291,25 +323,12 @@ MOS6569::MOS6569(C64 *c64, Display *disp, MOS6510 *CPU, uint8_t *RAM, const uint
 	// Preset colors to black
 	init_text_color_table(colors);
 	ec_color = b0c_color = b1c_color = b2c_color = b3c_color = mm0_color = mm1_color = colors[0];
-	ec_color_long = (ec_color << 24) | (ec_color << 16) | (ec_color << 8) | ec_color;
 	for (unsigned i = 0; i < 8; ++i) {
 		spr_color[i] = colors[0];
 	}
 }
 
 
-/*
- *  Init multicolor lookup table
- */
-
-void MOS6569::make_mc_table()
-{
-	mc_color_lookup[0] = b0c_color | (b0c_color << 8);
-	mc_color_lookup[1] = b1c_color | (b1c_color << 8);
-	mc_color_lookup[2] = b2c_color | (b2c_color << 8);
-}
-
-
 /*
  *  Convert video address to pointer
  */
@@ -449,14 +468,12 @@ void MOS6569::SetState(const MOS6569State *vd)
 
 	ec = vd->ec;
 	ec_color = colors[ec];
-	ec_color_long = (ec_color << 24) | (ec_color << 16) | (ec_color << 8) | ec_color;
 
 	b0c = vd->b0c; b1c = vd->b1c; b2c = vd->b2c; b3c = vd->b3c;
 	b0c_color = colors[b0c];
 	b1c_color = colors[b1c];
 	b2c_color = colors[b2c];
 	b3c_color = colors[b3c];
-	make_mc_table();
 
 	mm0 = vd->mm0; mm1 = vd->mm1;
 	mm0_color = colors[mm0];
@@ -702,28 +719,18 @@ void MOS6569::WriteRegister(uint16_t adr, uint8_t byte)
 
 		case 0x20:
 			ec_color = colors[ec = byte];
-			ec_color_long = (ec_color << 24) | (ec_color << 16) | (ec_color << 8) | ec_color;
 			break;
 
 		case 0x21:
-			if (b0c != byte) {
-				b0c_color = colors[b0c = byte & 0xF];
-				make_mc_table();
-			}
+			b0c_color = colors[b0c = byte & 0xF];
 			break;
 
 		case 0x22: 
-			if (b1c != byte) {
-				b1c_color = colors[b1c = byte & 0xF];
-				make_mc_table();
-			}
+			b1c_color = colors[b1c = byte & 0xF];
 			break;
 
 		case 0x23: 
-			if (b2c != byte) {
-				b2c_color = colors[b2c = byte & 0xF];
-				make_mc_table();
-			}
+			b2c_color = colors[b2c = byte & 0xF];
 			break;
 
 		case 0x24: b3c_color = colors[b3c = byte & 0xF]; break;
@@ -774,11 +781,11 @@ void MOS6569::TriggerLightpen()
  *  Display line drawing routines...
  */
 
-inline void MOS6569::el_std_text(uint8_t *p, const uint8_t *q, uint8_t *r)
+inline void MOS6569::el_std_text(uint8_t *p, const VICLine &l, uint8_t *r)
 {
-    const unsigned int b0cc = b0c;
-    uint8_t *cp = color_line;
-    uint8_t *mp = matrix_line;
+    const uint32_t bg4 = TEXT_EXPAND(l.b0c);
+    const uint8_t *cp = l.color;
+    const uint8_t *gp = l.gfx;
 
     if (((uintptr_t)p & 3) == 0) {
         uint32_t *lp = (uint32_t*)p;
@@ -786,22 +793,22 @@ inline void MOS6569::el_std_text(uint8_t *p, const uint8_t *q, uint8_t *r)
         for (int i = 0; i < 40; i += 2) {
             // ---- char 0 ----
             uint8_t c0 = *cp++;
-            uint8_t m0 = *mp++;
-            uint8_t d0 = *r++ = q[m0 << 3];
+            uint8_t d0 = *r++ = *gp++;
 
-            uint32_t o00 = TEXT_COLOR(c0, b0cc, d0, 0);
-            uint32_t o01 = TEXT_COLOR(c0, b0cc, d0, 1);
+            uint32_t fg0 = TEXT_EXPAND(c0);
+            uint32_t o00 = TEXT_BLEND(fg0, bg4, d0, 0);
+            uint32_t o01 = TEXT_BLEND(fg0, bg4, d0, 1);
 
             *lp++ = o00;
             *lp++ = o01;
 
             // ---- char 1 ----
             uint8_t c1 = *cp++;
-            uint8_t m1 = *mp++;
-            uint8_t d1 = *r++ = q[m1 << 3];
+            uint8_t d1 = *r++ = *gp++;
 
-            uint32_t o10 = TEXT_COLOR(c1, b0cc, d1, 0);
-            uint32_t o11 = TEXT_COLOR(c1, b0cc, d1, 1);
+            uint32_t fg1 = TEXT_EXPAND(c1);
+            uint32_t o10 = TEXT_BLEND(fg1, bg4, d1, 0);
+            uint32_t o11 = TEXT_BLEND(fg1, bg4, d1, 1);
 
             *lp++ = o10;
             *lp++ = o11;
@@ -810,11 +817,11 @@ inline void MOS6569::el_std_text(uint8_t *p, const uint8_t *q, uint8_t *r)
         for (int i = 0; i < 40; i += 2) {
             // ---- char 0 ----
             uint8_t c0 = *cp++;
-            uint8_t m0 = *mp++;
-            uint8_t d0 = *r++ = q[m0 << 3];
+            uint8_t d0 = *r++ = *gp++;
 
-            uint32_t o00 = TEXT_COLOR(c0, b0cc, d0, 0);
-            uint32_t o01 = TEXT_COLOR(c0, b0cc, d0, 1);
+            uint32_t fg0 = TEXT_EXPAND(c0);
+            uint32_t o00 = TEXT_BLEND(fg0, bg4, d0, 0);
+            uint32_t o01 = TEXT_BLEND(fg0, bg4, d0, 1);
 
             p[0] = (uint8_t)o00;
             p[1] = (uint8_t)(o00 >> 8);
@@ -828,11 +835,11 @@ inline void MOS6569::el_std_text(uint8_t *p, const uint8_t *q, uint8_t *r)
 
             // ---- char 1 ----
             uint8_t c1 = *cp++;
-            uint8_t m1 = *mp++;
-            uint8_t d1 = *r++ = q[m1 << 3];
+            uint8_t d1 = *r++ = *gp++;
 
-            uint32_t o10 = TEXT_COLOR(c1, b0cc, d1, 0);
-            uint32_t o11 = TEXT_COLOR(c1, b0cc, d1, 1);
+            uint32_t fg1 = TEXT_EXPAND(c1);
+            uint32_t o10 = TEXT_BLEND(fg1, bg4, d1, 0);
+            uint32_t o11 = TEXT_BLEND(fg1, bg4, d1, 1);
 
             p[0] = (uint8_t)o10;
             p[1] = (uint8_t)(o10 >> 8);
@@ -853,18 +860,23 @@ static inline void store16(uint8_t *dst, uint16_t v)
     dst[1] = (uint8_t)(v >> 8);
 }
 
-inline void MOS6569::el_mc_text(uint8_t *p, const uint8_t *q, uint8_t *r)
+inline void MOS6569::el_mc_text(uint8_t *p, const VICLine &l, uint8_t *r)
 {
-    uint8_t *cp = color_line;
-    uint8_t *mp = matrix_line;
-    uint16_t *mclp = mc_color_lookup;
+    const uint8_t *cp = l.color;
+    const uint8_t *gp = l.gfx;
+    uint16_t mclp[4] = {
+        (uint16_t)(l.b0c_color | (l.b0c_color << 8)),
+        (uint16_t)(l.b1c_color | (l.b1c_color << 8)),
+        (uint16_t)(l.b2c_color | (l.b2c_color << 8)),
+        0
+    };
 
     // fast path: p выровнен по 4
     if (((uintptr_t)p & 3) == 0) {
         uint32_t *lp = (uint32_t*)p;
 
         for (unsigned i = 0; i < 40; ++i) {
-            uint8_t data = q[mp[i] << 3];
+            uint8_t data = gp[i];
 
             if (cp[i] & 8) {
                 uint8_t color = colors[cp[i] & 7];
@@ -889,15 +901,15 @@ inline void MOS6569::el_mc_text(uint8_t *p, const uint8_t *q, uint8_t *r)
                 uint8_t color = cp[i];
                 r[i] = data;
 
-                *lp++ = TEXT_COLOR(color, b0c, data, 0);
-                *lp++ = TEXT_COLOR(color, b0c, data, 1);
+                *lp++ = TEXT_COLOR(color, l.b0c, data, 0);
+                *lp++ = TEXT_COLOR(color, l.b0c, data, 1);
             }
         }
 
     } else {
         // safe path: байтовые записи
         for (unsigned i = 0; i < 40; ++i) {
-            uint8_t data = q[mp[i] << 3];
+            uint8_t data = gp[i];
 
             if (cp[i] & 8) {
                 uint8_t color = colors[cp[i] & 7];
@@ -916,8 +928,8 @@ inline void MOS6569::el_mc_text(uint8_t *p, const uint8_t *q, uint8_t *r)
                 uint8_t color = cp[i];
                 r[i] = data;
 
-                uint32_t c0 = TEXT_COLOR(color, b0c, data, 0);
-                uint32_t c1 = TEXT_COLOR(color, b0c, data, 1);
+                uint32_t c0 = TEXT_COLOR(color, l.b0c, data, 0);
+                uint32_t c1 = TEXT_COLOR(color, l.b0c, data, 1);
 
                 p[0] = (uint8_t)c0;
                 p[1] = (uint8_t)(c0 >> 8);
@@ -934,36 +946,35 @@ inline void MOS6569::el_mc_text(uint8_t *p, const uint8_t *q, uint8_t *r)
 }
 
 
-inline void MOS6569::el_std_bitmap(uint8_t *p, const uint8_t *q, uint8_t *r)
+inline void MOS6569::el_std_bitmap(uint8_t *p, const VICLine &l, uint8_t *r)
 {
-    uint8_t *mp = matrix_line;
+    const uint8_t *mp = l.matrix;
+    const uint8_t *gp = l.gfx;
 
     if (((uintptr_t)p & 3) == 0) {
         // fast path: выровненный вывод
         uint32_t *lp = (uint32_t*)p;
 
         for (unsigned i = 0; i < 40; ++i) {
-            uint8_t data   = r[i] = *q;
+            uint8_t data   = r[i] = gp[i];
             uint8_t colors = mp[i];
-            uint8_t color  = colors >> 4;
-            uint8_t bcolor = colors & 0x0f;
+            uint32_t fg4   = TEXT_EXPAND(colors >> 4);
+            uint32_t bg4   = TEXT_EXPAND(colors & 0x0f);
 
-            *lp++ = TEXT_COLOR(color, bcolor, data, 0);
-            *lp++ = TEXT_COLOR(color, bcolor, data, 1);
-
-            q += 8;
+            *lp++ = TEXT_BLEND(fg4, bg4, data, 0);
+            *lp++ = TEXT_BLEND(fg4, bg4, data, 1);
         }
 
     } else {
         // safe path: байтовая запись
         for (unsigned i = 0; i < 40; ++i) {
-            uint8_t data   = r[i] = *q;
+            uint8_t data   = r[i] = gp[i];
             uint8_t colors = mp[i];
-            uint8_t color  = colors >> 4;
-            uint8_t bcolor = colors & 0x0f;
+            uint32_t fg4   = TEXT_EXPAND(colors >> 4);
+            uint32_t bg4   = TEXT_EXPAND(colors & 0x0f);
 
-            uint32_t c0 = TEXT_COLOR(color, bcolor, data, 0);
-            uint32_t c1 = TEXT_COLOR(color, bcolor, data, 1);
+            uint32_t c0 = TEXT_BLEND(fg4, bg4, data, 0);
+            uint32_t c1 = TEXT_BLEND(fg4, bg4, data, 1);
 
             p[0] = (uint8_t)c0;
             p[1] = (uint8_t)(c0 >> 8);
@@ -975,16 +986,16 @@ inline void MOS6569::el_std_bitmap(uint8_t *p, const uint8_t *q, uint8_t *r)
             p[7] = (uint8_t)(c1 >> 24);
 
             p += 8;
-            q += 8;
         }
     }
 }
 
 
-inline void MOS6569::el_mc_bitmap(uint8_t *p, const uint8_t *q, uint8_t *r)
+inline void MOS6569::el_mc_bitmap(uint8_t *p, const VICLine &l, uint8_t *r)
 {
-    uint8_t *cp = color_line;
-    uint8_t *mp = matrix_line;
+    const uint8_t *cp = l.color;
+    const uint8_t *mp = l.matrix;
+    const uint8_t *gp = l.gfx;
 
     // fast path: p выровнен по 4
     if (((uintptr_t)p & 3) == 0) {
@@ -992,7 +1003,7 @@ inline void MOS6569::el_mc_bitmap(uint8_t *p, const uint8_t *q, uint8_t *r)
 
         for (unsigned i = 0; i < 40; ++i) {
             uint8_t m = mp[i];
-            uint8_t c0 = b0c_color;
+            uint8_t c0 = l.b0c_color;
             uint8_t c1 = colors[m >> 4];
             uint8_t c2 = colors[m & 0x0f];
             uint8_t c3 = colors[cp[i]];
@@ -1002,7 +1013,7 @@ inline void MOS6569::el_mc_bitmap(uint8_t *p, const uint8_t *q, uint8_t *r)
             uint16_t l2 = (c2 << 8) | c2;
             uint16_t l3 = (c3 << 8) | c3;
 
-            uint8_t data = *q;
+            uint8_t data = gp[i];
             r[i] = (data & 0xaa) | ((data & 0xaa) >> 1);
 
             uint32_t w0 =
@@ -1031,15 +1042,13 @@ inline void MOS6569::el_mc_bitmap(uint8_t *p, const uint8_t *q, uint8_t *r)
 
             *lp++ = w0;
             *lp++ = w1;
-
-            q += 8;
         }
 
     } else {
         // safe path: байтовая запись
         for (unsigned i = 0; i < 40; ++i) {
             uint8_t m = mp[i];
-            uint8_t c0 = b0c_color;
+            uint8_t c0 = l.b0c_color;
             uint8_t c1 = colors[m >> 4];
             uint8_t c2 = colors[m & 0x0f];
             uint8_t c3 = colors[cp[i]];
@@ -1051,7 +1060,7 @@ inline void MOS6569::el_mc_bitmap(uint8_t *p, const uint8_t *q, uint8_t *r)
                 (uint16_t)((c3 << 8) | c3),
             };
 
-            uint8_t data = *q;
+            uint8_t data = gp[i];
             r[i] = (data & 0xaa) | ((data & 0xaa) >> 1);
 
             uint16_t v;
@@ -1062,17 +1071,18 @@ inline void MOS6569::el_mc_bitmap(uint8_t *p, const uint8_t *q, uint8_t *r)
             v = lookup[(data >> 0) & 3]; p[6] = v; p[7] = v >> 8;
 
             p += 8;
-            q += 8;
         }
     }
 }
 
 
-inline void MOS6569::el_ecm_text(uint8_t *p, const uint8_t *q, uint8_t *r)
+inline void MOS6569::el_ecm_text(uint8_t *p, const VICLine &l, uint8_t *r)
 {
-    uint8_t *cp  = color_line;
-    uint8_t *mp  = matrix_line;
-    uint8_t *bcp = &b0c;
+    const uint8_t *cp  = l.color;
+    const uint8_t *mp  = l.matrix;
+    const uint32_t bg4[4] = {
+        TEXT_EXPAND(l.b0c), TEXT_EXPAND(l.b1c), TEXT_EXPAND(l.b2c), TEXT_EXPAND(l.b3c)
+    };
 
     if (((uintptr_t)p & 3) == 0) {
         // fast path: выровненный вывод
@@ -1080,26 +1090,26 @@ inline void MOS6569::el_ecm_text(uint8_t *p, const uint8_t *q, uint8_t *r)
 
         for (unsigned i = 0; i < 40; ++i) {
             uint8_t data   = r[i] = mp[i];
-            uint8_t color  = cp[i];
-            uint8_t bcolor = bcp[(data >> 6) & 3];
+            uint32_t fg4   = TEXT_EXPAND(cp[i]);
+            uint32_t bc4   = bg4[data >> 6];
 
-            uint8_t glyph = q[(data & 0x3f) << 3];
+            uint8_t glyph = l.gfx[i];
 
-            *lp++ = TEXT_COLOR(color, bcolor, glyph, 0);
-            *lp++ = TEXT_COLOR(color, bcolor, glyph, 1);
+            *lp++ = TEXT_BLEND(fg4, bc4, glyph, 0);
+            *lp++ = TEXT_BLEND(fg4, bc4, glyph, 1);
         }
 
     } else {
         // safe path: байтовая запись
         for (unsigned i = 0; i < 40; ++i) {
             uint8_t data   = r[i] = mp[i];
-            uint8_t color  = cp[i];
-            uint8_t bcolor = bcp[(data >> 6) & 3];
+            uint32_t fg4   = TEXT_EXPAND(cp[i]);
+            uint32_t bc4   = bg4[data >> 6];
 
-            uint8_t glyph = q[(data & 0x3f) << 3];
+            uint8_t glyph = l.gfx[i];
 
-            uint32_t c0 = TEXT_COLOR(color, bcolor, glyph, 0);
-            uint32_t c1 = TEXT_COLOR(color, bcolor, glyph, 1);
+            uint32_t c0 = TEXT_BLEND(fg4, bc4, glyph, 0);
+            uint32_t c1 = TEXT_BLEND(fg4, bc4, glyph, 1);
 
             p[0] = (uint8_t)c0;
             p[1] = (uint8_t)(c0 >> 8);
@@ -1116,11 +1126,11 @@ inline void MOS6569::el_ecm_text(uint8_t *p, const uint8_t *q, uint8_t *r)
 }
 
 
-inline void MOS6569::el_std_idle(uint8_t *p, uint8_t *r)
+inline void MOS6569::el_std_idle(uint8_t *p, const VICLine &l, uint8_t *r)
 {
-	uint8_t data = *get_physical(ctrl1 & 0x40 ? 0x39ff : 0x3fff);
-	uint32_t conv0 = TEXT_COLOR(0, b0c, data, 0);
-	uint32_t conv1 = TEXT_COLOR(0, b0c, data, 1);
+	uint8_t data = l.gfx[0];
+	uint32_t conv0 = TEXT_COLOR(0, l.b0c, data, 0);
+	uint32_t conv1 = TEXT_COLOR(0, l.b0c, data, 1);
 
 	if (((uintptr_t)p & 3) == 0) {
 		uint32_t *lp = (uint32_t*)p;
@@ -1141,12 +1151,12 @@ inline void MOS6569::el_std_idle(uint8_t *p, uint8_t *r)
 }
 
 
-inline void MOS6569::el_mc_idle(uint8_t *p, uint8_t *r)
+inline void MOS6569::el_mc_idle(uint8_t *p, const VICLine &l, uint8_t *r)
 {
-    uint8_t data = *get_physical(0x3fff);
+    uint8_t data = l.gfx[0];
 
     // формируем lookup локально (быстро, в регистрах)
-    uint16_t lookup0 = (b0c_color << 8) | b0c_color;
+    uint16_t lookup0 = (l.b0c_color << 8) | l.b0c_color;
     uint16_t lookup1 = colors[0];
 
     uint32_t conv0 =
@@ -1183,8 +1193,11 @@ inline void MOS6569::el_mc_idle(uint8_t *p, uint8_t *r)
 }
 
 
-inline void MOS6569::el_sprites(uint8_t *chunky_ptr)
+inline unsigned MOS6569::el_sprites(const VICLine &l, uint8_t *chunky_ptr)
 {
+	const uint16_t *mx = l.mx;
+	uint8_t mxe = l.mxe, mmc = l.mmc, mdp = l.mdp;
+	uint8_t mm0_color = l.mm0_color, mm1_color = l.mm1_color;
 	unsigned spr_coll = 0, gfx_coll = 0;
 
 	// Draw each active sprite
@@ -1192,17 +1205,17 @@ inline void MOS6569::el_sprites(uint8_t *chunky_ptr)
 		uint8_t sbit = 1 << snum;
 
 		// Is sprite visible?
-		if ((sprite_on & sbit) && mx[snum] < DISPLAY_X-32) {
-			uint8_t *p = chunky_ptr + mx[snum] + 8;
-			uint8_t *q = spr_coll_buf + mx[snum] + 8;
+		if ((l.sprite_on & sbit) && mx[snum] < DISPLAY_X-32) {
+			unsigned sx = mx[snum] + 8;		// Sprite position in the line
+			uint8_t *p = chunky_ptr + sx;
+			uint8_t *q = spr_coll_buf + sx;
 
-			// Fetch sprite data and mask
-			const uint8_t *sdatap = get_physical(matrix_base[0x3f8 + snum] << 6 | mc[snum]);
-			uint32_t sdata = (*sdatap << 24) | (*(sdatap+1) << 16) | (*(sdatap+2) << 8);
+			// Get sprite data and mask
+			uint32_t sdata = l.spr_data[snum];
 
-			uint8_t color = spr_color[snum];
+			uint8_t color = l.spr_color[snum];
 
-			unsigned spr_mask_pos = mx[snum] + 8 - x_scroll;	// Sprite bit position in fore_mask_buf
+			unsigned spr_mask_pos = mx[snum] + 8 - l.x_scroll;	// Sprite bit position in fore_mask_buf
 			unsigned sshift = spr_mask_pos & 7;
 			
 			uint8_t *fmbp = fore_mask_buf + (spr_mask_pos / 8);
@@ -1260,7 +1273,7 @@ inline void MOS6569::el_sprites(uint8_t *chunky_ptr)
 						}
 						if (q[i]) {	// Obscured by higher-priority data?
 							spr_coll |= q[i] | sbit;
-						} else if ((fore_mask & 0x80000000) == 0) {
+						} else if ((fore_mask & 0x80000000) == 0 && SPR_VISIBLE(sx, i)) {
 							p[i] = col;
 						}
 						q[i] |= sbit;
@@ -1282,7 +1295,7 @@ inline void MOS6569::el_sprites(uint8_t *chunky_ptr)
 						}
 						if (q[i]) {	// Obscured by higher-priority data?
 							spr_coll |= q[i] | sbit;
-						} else if ((fore_mask_r & 0x80000000) == 0) {
+						} else if ((fore_mask_r & 0x80000000) == 0 && SPR_VISIBLE(sx, i)) {
 							p[i] = col;
 						}
 						q[i] |= sbit;
@@ -1310,7 +1323,7 @@ inline void MOS6569::el_sprites(uint8_t *chunky_ptr)
 						if (sdata_l & 0x80000000) {
 							if (q[i]) {	// Obscured by higher-priority data?
 								spr_coll |= q[i] | sbit;
-							} else if ((fore_mask & 0x80000000) == 0) {
+							} else if ((fore_mask & 0x80000000) == 0 && SPR_VISIBLE(sx, i)) {
 								p[i] = color;
 							}
 							q[i] |= sbit;
@@ -1320,7 +1333,7 @@ inline void MOS6569::el_sprites(uint8_t *chunky_ptr)
 						if (sdata_r & 0x80000000) {
 							if (q[i]) {	// Obscured by higher-priority data?
 								spr_coll |= q[i] | sbit;
-							} else if ((fore_mask_r & 0x80000000) == 0) {
+							} else if ((fore_mask_r & 0x80000000) == 0 && SPR_VISIBLE(sx, i)) {
 								p[i] = color;
 							}
 							q[i] |= sbit;
@@ -1365,7 +1378,7 @@ inline void MOS6569::el_sprites(uint8_t *chunky_ptr)
 						}
 						if (q[i]) {	// Obscured by higher-priority data?
 							spr_coll |= q[i] | sbit;
-						} else if ((fore_mask & 0x80000000) == 0) {
+						} else if ((fore_mask & 0x80000000) == 0 && SPR_VISIBLE(sx, i)) {
 							p[i] = col;
 						}
 						q[i] |= sbit;
@@ -1388,7 +1401,7 @@ inline void MOS6569::el_sprites(uint8_t *chunky_ptr)
 						if (sdata & 0x80000000) {
 							if (q[i]) {		// Obscured by higher-priority data?
 								spr_coll |= q[i] | sbit;
-							} else if ((fore_mask & 0x80000000) == 0) {
+							} else if ((fore_mask & 0x80000000) == 0 && SPR_VISIBLE(sx, i)) {
 								p[i] = color;
 							}
 							q[i] |= sbit;
@@ -1399,6 +1412,19 @@ inline void MOS6569::el_sprites(uint8_t *chunky_ptr)
 		}
 	}
 
+	return spr_coll | (gfx_coll << 8);
+}
+
+
+/*
+ *  Latch sprite collisions found while drawing a line
+ *  (sprite-sprite in bits 0..7, sprite-background in bits 8..15)
+ */
+
+void MOS6569::apply_collisions(unsigned coll)
+{
+	unsigned spr_coll = coll & 0xff, gfx_coll = coll >> 8;
+
 	if (ThePrefs.SpriteCollisions) {
 
 		// Check sprite-sprite collisions
@@ -1505,6 +1531,269 @@ static inline void fill_color32(uint8_t *dst, uint32_t color, size_t bytes)
     }
 }
 
+/*
+ *  Capture registers and fetch graphics/sprite data for a line
+ *  in the display window
+ */
+
+void MOS6569::capture_line(VICLine &l)
+{
+	l.display_state = display_state;
+	l.border_40_col = border_40_col;
+	l.display_idx = display_idx;
+	l.x_scroll = x_scroll;
+	l.b0c = b0c; l.b1c = b1c; l.b2c = b2c; l.b3c = b3c;
+	l.ec_color = ec_color;
+	l.b0c_color = b0c_color;
+	l.b1c_color = b1c_color;
+	l.b2c_color = b2c_color;
+
+	if (display_state) {
+		memcpy(l.matrix, matrix_line, 40);
+		memcpy(l.color, color_line, 40);
+
+		switch (display_idx) {
+			case 0:		// Standard text
+			case 1: {	// Multicolor text
+				const uint8_t *q = char_base + rc;
+				for (unsigned i = 0; i < 40; ++i) {
+					l.gfx[i] = q[matrix_line[i] << 3];
+				}
+				break;
+			}
+			case 2:		// Standard bitmap
+			case 3: {	// Multicolor bitmap
+				const uint8_t *q = bitmap_base + (vc << 3) + rc;
+				for (unsigned i = 0; i < 40; ++i, q += 8) {
+					l.gfx[i] = *q;
+				}
+				break;
+			}
+			case 4: {	// ECM text
+				const uint8_t *q = char_base + rc;
+				for (unsigned i = 0; i < 40; ++i) {
+					l.gfx[i] = q[(matrix_line[i] & 0x3f) << 3];
+				}
+				break;
+			}
+		}
+	} else {
+		if (display_idx == 3) {
+			l.gfx[0] = *get_physical(0x3fff);
+		} else {
+			l.gfx[0] = *get_physical(ctrl1 & 0x40 ? 0x39ff : 0x3fff);
+		}
+	}
+
+	l.sprite_on = sprite_on;
+	if (sprite_on) {
+		l.mxe = mxe;
+		l.mmc = mmc;
+		l.mdp = mdp;
+		l.mm0_color = mm0_color;
+		l.mm1_color = mm1_color;
+		for (unsigned snum = 0; snum < 8; ++snum) {
+			if (sprite_on & (1 << snum)) {
+				const uint8_t *sdatap = get_physical(matrix_base[0x3f8 + snum] << 6 | mc[snum]);
+				l.spr_data[snum] = (sdatap[0] << 24) | (sdatap[1] << 16) | (sdatap[2] << 8);
+				l.spr_color[snum] = spr_color[snum];
+				l.mx[snum] = mx[snum];
+			}
+		}
+	}
+}
+
+
+/*
+ *  Draw a captured line, returns sprite collisions for apply_collisions()
+ */
+
+unsigned MOS6569::render_line(const VICLine &l)
+{
+	if (l.border_on) {
+		fill_color32(l.dst, l.ec_color * 0x01010101u, FRAME_X);
+		return 0;
+	}
+
+	uint8_t *chunky_ptr = l.dst - FRAME_LEFT;	// Start of the (partly) stored VIC line
+
+	// Display window contents
+	uint8_t *p = chunky_ptr + COL40_XSTART;		// Pointer in chunky display buffer
+	uint8_t *r = fore_mask_buf + COL40_XSTART/8;	// Pointer in foreground mask buffer
+
+	{
+		p--;
+		uint8_t b0cc = l.b0c_color;
+		unsigned limit = l.x_scroll;
+		for (unsigned i = 0; i < limit; ++i) {	// Background on the left if XScroll>0
+			*++p = b0cc;
+		}
+		p++;
+	}
+
+	// Draw to a word-aligned buffer if the line start isn't. In a
+	// cropped frame, graphics shifted by XScroll would also run past
+	// the right edge.
+#if DISPLAY_CROPPED
+	uint8_t *use_p = l.x_scroll ? text_chunky_buf : p;
+#elif !defined(CAN_ACCESS_UNALIGNED)
+#ifdef ALIGNMENT_CHECK
+	uint8_t *use_p = (((uintptr_t)p & 3) == 0) ? p : text_chunky_buf;
+#else
+	uint8_t *use_p = l.x_scroll ? text_chunky_buf : p;
+#endif
+#else
+	uint8_t *use_p = p;
+#endif
+
+	if (l.display_state) {
+		switch (l.display_idx) {
+			case 0:	// Standard text
+				el_std_text(use_p, l, r);
+				break;
+			case 1:	// Multicolor text
+				el_mc_text(use_p, l, r);
+				break;
+			case 2:	// Standard bitmap
+				el_std_bitmap(use_p, l, r);
+				break;
+			case 3:	// Multicolor bitmap
+				el_mc_bitmap(use_p, l, r);
+				break;
+			case 4:	// ECM text
+				el_ecm_text(use_p, l, r);
+				break;
+			default:	// Invalid mode (all black)
+				memset(use_p, colors[0], 320);
+				memset(r, 0, 40);
+				break;
+		}
+
+	} else {	// Idle state graphics
+		switch (l.display_idx) {
+			case 0:		// Standard text
+			case 1:		// Multicolor text
+			case 4:		// ECM text
+				el_std_idle(use_p, l, r);
+				break;
+			case 3:		// Multicolor bitmap
+				el_mc_idle(use_p, l, r);
+				break;
+			default:	// Invalid mode (all black)
+				memset(use_p, colors[0], 320);
+				memset(r, 0, 40);
+				break;
+		}
+	}
+
+	if (use_p != p) {
+		memcpy(p, use_p, DISPLAY_CROPPED ? 8*40 - l.x_scroll : 8*40);
+	}
+
+	// Draw sprites
+	unsigned coll = 0;
+	if (l.sprite_on) {
+		// Clear sprite collision buffer
+		memset(spr_coll_buf, 0, DISPLAY_X);
+		coll = el_sprites(l, chunky_ptr);
+	}
+
+#if !DISPLAY_CROPPED
+	uint32_t c = l.ec_color * 0x01010101u;
+	// Left border
+	fill_color32(chunky_ptr, c, COL40_XSTART);
+	// Right border
+	fill_color32(chunky_ptr + COL40_XSTOP, c, DISPLAY_X - COL40_XSTOP);
+#endif
+
+	if (!l.border_40_col) {
+		uint8_t c = l.ec_color;
+		p = chunky_ptr + COL40_XSTART - 1;
+		for (unsigned i = 0; i < COL38_XSTART-COL40_XSTART; ++i) {
+			*++p = c;
+		}
+		p = chunky_ptr + COL38_XSTOP - 1;
+		for (unsigned i = 0; i < COL40_XSTOP-COL38_XSTOP; ++i) {
+			*++p = c;
+		}
+	}
+
+	return coll;
+}
+
+
+#if VIC_RENDER_QUEUE
+/*
+ *  Draw all lines queued by EmulateLine() (called on the rendering core)
+ */
+
+void MOS6569::RenderLines()
+{
+	unsigned tail = render_tail.load(std::memory_order_relaxed);
+	while (tail != render_head.load(std::memory_order_acquire)) {
+		unsigned coll = render_line(render_queue[tail % VIC_RENDER_QUEUE]);
+		if (coll) {
+			render_coll.fetch_or(coll, std::memory_order_relaxed);
+		}
+		render_tail.store(++tail, std::memory_order_release);
+	}
+}
+
+
+/*
+ *  Wait until the rendering core has drawn all queued lines
+ */
+
+void MOS6569::WaitRendered()
+{
+	unsigned head = render_head.load(std::memory_order_relaxed);
+	while (render_tail.load(std::memory_order_acquire) != head) {
+		RENDER_WAIT();
+	}
+	if (render_coll.load(std::memory_order_relaxed)) {
+		apply_collisions(render_coll.exchange(0, std::memory_order_relaxed));
+	}
+}
+#endif
+
+
+/*
+ *  Capture the current display line and draw it, or queue it for
+ *  RenderLines()
+ */
+
+inline void MOS6569::emit_line()
+{
+#if VIC_RENDER_QUEUE
+	unsigned head = render_head.load(std::memory_order_relaxed);
+	while (head - render_tail.load(std::memory_order_acquire) >= VIC_RENDER_QUEUE) {
+		RENDER_WAIT();	// Queue full, wait for the rendering core
+	}
+	VICLine &l = render_queue[head % VIC_RENDER_QUEUE];
+#else
+	VICLine &l = render_buf;
+#endif
+
+	l.dst = chunky_line_start;
+	chunky_line_start += xmod;
+	l.border_on = border_on;
+	if (!border_on) {
+		capture_line(l);
+	} else {
+		l.ec_color = ec_color;
+	}
+
+#if VIC_RENDER_QUEUE
+	render_head.store(head + 1, std::memory_order_release);
+#else
+	unsigned coll = render_line(l);
+	if (coll) {
+		apply_collisions(coll);
+	}
+#endif
+}
+
+
 /*
  *  Emulate one raster line.
  *  Returns VIC_VBLANK if new frame has started.
@@ -1514,7 +1803,13 @@ static inline void fill_color32(uint8_t *dst, uint32_t color, size_t bytes)
 unsigned MOS6569::EmulateLine(int & retCyclesLeft)
 {
 	int cycles_left = ThePrefs.NormalCycles;	// Cycles left for CPU
-	bool is_bad_line = false;
+
+#if VIC_RENDER_QUEUE
+	// Latch collisions of lines drawn in the meantime
+	if (render_coll.load(std::memory_order_relaxed)) {
+		apply_collisions(render_coll.exchange(0, std::memory_order_relaxed));
+	}
+#endif
 
 	// Get raster counter into local variable for faster access and increment
 	unsigned raster = raster_y + 1;
@@ -1551,9 +1846,6 @@ unsigned MOS6569::EmulateLine(int & retCyclesLeft)
 	// Within the visible range?
 	if (raster >= FIRST_DISP_LINE && raster <= LAST_DISP_LINE) {
 
-		// Our output goes here
-		uint8_t *chunky_ptr = chunky_line_start;
-
 		// Set video counter
 		vc = vc_base;
 
@@ -1561,7 +1853,7 @@ unsigned MOS6569::EmulateLine(int & retCyclesLeft)
 		if (raster >= FIRST_DMA_LINE && raster <= LAST_DMA_LINE && ((raster & 7) == y_scroll) && bad_lines_enabled) {
 
 			// Turn on display
-			display_state = is_bad_line = true;
+			display_state = true;
 			cycles_left = ThePrefs.BadLineCycles;
 			rc = 0;
 
@@ -1585,244 +1877,18 @@ unsigned MOS6569::EmulateLine(int & retCyclesLeft)
 			border_on = false;
 		}
 
-		if (!border_on) {
-
-			// Display window contents
-			uint8_t *p = chunky_ptr + COL40_XSTART;		// Pointer in chunky display buffer
-			uint8_t *r = fore_mask_buf + COL40_XSTART/8;	// Pointer in foreground mask buffer
-#ifdef ALIGNMENT_CHECK
-			uint8_t *use_p = ((((int)p) & 3) == 0) ? p : text_chunky_buf;
-#endif
-
-			{
-				p--;
-				uint8_t b0cc = b0c_color;
-				unsigned limit = x_scroll;
-				for (unsigned i = 0; i < limit; ++i) {	// Background on the left if XScroll>0
-					*++p = b0cc;
-				}
-				p++;
-			}
-
-			if (display_state) {
-				switch (display_idx) {
-
-					case 0:	// Standard text
-#ifndef CAN_ACCESS_UNALIGNED
-#ifdef ALIGNMENT_CHECK
-						el_std_text(use_p, char_base + rc, r);
-						if (use_p != p) {
-							memcpy(p, use_p, 8*40);
-						}
-#else
-						if (x_scroll) {
-							el_std_text(text_chunky_buf, char_base + rc, r);
-							memcpy(p, text_chunky_buf, 8*40);					        
-						} else {
-							el_std_text(p, char_base + rc, r);
-						}
-#endif
-#else
-						el_std_text(p, char_base + rc, r);
-#endif
-						break;
-
-					case 1:	// Multicolor text
-#ifndef CAN_ACCESS_UNALIGNED
-#ifdef ALIGNMENT_CHECK
-						el_mc_text(use_p, char_base + rc, r);
-						if (use_p != p) {
-							memcpy(p, use_p, 8*40);
-						}
-#else
-						if (x_scroll) {
-							el_mc_text(text_chunky_buf, char_base + rc, r);
-							memcpy(p, text_chunky_buf, 8*40);					        
-						} else {
-							el_mc_text(p, char_base + rc, r);
-						}
-#endif
-#else
-						el_mc_text(p, char_base + rc, r);
-#endif
-						break;
-
-					case 2:	// Standard bitmap
-#ifndef CAN_ACCESS_UNALIGNED
-#ifdef ALIGNMENT_CHECK
-						el_std_bitmap(use_p, bitmap_base + (vc << 3) + rc, r);
-						if (use_p != p)
-							memcpy(p, use_p, 8*40);
-#else
-						if (x_scroll) {
-							el_std_bitmap(text_chunky_buf, bitmap_base + (vc << 3) + rc, r);
-							memcpy(p, text_chunky_buf, 8*40);					        
-						} else
-							el_std_bitmap(p, bitmap_base + (vc << 3) + rc, r);
-#endif
-#else
-						el_std_bitmap(p, bitmap_base + (vc << 3) + rc, r);
-#endif
-						break;
-
-					case 3:	// Multicolor bitmap
-#ifndef CAN_ACCESS_UNALIGNED
-#ifdef ALIGNMENT_CHECK
-						el_mc_bitmap(use_p, bitmap_base + (vc << 3) + rc, r);
-						if (use_p != p) {
-							memcpy(p, use_p, 8*40);
-						}
-#else
-						if (x_scroll) {
-							el_mc_bitmap(text_chunky_buf, bitmap_base + (vc << 3) + rc, r);
-							memcpy(p, text_chunky_buf, 8*40);					        
-						} else {
-							el_mc_bitmap(p, bitmap_base + (vc << 3) + rc, r);
-						}
-#endif
-#else
-						el_mc_bitmap(p, bitmap_base + (vc << 3) + rc, r);
-#endif
-						break;
-
-					case 4:	// ECM text
-#ifndef CAN_ACCESS_UNALIGNED
-#ifdef ALIGNMENT_CHECK
-						el_ecm_text(use_p, char_base + rc, r);
-						if (use_p != p) {
-							memcpy(p, use_p, 8*40);
-						}
-#else
-						if (x_scroll) {
-							el_ecm_text(text_chunky_buf, char_base + rc, r);
-							memcpy(p, text_chunky_buf, 8*40);					        
-						} else {
-							el_ecm_text(p, char_base + rc, r);
-						}
-#endif
-#else
-						el_ecm_text(p, char_base + rc, r);
-#endif
-						break;
-
-					default:	// Invalid mode (all black)
-						memset(p, colors[0], 320);
-						memset(r, 0, 40);
-						break;
-				}
-				vc += 40;
-
-			} else {	// Idle state graphics
-				switch (display_idx) {
-
-					case 0:		// Standard text
-					case 1:		// Multicolor text
-					case 4:		// ECM text
-#ifndef CAN_ACCESS_UNALIGNED
-#ifdef ALIGNMENT_CHECK
-						el_std_idle(use_p, r);
-						if (use_p != p) {memcpy(p, use_p, 8*40);}
-#else
-						if (x_scroll) {
-							el_std_idle(text_chunky_buf, r);
-							memcpy(p, text_chunky_buf, 8*40);					        
-						} else {
-							el_std_idle(p, r);
-						}
-#endif
-#else
-						el_std_idle(p, r);
-#endif
-						break;
-
-					case 3:		// Multicolor bitmap
-#ifndef CAN_ACCESS_UNALIGNED
-#ifdef ALIGNMENT_CHECK
-						el_mc_idle(use_p, r);
-						if (use_p != p) {memcpy(p, use_p, 8*40);}
-#else
-						if (x_scroll) {
-							el_mc_idle(text_chunky_buf, r);
-							memcpy(p, text_chunky_buf, 8*40);					        
-						} else {
-							el_mc_idle(p, r);
-						}
-#endif
+#if DISPLAY_CROPPED
+		// Lines outside the window are neither stored nor drawn
+		if (raster - (FIRST_DISP_LINE + FRAME_TOP) < FRAME_Y) {
+			emit_line();
+		}
 #else
-						el_mc_idle(p, r);
-#endif
-						break;
-
-					default:	// Invalid mode (all black)
-						memset(p, colors[0], 320);
-						memset(r, 0, 40);
-						break;
-				}
-			}
-
-			// Draw sprites
-			if (sprite_on) {
-				// Clear sprite collision buffer
-				memset(spr_coll_buf, 0, DISPLAY_X);
-				el_sprites(chunky_ptr);
-			}
-
-			uint32_t c = ec_color_long;
-			// Left border
-			fill_color32(chunky_ptr, c, COL40_XSTART);
-			// Right border
-			fill_color32(chunky_ptr + COL40_XSTOP, c, DISPLAY_X - COL40_XSTOP);
-
-			if (!border_40_col) {
-				c = ec_color;
-				p = chunky_ptr + COL40_XSTART - 1;
-				for (unsigned i = 0; i < COL38_XSTART-COL40_XSTART; ++i) {
-					*++p = c;
-				}
-				p = chunky_ptr + COL38_XSTOP - 1;
-				for (unsigned i = 0; i < COL40_XSTOP-COL38_XSTOP; ++i) {
-					*++p = c;
-				}
-			}
-
-#if 0	// For debugging...
-			if (is_bad_line) {
-				chunky_ptr[DISPLAY_X-2] = colors[7];
-				chunky_ptr[DISPLAY_X-3] = colors[7];
-			}
-			if (rc & 1) {
-				chunky_ptr[DISPLAY_X-4] = colors[1];
-				chunky_ptr[DISPLAY_X-5] = colors[1];
-			}
-			if (rc & 2) {
-				chunky_ptr[DISPLAY_X-6] = colors[1];
-				chunky_ptr[DISPLAY_X-7] = colors[1];
-			}
-			if (rc & 4) {
-				chunky_ptr[DISPLAY_X-8] = colors[1];
-				chunky_ptr[DISPLAY_X-9] = colors[1];
-			}
-			if (ctrl1 & 0x40) {
-				chunky_ptr[DISPLAY_X-10] = colors[5];
-				chunky_ptr[DISPLAY_X-11] = colors[5];
-			}
-			if (ctrl1 & 0x20) {
-				chunky_ptr[DISPLAY_X-12] = colors[3];
-				chunky_ptr[DISPLAY_X-13] = colors[3];
-			}
-			if (ctrl2 & 0x10) {
-				chunky_ptr[DISPLAY_X-14] = colors[2];
-				chunky_ptr[DISPLAY_X-15] = colors[2];
-			}
+		emit_line();
 #endif
-		} else {
-			// Display border
-			fill_color32(chunky_ptr, ec_color_long, DISPLAY_X);
+		if (!border_on && display_state) {
+			vc += 40;
 		}
 
-		// Increment pointer in chunky buffer
-		chunky_line_start += xmod;
-
 		// Increment row counter, go to idle state on overflow
 		if (rc == 7) {
 			display_state = false;
@@ -43,6 +43,44 @@ enum {
 };
 
 
+#ifndef FRODO_SC
+
+// Number of raster lines EmulateLine() can run ahead of the pixel
+// rendering, which is then done by RenderLines() on another core
+// (0 = render every line inside EmulateLine())
+#ifndef VIC_RENDER_QUEUE
+#define VIC_RENDER_QUEUE 0
+#endif
+
+#if VIC_RENDER_QUEUE
+#include <atomic>
+#endif
+
+// Everything the pixel kernels need to draw one raster line, captured
+// by EmulateLine() so that drawing doesn't depend on VIC registers or
+// C64 memory changed afterwards
+struct VICLine {
+	uint8_t *dst;				// Start of line in chunky buffer (nullptr = not stored)
+	bool border_on;				// Whole line is border
+	bool display_state;
+	bool border_40_col;
+	uint8_t display_idx;
+	uint8_t x_scroll;
+	uint8_t sprite_on, mxe, mmc, mdp;
+	uint8_t b0c, b1c, b2c, b3c;	// Background color registers
+	uint8_t ec_color, b0c_color, b1c_color, b2c_color;
+	uint8_t mm0_color, mm1_color;
+	uint8_t spr_color[8];
+	uint16_t mx[8];
+	uint32_t spr_data[8];		// Sprite data bytes in bits 31..8
+	uint8_t gfx[40];			// Character/bitmap data per column (idle state: gfx[0])
+	uint8_t matrix[40];			// Video matrix line
+	uint8_t color[40];			// Color RAM line
+};
+
+#endif
+
+
 class MOS6510;
 class Display;
 class C64;
@@ -61,6 +99,14 @@ public:
 	unsigned EmulateCycle();
 #else
 	unsigned EmulateLine(int & retCyclesLeft);
+
+#if VIC_RENDER_QUEUE
+	void RenderLines();					// Draw queued lines (on the rendering core)
+	void WaitRendered();				// Wait until all queued lines are drawn
+#else
+	void RenderLines() {}
+	void WaitRendered() {}
+#endif
 #endif
 
 	void ChangedVA(uint16_t new_va);	// CIA VA14/15 has changed
@@ -125,9 +171,7 @@ private:
 	uint8_t fore_mask_buf[(0x200 + 48) / 8];	// Foreground mask for sprite-graphics collisions and priorities
 												// (must be wider than line to handle X-expanded sprites under
 												// the left border (MxX = 0x1e1..0x1f7))
-#ifndef CAN_ACCESS_UNALIGNED
-	uint8_t text_chunky_buf[40*8];				// Line graphics buffer
-#endif
+	alignas(4) uint8_t text_chunky_buf[40*8];	// Line graphics buffer
 
 	bool display_state;			// true: Display state, false: Idle state
 	bool border_on;				// Flag: Upper/lower border on (Frodo SC: Main border flip-flop)
@@ -200,17 +244,29 @@ private:
 	SprLatch spr_latch[8];			// Latched sprite data for drawing
 #else
 	const uint8_t *get_physical(uint16_t adr);
-	void make_mc_table();
-	void el_std_text(uint8_t *p, const uint8_t *q, uint8_t *r);
-	void el_mc_text(uint8_t *p, const uint8_t *q, uint8_t *r);
-	void el_std_bitmap(uint8_t *p, const uint8_t *q, uint8_t *r);
-	void el_mc_bitmap(uint8_t *p, const uint8_t *q, uint8_t *r);
-	void el_ecm_text(uint8_t *p, const uint8_t *q, uint8_t *r);
-	void el_std_idle(uint8_t *p, uint8_t *r);
-	void el_mc_idle(uint8_t *p, uint8_t *r);
-	void el_sprites(uint8_t *chunky_ptr);
+	void emit_line();
+	void capture_line(VICLine &l);
+	unsigned render_line(const VICLine &l);
+	void apply_collisions(unsigned coll);
+	void el_std_text(uint8_t *p, const VICLine &l, uint8_t *r);
+	void el_mc_text(uint8_t *p, const VICLine &l, uint8_t *r);
+	void el_std_bitmap(uint8_t *p, const VICLine &l, uint8_t *r);
+	void el_mc_bitmap(uint8_t *p, const VICLine &l, uint8_t *r);
+	void el_ecm_text(uint8_t *p, const VICLine &l, uint8_t *r);
+	void el_std_idle(uint8_t *p, const VICLine &l, uint8_t *r);
+	void el_mc_idle(uint8_t *p, const VICLine &l, uint8_t *r);
+	unsigned el_sprites(const VICLine &l, uint8_t *chunky_ptr);
 	int el_update_mc(int raster);
 
+#if VIC_RENDER_QUEUE
+	VICLine render_queue[VIC_RENDER_QUEUE];
+	std::atomic<unsigned> render_head;		// Lines queued by EmulateLine()
+	std::atomic<unsigned> render_tail;		// Lines drawn by RenderLines()
+	std::atomic<unsigned> render_coll;		// Collisions found by RenderLines(), see apply_collisions()
+#else
+	VICLine render_buf;
+#endif
+
 	uint8_t colors[256];			// Indices of the 16 C64 colors (16 times mirrored to avoid "& 0x0f")
 
 	uint8_t ec_color, b0c_color, b1c_color,
@@ -218,10 +274,6 @@ private:
 	uint8_t mm0_color, mm1_color;	// Indices for MOB multicolors
 	uint8_t spr_color[8];			// Indices for MOB colors
 
-	uint32_t ec_color_long;			// ec_color expanded to 32 bits
-
-	uint16_t mc_color_lookup[4];
-
 	bool border_40_col;				// Flag: 40 column border
 	uint8_t sprite_on;				// 8 flags: Sprite display/DMA active
 
@@ -33,6 +33,7 @@
 #include "../1541gcr.h"
 #include "../CPU1541.h"
 #include "../Prefs.h"
+#include "../Scheduler.h"
 
 // RP2350-specific headers
 extern "C" {
@@ -45,6 +46,11 @@ extern "C" {
 // Platform-specific
 #include "Display_rp2350.h"
 #include "ROM_data.h"
+#include "c64_profile.h"
+
+#if C64_PROFILE
+#include "hardware/structs/systick.h"
+#endif
 
 #include <cstring>
 #include <cstdlib>
@@ -59,6 +65,8 @@ C64 *TheC64 = nullptr;
 static Display *g_display = nullptr;
 static uint8_t g_RAM[C64_RAM_SIZE] __aligned(4);
 static uint8_t g_RAM1541[DRIVE_RAM_SIZE] __aligned(4);
+// Kernal in SRAM, so that the IEC traps can be removed for the 1541 processor
+static uint8_t g_Kernal[KERNAL_ROM_SIZE] __aligned(4);
 static uint8_t g_Color[COLOR_RAM_SIZE] __aligned(4);
 
 /*
@@ -72,7 +80,8 @@ C64::C64() : quit_requested(false), prefs_editor_requested(false), load_snapshot
     RAM = g_RAM;
     RAM1541 = g_RAM1541;
     Basic = BuiltinBasicROM;
-    Kernal = c64_fast_reset_rom;
+    memcpy(g_Kernal, c64_fast_reset_rom, KERNAL_ROM_SIZE);
+    Kernal = g_Kernal;
     Char = BuiltinCharROM;
     ROM1541 = c64_1541_rom;
     // Color RAM in regular SRAM for fast VIC access
@@ -95,6 +104,7 @@ C64::C64() : quit_requested(false), prefs_editor_requested(false), load_snapshot
     // Create the chips
     MII_DEBUG_PRINTF("  Creating CPU...\n");
     TheCPU = new MOS6510(this, RAM, Basic, Kernal, Char, Color);
+    patch_roms(ThePrefs.FastReset, ThePrefs.Emul1541Proc);
     MII_DEBUG_PRINTF("  CPU created\n");
 
     MII_DEBUG_PRINTF("  Creating 1541...\n");
@@ -116,6 +126,14 @@ C64::C64() : quit_requested(false), prefs_editor_requested(false), load_snapshot
     TheCIA2 = TheCPU1541->TheCIA2 = new MOS6526_2(TheCPU, TheVIC, TheCPU1541);
     MII_DEBUG_PRINTF("  CIAs created\n");
 
+    // CIA timer underflows and TOD ticks are scheduled events
+    TheScheduler = new Scheduler;
+#if !PRECISE_CIA_CYCLES
+    TheCIA1->SetScheduler(TheScheduler, EVENT_CIA1);
+    TheCIA2->SetScheduler(TheScheduler, EVENT_CIA2);
+    TheScheduler->Schedule(EVENT_TOD, ThePrefs.CIACycles * TOTAL_RASTERS);
+#endif
+
     MII_DEBUG_PRINTF("  Creating IEC...\n");
     TheIEC = new IEC(this);
     MII_DEBUG_PRINTF("  IEC created\n");
@@ -147,6 +165,7 @@ C64::~C64()
     delete TheIEC;
     delete TheCIA2;
     delete TheCIA1;
+    delete TheScheduler;
     delete TheSID;
     delete TheVIC;
     delete TheCPU1541;
@@ -179,79 +198,45 @@ void C64::init_memory()
 
 
 /*
- *  Apply ROM patch
+ *  Patch ROMs for fast reset and IEC emulation
  *
+ *  The built-in Kernal image comes with all patches applied. The IEC traps
+ *  ($f2 opcodes) are removed again for the 1541 processor emulation, which
+ *  needs the original serial bus routines. The 1541 ROM image already
+ *  skips the checksum and has the idle trap.
+ */
+
+struct ROMPatch {
+    uint16_t offset;
+    bool iec;           // IEC trap, else fast reset
+    uint8_t patch[2];
+};
+
+static const ROMPatch kernal_patches[] = {
+    { 0x1d84, false, { 0xa0, 0x00 } },  // Skip RAM test
+    { 0x0d40, true,  { 0xf2, 0x00 } },  // IECOut
+    { 0x0d23, true,  { 0xf2, 0x01 } },  // IECOutATN
+    { 0x0d36, true,  { 0xf2, 0x02 } },  // IECOutSec
+    { 0x0e13, true,  { 0xf2, 0x03 } },  // IECIn
+    { 0x0def, true,  { 0xf2, 0x04 } },  // IECSetATN
+    { 0x0dbe, true,  { 0xf2, 0x05 } },  // IECRelATN
+    { 0x0dcc, true,  { 0xf2, 0x06 } },  // IECTurnaround
+    { 0x0e03, true,  { 0xf2, 0x07 } },  // IECRelease
+};
 
-static void apply_patch(bool apply, uint8_t *rom, const uint8_t *builtin,
-                        uint16_t offset, unsigned size, const uint8_t *patch)
+void C64::patch_roms(bool fast_reset, bool emul_1541_proc)
 {
-    if (apply) {
-        if (memcmp(rom + offset, builtin + offset, size) == 0) {
-            memcpy(rom + offset, patch, size);
-        }
-    } else {
-        if (memcmp(rom + offset, patch, size) == 0) {
-            memcpy(rom + offset, builtin + offset, size);
+    for (const ROMPatch &p : kernal_patches) {
+        bool apply = p.iec ? !emul_1541_proc : fast_reset;
+        const uint8_t *from = apply ? BuiltinKernalROM + p.offset : p.patch;
+        const uint8_t *to = apply ? p.patch : BuiltinKernalROM + p.offset;
+        if (memcmp(g_Kernal + p.offset, from, sizeof(p.patch)) == 0) {
+            memcpy(g_Kernal + p.offset, to, sizeof(p.patch));
         }
     }
-}
-
-
-/*
- *  Patch ROMs for fast reset and IEC emulation
- */
 
-void C64::patch_roms(bool fast_reset, bool emul_1541_proc)
-{
-    /*
-    // Fast reset patch - skip RAM test
-    static const uint8_t fast_reset_patch[] = { 0xa0, 0x00 };
-    apply_patch(fast_reset, Kernal, BuiltinKernalROM, 0x1d84,
-                sizeof(fast_reset_patch), fast_reset_patch);
-
-    // IEC patches for non-processor-level disk emulation
-    static const uint8_t iec_patch_1[] = { 0xf2, 0x00 };  // IECOut
-    static const uint8_t iec_patch_2[] = { 0xf2, 0x01 };  // IECOutATN
-    static const uint8_t iec_patch_3[] = { 0xf2, 0x02 };  // IECOutSec
-    static const uint8_t iec_patch_4[] = { 0xf2, 0x03 };  // IECIn
-    static const uint8_t iec_patch_5[] = { 0xf2, 0x04 };  // IECSetATN
-    static const uint8_t iec_patch_6[] = { 0xf2, 0x05 };  // IECRelATN
-    static const uint8_t iec_patch_7[] = { 0xf2, 0x06 };  // IECTurnaround
-    static const uint8_t iec_patch_8[] = { 0xf2, 0x07 };  // IECRelease
-
-    apply_patch(!emul_1541_proc, Kernal, BuiltinKernalROM, 0x0d40,
-                sizeof(iec_patch_1), iec_patch_1);
-    apply_patch(!emul_1541_proc, Kernal, BuiltinKernalROM, 0x0d23,
-                sizeof(iec_patch_2), iec_patch_2);
-    apply_patch(!emul_1541_proc, Kernal, BuiltinKernalROM, 0x0d36,
-                sizeof(iec_patch_3), iec_patch_3);
-    apply_patch(!emul_1541_proc, Kernal, BuiltinKernalROM, 0x0e13,
-                sizeof(iec_patch_4), iec_patch_4);
-    apply_patch(!emul_1541_proc, Kernal, BuiltinKernalROM, 0x0def,
-                sizeof(iec_patch_5), iec_patch_5);
-    apply_patch(!emul_1541_proc, Kernal, BuiltinKernalROM, 0x0dbe,
-                sizeof(iec_patch_6), iec_patch_6);
-    apply_patch(!emul_1541_proc, Kernal, BuiltinKernalROM, 0x0dcc,
-                sizeof(iec_patch_7), iec_patch_7);
-    apply_patch(!emul_1541_proc, Kernal, BuiltinKernalROM, 0x0e03,
-                sizeof(iec_patch_8), iec_patch_8);
-
-    // 1541 patches - skip ROM checksum
-    static const uint8_t drive_patch_1[] = { 0xea, 0xea };
-    static const uint8_t drive_patch_2[] = { 0xf2, 0x00 };
-
-    apply_patch(true, ROM1541, BuiltinDriveROM, 0x2ae4,
-                sizeof(drive_patch_1), drive_patch_1);
-    apply_patch(true, ROM1541, BuiltinDriveROM, 0x2ae8,
-                sizeof(drive_patch_1), drive_patch_1);
-    apply_patch(true, ROM1541, BuiltinDriveROM, 0x2c9b,
-                sizeof(drive_patch_2), drive_patch_2);
-    FIL f;
-    f_open(&f, "/c64_fast_reset.rom", FA_CREATE_ALWAYS | FA_WRITE);
-    UINT bw;
-    f_write(&f, Kernal, KERNAL_ROM_SIZE, &bw);
-    f_close(&f);
-*/
+    // The CPU may have predecoded the old bytes
+    TheCPU->FlushBlockCache();
 }
 
 
@@ -261,6 +246,7 @@ void C64::patch_roms(bool fast_reset, bool emul_1541_proc)
 
 void C64::Reset(bool clear_memory)
 {
+    TheCPU1541->Sync();
     TheCPU->AsyncReset();
     TheCPU1541->AsyncReset();
     TheGCRDisk->Reset();
@@ -270,6 +256,11 @@ void C64::Reset(bool clear_memory)
     TheIEC->Reset();
     TheCart->Reset();
 
+#if SID_CAPTURE
+    // Each reset starts a new log
+    sid_capture_start(ThePrefs.SIDType, ThePrefs.SID2Address, ThePrefs.SID3Address);
+#endif
+
     if (clear_memory) {
         init_memory();
     }
@@ -284,7 +275,6 @@ void C64::Reset(bool clear_memory)
 
 void C64::ResetAndAutoStart()
 {
-//    patch_roms(ThePrefs.FastReset, ThePrefs.Emul1541Proc);
     Reset(true);
 }
 
@@ -308,11 +298,22 @@ void C64::NewPrefs(const Prefs *prefs)
     MII_DEBUG_PRINTF("NewPrefs: Emul1541Proc changing from %d to %d\n",
            ThePrefs.Emul1541Proc, prefs->Emul1541Proc);
 
+    // The drive must not run on the second core while its setup changes
+    TheCPU1541->Sync();
+
     TheDisplay->NewPrefs(prefs);
     TheIEC->NewPrefs(prefs);
     TheGCRDisk->NewPrefs(prefs);
     TheSID->NewPrefs(prefs);
 
+    if (ThePrefs.SID2Address != prefs->SID2Address || ThePrefs.SID3Address != prefs->SID3Address) {
+        TheCPU->SetChips(TheVIC, TheSID, TheCIA1, TheCIA2, TheCart, TheIEC, TheTape);
+    }
+
+    if (ThePrefs.FastReset != prefs->FastReset || ThePrefs.Emul1541Proc != prefs->Emul1541Proc) {
+        patch_roms(prefs->FastReset, prefs->Emul1541Proc);
+    }
+
     if (ThePrefs.Emul1541Proc != prefs->Emul1541Proc) {
         MII_DEBUG_PRINTF("NewPrefs: Resetting 1541 CPU\n");
         TheCPU1541->AsyncReset();
@@ -516,6 +517,43 @@ const char *StringForKeycode(unsigned kc) { return ""; }
 bool IsSnapshotFile(const char *filename) { return false; }
 
 
+//=============================================================================
+// Frame profiler
+//=============================================================================
+
+#if C64_PROFILE
+static c64_profile_t g_profile;
+static bool g_profile_overlay = true;
+
+// SysTick counts down at the CPU clock and wraps at 24 bits
+static inline uint32_t profile_ticks()
+{
+    return systick_hw->cvr;
+}
+
+static inline uint32_t profile_elapsed(uint32_t &since)
+{
+    uint32_t now = profile_ticks();
+    uint32_t d = (since - now) & 0x00ffffff;
+    since = now;
+    return d;
+}
+
+static void profile_init()
+{
+    systick_hw->rvr = 0x00ffffff;
+    systick_hw->csr = 0x5;		// Enable, processor clock, no interrupt
+    memset(&g_profile, 0, sizeof(g_profile));
+    g_profile.clock_mhz = CPU_CLOCK_MHZ;
+}
+
+#define PROFILE_CHIP(prof, line_cycles, t, id) \
+    do { uint32_t d = profile_elapsed(t); (prof).chip[id] += d; line_cycles += d; } while (0)
+#else
+#define PROFILE_CHIP(prof, line_cycles, t, id) do { } while (0)
+#endif
+
+
 //=============================================================================
 // C Interface Functions (called from main_rp2350.c)
 //=============================================================================
@@ -541,6 +579,14 @@ void c64_init(void)
     TheC64->TheCPU1541->Reset();
     TheC64->TheGCRDisk->Reset();
 
+#if SID_CAPTURE
+    sid_capture_start(ThePrefs.SIDType, ThePrefs.SID2Address, ThePrefs.SID3Address);
+#endif
+
+#if C64_PROFILE
+    profile_init();
+#endif
+
     MII_DEBUG_PRINTF("c64_init: C64 ready\n");
 }
 
@@ -579,6 +625,12 @@ bool c64_run_frame(void)
 
     C64 *c64 = TheC64;
 
+#if C64_PROFILE
+    uint32_t frame_start = profile_ticks();
+    uint32_t prof_t = frame_start;
+    c64_frame_profile_t prof = {};
+#endif
+
     // Poll input BEFORE frame emulation so games see current joystick state
     c64->TheCIA1->Joystick1 = 0xff;
     c64->TheCIA1->Joystick2 = 0xff;
@@ -603,35 +655,120 @@ bool c64_run_frame(void)
         //     watchdog_update();
         // }
 
+#if C64_PROFILE
+        uint32_t line_cycles = 0;
+        profile_elapsed(prof_t);
+#endif
+
         // Emulate one raster line
         int cycles_left = 0;
         unsigned vic_flags = c64->TheVIC->EmulateLine(cycles_left);
+        PROFILE_CHIP(prof, line_cycles, prof_t, C64_PROF_VIC);
 
         // SID emulation (audio samples)
         c64->TheSID->EmulateLine();
+        PROFILE_CHIP(prof, line_cycles, prof_t, C64_PROF_SID);
 
-#if !PRECISE_CIA_CYCLES
-        // CIA timers
-        c64->TheCIA1->EmulateLine(ThePrefs.CIACycles);
-        c64->TheCIA2->EmulateLine(ThePrefs.CIACycles);
-#endif
-
-        // CPU emulation
+#if PRECISE_CIA_CYCLES
+        // CPU emulation (counts the CIAs itself)
         // Frodo's $f2 opcode mechanism handles IEC traps internally
         c64->TheCPU->EmulateLine(cycles_left);
+        PROFILE_CHIP(prof, line_cycles, prof_t, C64_PROF_CPU);
+#else
+        // CPU emulation, interrupted by the CIA events due in this line.
+        // With PRECISE_CIA_IRQ the CPU runs up to the cycle of each event
+        // (CIA and CPU cycles are taken as equal, the VIC's stolen cycles
+        // as coming first), otherwise the events are handled at the
+        // start of the line. Frodo's $f2 opcode mechanism handles IEC
+        // traps internally.
+        Scheduler *sched = c64->TheScheduler;
+        uint32_t line_end = sched->Now() + ThePrefs.CIACycles;
+        for (;;) {
+            uint32_t next = sched->Next();
+            int32_t until_end = line_end - next;
+            if (until_end <= 0) {
+                break;
+            }
+#if PRECISE_CIA_IRQ
+            int run = cycles_left - until_end;
+            if (run > 0) {
+                // Register reads in this part see the timers just before the
+                // event (the clock may already be there, it never goes back)
+                if ((int32_t)(next - sched->Now()) > 1) {
+                    sched->Advance(next - 1 - sched->Now());
+                }
+                c64->TheCPU->EmulateLine(run, until_end);
+                cycles_left -= run;
+                PROFILE_CHIP(prof, line_cycles, prof_t, C64_PROF_CPU);
+            }
+#endif
+            sched->Advance(next - sched->Now());
+            if (sched->Due(EVENT_CIA1)) {
+                c64->TheCIA1->CountTo(next);
+                PROFILE_CHIP(prof, line_cycles, prof_t, C64_PROF_CIA1);
+            }
+            if (sched->Due(EVENT_CIA2)) {
+                c64->TheCIA2->CountTo(next);
+                PROFILE_CHIP(prof, line_cycles, prof_t, C64_PROF_CIA2);
+            }
+            if (sched->Due(EVENT_TOD)) {
+                c64->TheCIA1->CountTOD();
+                c64->TheCIA2->CountTOD();
+                sched->Schedule(EVENT_TOD, next + ThePrefs.CIACycles * TOTAL_RASTERS);
+            }
+        }
+        sched->Advance(line_end - sched->Now());
+        c64->TheCPU->EmulateLine(cycles_left);
+        PROFILE_CHIP(prof, line_cycles, prof_t, C64_PROF_CPU);
+#endif
         c64->cycle_counter += CYCLES_PER_LINE;
 
+        // 1541 processor up to the end of the line (or hand it to the
+        // second core)
+        c64->TheCPU1541->AdvanceTo(c64->cycle_counter);
+        PROFILE_CHIP(prof, line_cycles, prof_t, C64_PROF_1541);
+
+#if C64_PROFILE
+        if (line_cycles > prof.worst_line_cycles) {
+            prof.worst_line_cycles = line_cycles;
+            prof.worst_line = line_count;
+        }
+        if (line_count < C64_PROFILE_LINES && line_cycles > g_profile.line_worst[line_count]) {
+            g_profile.line_worst[line_count] = line_cycles;
+        }
+#endif
+
         line_count++;
 
         // Check for VBlank (end of frame)
         if (vic_flags & VIC_VBLANK) {
             frame_complete = true;
 
+#if PRECISE_CIA_CYCLES
             // Count TOD clocks
             c64->TheCIA1->CountTOD();
             c64->TheCIA2->CountTOD();
+#endif
         }
     }
+
+#if C64_PROFILE
+    prof.frame = g_profile.count;
+    prof.lines = line_count;
+    prof.total = (frame_start - profile_ticks()) & 0x00ffffff;
+    g_profile.frames[g_profile.count % C64_PROFILE_FRAMES] = prof;
+    g_profile.count++;
+#endif
+
+#if SID_CAPTURE
+    sid_capture_flush();
+#endif
+
+    // Let the rendering core finish the frame before drawing on it
+    c64->TheVIC->WaitRendered();
+
+    // Draw status overlays on top of the finished frame
+    c64->TheDisplay->Update();
 #if 0
     // Debug: warn if we hit the safety limit
     if (line_count >= MAX_LINES_PER_FRAME) {
@@ -656,6 +793,93 @@ bool c64_run_frame(void)
 }
 
 
+/*
+ *  Draw the raster lines queued by c64_run_frame() (VIC_RENDER_QUEUE > 0),
+ *  called in a loop by the second core
+ */
+void c64_render_lines(void)
+{
+    if (TheC64) {
+        TheC64->TheVIC->RenderLines();
+    }
+}
+
+
+/*
+ *  Render the SID register writes queued by c64_run_frame() into the audio
+ *  ring buffer (SID_WRITE_QUEUE > 0), called in a loop by the second core
+ */
+void c64_render_audio(void)
+{
+    if (TheC64) {
+        TheC64->TheSID->RenderQueued();
+    }
+}
+
+
+/*
+ *  Emulate the 1541 processor as far as c64_run_frame() allows
+ *  (DRIVE_IEC_QUEUE > 0), called in a loop by the second core
+ */
+void c64_run_drive(void)
+{
+#if DRIVE_IEC_QUEUE
+    if (TheC64) {
+        TheC64->TheCPU1541->RunQueued();
+    }
+#endif
+}
+
+
+/*
+ *  Frame profiler access
+ */
+const c64_profile_t *c64_get_profile(void)
+{
+#if C64_PROFILE
+    return &g_profile;
+#else
+    return nullptr;
+#endif
+}
+
+void c64_reset_profile(void)
+{
+#if C64_PROFILE
+    profile_init();
+#endif
+}
+
+void c64_set_profile_overlay(bool enable)
+{
+#if C64_PROFILE
+    g_profile_overlay = enable;
+#else
+    (void)enable;
+#endif
+}
+
+bool c64_get_profile_overlay(void)
+{
+#if C64_PROFILE
+    return g_profile_overlay;
+#else
+    return false;
+#endif
+}
+
+
+/*
+ *  Set speedometer value (percent of real time)
+ */
+void c64_set_speedometer(int speed)
+{
+    if (g_display) {
+        g_display->SetSpeedometer(speed);
+    }
+}
+
+
 /*
  *  Get pointer to VIC framebuffer
  */
@@ -700,8 +924,8 @@ void c64_show_notification(const char *msg)
 
 
 /*
- *  Mount a disk image using DOS-level IEC emulation
- *  This uses Frodo's built-in IEC class with ImageDrive
+ *  Mount a disk image, with the 1541 processor emulation if enabled in
+ *  the preferences, else with Frodo's DOS-level IEC emulation (ImageDrive)
  */
 void c64_mount_disk(const uint8_t *data, uint32_t size, const char *filename)
 {
@@ -710,11 +934,9 @@ void c64_mount_disk(const uint8_t *data, uint32_t size, const char *filename)
 
     MII_DEBUG_PRINTF("c64_mount_disk: %s\n", filename);
 
-    // Use Frodo's built-in DOS-level IEC emulation
-    // false = DOS-level emulation (not processor-level 1541)
-    TheC64->MountDrive8(false, filename);
+    TheC64->MountDrive8(ThePrefs.Emul1541Proc, filename);
 
-    MII_DEBUG_PRINTF("c64_mount_disk: mounted via Frodo IEC (Emul1541Proc=%d)\n",
+    MII_DEBUG_PRINTF("c64_mount_disk: mounted (Emul1541Proc=%d)\n",
            ThePrefs.Emul1541Proc);
 }
 
@@ -778,6 +1000,9 @@ bool c64_load_prg_from_file(FIL *file)
         remaining -= chunk;
     }
 
+    // Loaded code must not run from stale predecoded blocks
+    TheC64->TheCPU->FlushBlockCache();
+
     // 4. BASIC pointers if $0801
     if (load_addr == 0x0801) {
         uint16_t end_addr = load_addr + prg_size;
@@ -810,6 +1035,8 @@ void c64_type_string(const char *str)
         TheC64->RAM[0x0277 + i] = str[i];
     }
 
+    TheC64->TheCPU->FlushBlockCache();  // Page 2 may hold cached code
+
     // Set buffer length at $C6
     TheC64->RAM[0xC6] = len;
 
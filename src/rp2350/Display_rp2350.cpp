@@ -14,6 +14,8 @@
 
 #include "Display_rp2350.h"
 #include "../board_config.h"
+#include "c64_profile.h"
+#include "sid_i2s.h"
 
 extern "C" {
 #include "debug_log.h"
@@ -27,8 +29,19 @@ void input_rp2350_poll(uint8_t *key_matrix, uint8_t *rev_matrix, uint8_t *joysti
 bool disk_ui_is_visible(void);
 }
 
+#include <atomic>
 #include <cstring>
 
+#include "../MenuFont.h"
+
+// Notifications stay on screen for this long
+static const uint32_t NOTIFICATION_TIMEOUT_MS = 4000;
+
+// Overlay text colors
+static const uint8_t OVERLAY_SHADOW = 0;    // Black
+static const uint8_t OVERLAY_TEXT = 1;      // White
+static const uint8_t OVERLAY_WARN = 10;     // Light red
+
 // C64 Pepto color palette (same as murmc64)
 static const uint32_t pepto_palette[16] = {
     0xFF000000,  // 0 Black
@@ -76,19 +89,81 @@ static const uint32_t colodore_palette[16] = {
 extern "C" uint32_t __led_state;
 uint32_t __led_state = 0;
 static uint8_t* led_state = (uint8_t*)&__led_state; // Drive LED states
-// Allocate VIC pixel buffer in SRAM (384 x 272 = 104448 bytes)
-uint8_t g_pixels[DISPLAY_X * DISPLAY_Y];
-// Source: VIC buffer (384x272, 8-bit indexed color)
+#if DISPLAY_CROPPED
+static_assert(FRAME_LEFT == C64_CROP_LEFT && FRAME_TOP == C64_CROP_TOP &&
+              FRAME_X == FB_WIDTH && FRAME_Y == FB_HEIGHT,
+              "Frame buffers must hold the window shown by the video driver");
+#endif
+
+#if DISPLAY_BUFFERS > 1
+static_assert(DISPLAY_BUFFERS <= 3, "At most triple buffering is supported");
+
+// If no video refresh picks up a frame within this time, the emulation
+// stops waiting and draws into the visible buffer
+static const uint32_t SWAP_TIMEOUT_US = 50000;
+
+// Cropped frame buffers in SRAM (320 x 240 = 76800 bytes each)
+alignas(4) static uint8_t frame_buf[DISPLAY_BUFFERS][FRAME_X * FRAME_Y];
+
+static std::atomic<uint8_t> ready_buf(0);   // Newest completed frame
+static std::atomic<uint8_t> scan_buf(0);    // Frame shown by the video refresh
+static uint8_t back_buf = 1;                // Frame the VIC draws into
+static bool back_pending = false;           // back_buf was completed, get a new one
+static volatile uint32_t ready_time;        // time_us_32() when ready_buf was completed
+static DisplayFrameStats frame_stats;
+
+// Source: frame buffer (320x240, 8-bit indexed color), latched at the
+// start of each video refresh so that a refresh always shows one frame
+extern "C" uint8_t* __not_in_flash() graphics_get_buffer_line(int y) {
+    static int last_y = -1;
+    uint8_t s = scan_buf.load(std::memory_order_relaxed);
+    if (y == 0 && last_y != 0) {
+        uint8_t r = ready_buf.load(std::memory_order_acquire);
+        if (r != s) {
+            scan_buf.store(s = r, std::memory_order_release);
+            uint32_t age = time_us_32() - ready_time;
+            frame_stats.age_us = age;
+            if (age > frame_stats.max_age_us) {
+                frame_stats.max_age_us = age;
+            }
+            frame_stats.shown++;
+        } else {
+            frame_stats.repeated++;
+        }
+    }
+    last_y = y;
+    return frame_buf[s] + y * FRAME_X;
+}
+
+// Line of the frame on screen, for UI drawing while the emulation is stopped
+extern "C" uint8_t* display_get_screen_line(int y) {
+    return frame_buf[scan_buf.load(std::memory_order_relaxed)] + y * FRAME_X;
+}
+#else
+// Allocate VIC pixel buffer in SRAM (384 x 272 = 104448 bytes,
+// or 320 x 240 = 76800 bytes cropped)
+alignas(4) uint8_t g_pixels[FRAME_X * FRAME_Y];
+// Source: VIC buffer (8-bit indexed color)
 // Dest: HDMI framebuffer (320x240, 8-bit indexed color)
 extern "C" uint8_t* __not_in_flash() graphics_get_buffer_line(int y) {
-    return g_pixels + C64_CROP_LEFT + (y + C64_CROP_TOP) * DISPLAY_X;
+    return g_pixels + C64_CROP_LEFT - FRAME_LEFT + (y + C64_CROP_TOP - FRAME_TOP) * FRAME_X;
 }
 
+extern "C" uint8_t* display_get_screen_line(int y) {
+    return graphics_get_buffer_line(y);
+}
+#endif
+
 Display::Display(C64 * c64)
     : the_c64(c64), next_note(0), num_locked(false)
 {
+#if DISPLAY_BUFFERS > 1
+    memset(frame_buf, 0, sizeof(frame_buf));
+    vic_pixels = frame_buf[back_buf];
+#else
     vic_pixels = g_pixels;
-    memset(vic_pixels, 0, DISPLAY_X * DISPLAY_Y);
+    memset(vic_pixels, 0, sizeof(g_pixels));
+#endif
 
     // Initialize LED states
     for (int i = 0; i < 4; i++) {
@@ -106,7 +181,7 @@ Display::Display(C64 * c64)
     // Initialize color palette
     init_colors(PALETTE_PEPTO);
 
-    MII_DEBUG_PRINTF("Display initialized: %dx%d\n", DISPLAY_X, DISPLAY_Y);
+    MII_DEBUG_PRINTF("Display initialized: %dx%d\n", FRAME_X, FRAME_Y);
 }
 
 
@@ -170,11 +245,38 @@ void Display::NewPrefs(const Prefs *prefs)
 
 
 /*
- *  Return pointer to bitmap data ("active" VIC buffer)
+ *  Return pointer to bitmap data ("active" VIC buffer), called by the VIC
+ *  at the start of each frame
  */
 
 uint8_t * Display::BitmapBase()
 {
+#if DISPLAY_BUFFERS == 2
+    if (back_pending) {
+        // The other buffer is free when the video refresh has picked up
+        // the frame completed last
+        uint8_t done = back_buf;
+        uint32_t start = time_us_32();
+        while (scan_buf.load(std::memory_order_acquire) != done) {
+            if (time_us_32() - start > SWAP_TIMEOUT_US) {
+                break;
+            }
+        }
+        frame_stats.wait_us += time_us_32() - start;
+        back_buf = done ^ 1;
+        vic_pixels = frame_buf[back_buf];
+        back_pending = false;
+    }
+#elif DISPLAY_BUFFERS == 3
+    if (back_pending) {
+        // Use the buffer that is neither shown nor waiting to be shown
+        uint8_t done = back_buf;
+        uint8_t s = scan_buf.load(std::memory_order_acquire);
+        back_buf = (s == done) ? (done + 1) % 3 : 3 - s - done;
+        vic_pixels = frame_buf[back_buf];
+        back_pending = false;
+    }
+#endif
     return vic_pixels;
 }
 
@@ -185,7 +287,58 @@ uint8_t * Display::BitmapBase()
 
 int Display::BitmapXMod()
 {
-    return DISPLAY_X;
+    return FRAME_X;
+}
+
+
+#if DISPLAY_BUFFERS > 1
+/*
+ *  Hand the completed back buffer to the video refresh
+ *  (the VIC gets a new one in BitmapBase())
+ */
+
+void Display::swap_buffers()
+{
+    uint8_t prev = ready_buf.load(std::memory_order_relaxed);
+    ready_time = time_us_32();
+    ready_buf.store(back_buf, std::memory_order_release);
+    frame_stats.completed++;
+
+    // Previous frame never picked up?
+    if (scan_buf.load(std::memory_order_acquire) != prev) {
+        frame_stats.dropped++;
+    }
+    back_pending = true;
+}
+#endif
+
+
+/*
+ *  Return the last completed frame (FRAME_X x FRAME_Y)
+ */
+
+uint8_t * Display::GetFramebuffer()
+{
+#if DISPLAY_BUFFERS > 1
+    return frame_buf[ready_buf.load(std::memory_order_relaxed)];
+#else
+    return vic_pixels;
+#endif
+}
+
+
+/*
+ *  Return frame buffer statistics (all zero with a single buffer)
+ */
+
+const DisplayFrameStats & Display::GetFrameStats() const
+{
+#if DISPLAY_BUFFERS > 1
+    return frame_stats;
+#else
+    static const DisplayFrameStats no_stats = {};
+    return no_stats;
+#endif
 }
 
 
@@ -220,60 +373,179 @@ void Display::scale_to_hdmi()
 
 
 /*
- *  Draw overlays (LEDs, speedometer, notifications)
+ *  Draw overlays (notifications, speedometer, profiler) into the visible
+ *  part of the VIC buffer
  */
 
 void Display::draw_overlays()
 {
-#if 0
-    if (!current_framebuffer) return;
-    // Draw drive LEDs in top-right corner
-    if (led_state[0] || led_state[1]) {
-        // Simple LED indicator - draw a small rectangle
-        int led_x = FB_WIDTH - 20;
-        int led_y = 5;
-
-        for (int dy = 0; dy < 6; dy++) {
-            for (int dx = 0; dx < 12; dx++) {
-                int idx = (led_y + dy) * FB_WIDTH + (led_x + dx);
-                if (led_state[0] > 0) {
-                    current_framebuffer[idx] = 5;  // Green for drive activity
-                } else if (led_state[0] < 0) {
-                    current_framebuffer[idx] = 2;  // Red for error
-                }
-            }
-        }
-    }
+    const unsigned left = C64_CROP_LEFT + 4;
+    const unsigned bottom = C64_CROP_TOP + FB_HEIGHT - 10;
 
-    // Draw notifications
+    // Notifications
     uint32_t now = to_ms_since_boot(get_absolute_time());
-    for (unsigned i = 0; i < NUM_NOTIFICATIONS; i++) {
+    unsigned i = next_note;
+    unsigned y_pos = C64_CROP_TOP + 3;
+    do {
         if (notes[i].active) {
-            // Check if notification has expired (3 seconds)
-            if (now - notes[i].time > 3000) {
+            if (now - notes[i].time > NOTIFICATION_TIMEOUT_MS) {
                 notes[i].active = false;
-                continue;
+            } else {
+                draw_string_shadow(left, y_pos, notes[i].text, OVERLAY_TEXT);
+                y_pos += 8;
             }
+        }
+        i = (i + 1) % NUM_NOTIFICATIONS;
+    } while (i != next_note);
 
-            // Draw notification text at bottom of screen
-            // (simplified - just mark area with a color)
-            int note_y = FB_HEIGHT - 20 - i * 10;
-            for (int dx = 0; dx < FB_WIDTH - 20; dx++) {
-                int idx = note_y * FB_WIDTH + 10 + dx;
-                current_framebuffer[idx] = 0;  // Black background
-            }
+    if (!ThePrefs.ShowLEDs) {
+        return;
+    }
+
+    // Speedometer (only shown when below 100%)
+    if (speedometer_string[0]) {
+        draw_string_shadow(C64_CROP_LEFT + FB_WIDTH - 36, bottom, speedometer_string, OVERLAY_WARN);
+    }
+
+#if C64_PROFILE
+    if (c64_get_profile_overlay()) {
+        draw_audio_stats(left, bottom - 18);
+        draw_profile(left, bottom - 9);
+    }
+#endif
+}
+
+
+#if C64_PROFILE
+/*
+ *  Draw profiler summary: average share of the 20 ms frame budget per chip
+ *  over the ring buffer, the peak frame and the worst raster line
+ */
+
+void Display::draw_profile(unsigned x, unsigned y)
+{
+    const c64_profile_t *p = c64_get_profile();
+    if (!p || p->count == 0) {
+        return;
+    }
+
+    unsigned n = p->count < C64_PROFILE_FRAMES ? p->count : C64_PROFILE_FRAMES;
+    uint64_t chip[C64_PROF_NUM] = {};
+    uint64_t total = 0;
+    uint32_t peak = 0;
+    uint32_t worst_cycles = 0;
+    unsigned worst_line = 0;
+    for (unsigned f = 0; f < n; ++f) {
+        const c64_frame_profile_t &fp = p->frames[f];
+        for (unsigned c = 0; c < C64_PROF_NUM; ++c) {
+            chip[c] += fp.chip[c];
+        }
+        total += fp.total;
+        if (fp.total > peak) {
+            peak = fp.total;
+        }
+        if (fp.worst_line_cycles > worst_cycles) {
+            worst_cycles = fp.worst_line_cycles;
+            worst_line = fp.worst_line;
         }
     }
+
+    // Percent of the PAL frame budget (20000 us)
+    uint64_t budget = (uint64_t)p->clock_mhz * 20000 * n;
+    auto pct = [budget](uint64_t cycles) { return (unsigned)(cycles * 100 / budget); };
+    unsigned peak_pct = (unsigned)((uint64_t)peak * 100 / ((uint64_t)p->clock_mhz * 20000));
+
+    char str[64];
+    snprintf(str, sizeof(str), "VIC %u SID %u CIA %u CPU %u = %u%%",
+             pct(chip[C64_PROF_VIC]), pct(chip[C64_PROF_SID]),
+             pct(chip[C64_PROF_CIA1] + chip[C64_PROF_CIA2]), pct(chip[C64_PROF_CPU]),
+             pct(total));
+    draw_string_shadow(x, y, str, OVERLAY_TEXT);
+
+    snprintf(str, sizeof(str), "Peak %u%%  Line %u: %u us  1541 %u",
+             peak_pct, worst_line, (unsigned)(worst_cycles / p->clock_mhz),
+             pct(chip[C64_PROF_1541]));
+    draw_string_shadow(x, y + 9, str, peak_pct >= 100 ? OVERLAY_WARN : OVERLAY_TEXT);
+}
+
+
+/*
+ *  Draw audio ring fill (current, range), SID rate correction and the
+ *  number of under-/overruns
+ */
+
+void Display::draw_audio_stats(unsigned x, unsigned y)
+{
+    sid_audio_stats_t st;
+    sid_get_audio_stats(&st);
+
+    char str[64];
+    snprintf(str, sizeof(str), "Aud %u %u-%u %+dppm U%u O%u",
+             (unsigned)st.fill, (unsigned)(st.fill_min <= st.fill_max ? st.fill_min : 0),
+             (unsigned)st.fill_max, (int)st.rate_ppm, (unsigned)st.underruns, (unsigned)st.overruns);
+    draw_string_shadow(x, y, str, st.underruns || st.overruns ? OVERLAY_WARN : OVERLAY_TEXT);
+}
 #endif
+
+
+/*
+ *  Draw string into the VIC buffer using the Frodo menu font
+ */
+
+void Display::draw_string(unsigned x, unsigned y, const char *str, uint8_t front_color) const
+{
+    uint8_t *row = vic_pixels + FRAME_X * (y - FRAME_TOP);
+    uint8_t *pb = row + x - FRAME_LEFT;
+    uint8_t *end = row + FRAME_X;
+
+    unsigned char c;
+    while ((c = *str++) != 0) {
+        if (c >= 0x80) {
+            c = 0x7f;   // Replacement character
+        }
+        if (pb + menu_char_width[c] > end) {
+            break;      // Clip at the right edge
+        }
+        const uint8_t *q = menu_font + c * 8;
+        uint8_t *p = pb;
+        for (unsigned row = 0; row < 8; row++) {
+            uint8_t v = *q++;
+            for (unsigned col = 0; col < menu_char_width[c]; ++col) {
+                if (v & 0x80) {
+                    p[col] = front_color;
+                }
+                v <<= 1;
+            }
+            p += FRAME_X;
+        }
+        pb += menu_char_width[c];
+    }
 }
 
 
 /*
- *  Update display - copy VIC buffer to HDMI framebuffer
+ *  Draw string with a one-pixel black drop shadow
+ */
+
+void Display::draw_string_shadow(unsigned x, unsigned y, const char *str, uint8_t front_color) const
+{
+    draw_string(x + 1, y + 1, str, OVERLAY_SHADOW);
+    draw_string(x, y, str, front_color);
+}
+
+
+/*
+ *  Update display - draw overlays on top of the finished frame
+ *  (with a single buffer it is scanned out directly by the video driver,
+ *  otherwise it is queued for the next video refresh)
  */
 
 void Display::Update()
 {
+    draw_overlays();
+#if DISPLAY_BUFFERS > 1
+    swap_buffers();
+#endif
 }
 
 
@@ -296,6 +568,13 @@ void Display::SetLEDs(int l0, int l1, int l2, int l3)
 
 void Display::SetSpeedometer(int speed)
 {
+    // Update twice per second so the value stays readable
+    static int delay = 0;
+    if (++delay < 25) {
+        return;
+    }
+    delay = 0;
+
     // Format speedometer string
     if (speed >= 100) {
         // At or above 100%, don't show
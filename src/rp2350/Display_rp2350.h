@@ -29,10 +29,55 @@ constexpr unsigned NUM_NOTIFICATIONS = 3;
 constexpr unsigned NOTIFICATION_LENGTH = 46;
 #endif
 
+// Number of frame buffers. With 1 the VIC draws into the buffer being
+// scanned out. With 2 or 3 it draws into a back buffer which becomes
+// visible at the next video refresh after the C64 VBlank; 2 buffers may
+// make the emulation wait for that refresh, 3 never wait but can drop
+// frames when the emulation runs ahead of the display.
+#ifndef DISPLAY_BUFFERS
+#define DISPLAY_BUFFERS 1
+#endif
+
+// Part of the VIC output (DISPLAY_X x DISPLAY_Y) kept in a frame buffer.
+// When cropped, only the 320x240 window shown by the video driver (FB_WIDTH
+// x FB_HEIGHT at C64_CROP_LEFT/C64_CROP_TOP in board_config.h) is drawn.
+// Multiple buffers are always cropped.
+#ifndef DISPLAY_CROPPED
+#define DISPLAY_CROPPED (DISPLAY_BUFFERS > 1)
+#endif
+
+#if DISPLAY_BUFFERS > 1 && !DISPLAY_CROPPED
+#error "Multiple frame buffers need DISPLAY_CROPPED"
+#endif
+
+#if DISPLAY_CROPPED
+constexpr unsigned FRAME_LEFT = 32;
+constexpr unsigned FRAME_TOP = 16;
+constexpr unsigned FRAME_X = 320;
+constexpr unsigned FRAME_Y = 240;
+#else
+constexpr unsigned FRAME_LEFT = 0;
+constexpr unsigned FRAME_TOP = 0;
+constexpr unsigned FRAME_X = DISPLAY_X;
+constexpr unsigned FRAME_Y = DISPLAY_Y;
+#endif
+
 
 class C64;
 
 
+// Frame buffer statistics (DISPLAY_BUFFERS > 1)
+struct DisplayFrameStats {
+    uint32_t completed;                 // Frames finished by the emulation
+    uint32_t shown;                     // Frames picked up by the video refresh
+    uint32_t dropped;                   // Frames replaced by a newer one before being shown
+    uint32_t repeated;                  // Video refreshes that showed the previous frame again
+    uint32_t age_us;                    // Time from completion to display, last frame
+    uint32_t max_age_us;                // Highest age_us seen
+    uint32_t wait_us;                   // Time the emulation waited for a free buffer
+};
+
+
 // Class for C64 graphics display on RP2350
 class Display {
 public:
@@ -56,17 +101,27 @@ public:
     void PollKeyboard(uint8_t *key_matrix, uint8_t *rev_matrix, uint8_t *joystick);
     bool NumLock();
 
-    // RP2350-specific: Get framebuffer for HDMI output
-    uint8_t * GetFramebuffer() { return vic_pixels; }
+    // RP2350-specific: Get the last completed frame (FRAME_X x FRAME_Y)
+    uint8_t * GetFramebuffer();
+    const DisplayFrameStats & GetFrameStats() const;
 
 private:
     void init_colors(int palette_prefs);
     void draw_overlays();
+#if C64_PROFILE
+    void draw_profile(unsigned x, unsigned y);
+    void draw_audio_stats(unsigned x, unsigned y);
+#endif
+    void draw_string(unsigned x, unsigned y, const char *str, uint8_t front_color) const;
+    void draw_string_shadow(unsigned x, unsigned y, const char *str, uint8_t front_color) const;
     void scale_to_hdmi();
+#if DISPLAY_BUFFERS > 1
+    void swap_buffers();
+#endif
 
     C64 * the_c64;                      // Pointer to C64 object
 
-    uint8_t * vic_pixels;               // Buffer for VIC to draw into (DISPLAY_X * DISPLAY_Y)
+    uint8_t * vic_pixels;               // Buffer for VIC to draw into (FRAME_X * FRAME_Y)
     uint32_t palette[16];               // C64 color palette (ARGB)
 
     char speedometer_string[16];        // Speedometer text
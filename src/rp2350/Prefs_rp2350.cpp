@@ -15,6 +15,19 @@
 
 #include "Prefs_rp2350.h"
 
+// Extra SIDs (build options, 0 = not fitted)
+#ifndef SID2_ADDRESS
+#define SID2_ADDRESS 0
+#endif
+#ifndef SID3_ADDRESS
+#define SID3_ADDRESS 0
+#endif
+
+// Band-limited SID oscillators (build option)
+#ifndef SID_BAND_LIMIT
+#define SID_BAND_LIMIT 0
+#endif
+
 // Global preferences instance
 Prefs ThePrefs;
 
@@ -40,6 +53,13 @@ Prefs::Prefs()
     // SID type - digital 6581 emulation
     SIDType = SIDTYPE_DIGITAL_6581;
 
+    // Extra SIDs for stereo tunes; the first SID left, the second right
+    SID2Address = SID2_ADDRESS;
+    SID3Address = SID3_ADDRESS;
+    SIDPan[0] = -12;
+    SIDPan[1] = 12;
+    SIDPan[2] = 0;
+
     // No RAM expansion by default (save memory)
     REUType = REU_NONE;
 
@@ -73,9 +93,22 @@ Prefs::Prefs()
     // Map slash in filenames
     MapSlash = true;
 
-    // Use IEC emulation, not processor-level 1541
-    // (processor-level is too CPU intensive for RP2350)
+    // Processor-level 1541 (fast loaders work) when it has core 1 to
+    // itself, otherwise IEC emulation (too CPU intensive next to the 6510)
+#if DRIVE_IEC_QUEUE
+    Emul1541Proc = true;
+#else
     Emul1541Proc = false;
+#endif
+
+    // Skip idle loops (raster waits, JMP *), output is unchanged
+    SkipIdleLoops = true;
+
+    // Render SID audio in blocks, output is unchanged
+    SIDBlockRender = true;
+
+    // Band-limited oscillators (less aliasing of high notes)
+    SIDBandLimit = SID_BAND_LIMIT;
 
     // Show LEDs (drive activity)
     ShowLEDs = true;
@@ -108,6 +141,15 @@ Prefs::Prefs()
  *  Check - Validate preferences
  */
 
+// Extra SIDs sit at a 32-byte boundary in $d420..$d7e0 or $de00..$dfe0
+static bool valid_sid_address(int adr)
+{
+    if (adr == 0) {
+        return true;
+    }
+    return (adr & 0x1f) == 0 && ((adr > 0xd400 && adr < 0xd800) || (adr >= 0xde00 && adr < 0xe000));
+}
+
 void Prefs::Check()
 {
     // Ensure sane values
@@ -115,6 +157,12 @@ void Prefs::Check()
     if (BadLineCycles < 1) BadLineCycles = 23;
     if (CIACycles < 1) CIACycles = 63;
     if (FloppyCycles < 1) FloppyCycles = 64;
+
+    if (!valid_sid_address(SID2Address)) SID2Address = 0;
+    if (!valid_sid_address(SID3Address) || SID3Address == SID2Address) SID3Address = 0;
+    for (int &pan : SIDPan) {
+        if (pan < -16 || pan > 16) pan = 0;
+    }
 }
 
 
@@ -86,6 +86,9 @@ public:
     std::string TapePath;       // Path for drive 1
 
     int SIDType;                // SID emulation type
+    int SID2Address;            // Address of a second SID ($d420..$d7e0, $de00..$dfe0; 0 = none)
+    int SID3Address;            // Address of a third SID (0 = none)
+    int SIDPan[3];              // Stereo position of each SID, -16 (left) .. 16 (right)
     int REUType;                // Type of RAM expansion
     int DisplayType;            // Display type (windowed or full-screen)
     int Palette;                // Color palette to use
@@ -104,12 +107,21 @@ public:
     bool CIAIRQHack;            // Write to CIA ICR clears IRQ
     bool MapSlash;              // Map '/' in C64 filenames
     bool Emul1541Proc;          // Enable processor-level 1541 emulation
+    bool SkipIdleLoops;         // Fast-forward 6510 idle loops to the end of the line
+    bool SIDBlockRender;        // Render SID samples in per-voice blocks
+    bool SIDBandLimit;          // Band-limited saw, pulse and triangle waveforms
     bool ShowLEDs;              // Show status bar
     bool AutoStart;             // Auto-start from drive 8 after reset
     bool TestBench;             // Enable features for automatic regression tests
 
     std::string LoadProgram;    // BASIC program file to load
+
+    // Same layout as the Prefs class in ../Prefs.h, which the other
+    // modules see (unused here)
+    std::map<std::string, ROMPaths> ROMSetDefs;
     std::string ROMSet;         // Name of selected ROM set
+
+    std::map<std::string, ButtonMapping> ButtonMapDefs;
     std::string ButtonMap;      // Name of selected controller button mapping
     std::string CartridgePath;  // Path for cartridge image file
     std::string TestScreenshotPath; // Path for test screenshot
@@ -1042,8 +1042,7 @@ const uint8_t BuiltinBasicROM[BASIC_ROM_SIZE] __aligned(4) = {
  0x90, 0x03, 0x20, 0x23, 0xbc, 0x4c, 0x00, 0xe0
 };
 
-// Kernal ROM
-/*
+// Kernal ROM, unpatched (c64_fast_reset.rom.h has the patches applied)
 const uint8_t BuiltinKernalROM[KERNAL_ROM_SIZE] = {
  0x85, 0x56, 0x20, 0x0f, 0xbc, 0xa5, 0x61, 0xc9,
  0x88, 0x90, 0x03, 0x20, 0xd4, 0xba, 0x20, 0xcc,
@@ -2070,7 +2069,7 @@ const uint8_t BuiltinKernalROM[KERNAL_ROM_SIZE] = {
  0x4c, 0x0a, 0xe5, 0x4c, 0x00, 0xe5, 0x52, 0x52,
  0x42, 0x59, 0x43, 0xfe, 0xe2, 0xfc, 0x48, 0xff
 };
-*/
+
 // Character ROM
 const uint8_t BuiltinCharROM[CHAR_ROM_SIZE] __aligned(4) = {
  0x3c, 0x66, 0x6e, 0x6e, 0x60, 0x62, 0x3c, 0x00,
@@ -21,6 +21,7 @@
 // ROM declarations (defined in ROM_data.cpp)
 // Uses sizes from board_config.h
 extern const uint8_t BuiltinBasicROM[BASIC_ROM_SIZE];
+extern const uint8_t BuiltinKernalROM[KERNAL_ROM_SIZE];	// Unpatched, for restoring patched bytes
 extern const uint8_t BuiltinCharROM[CHAR_ROM_SIZE];
 
 #include "c64_1541.rom.h"
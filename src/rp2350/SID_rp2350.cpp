@@ -19,6 +19,8 @@
 #include "../Prefs.h"
 #include "../board_config.h"
 #include "debug_log.h"
+#include "sid_filter.h"
+#include "sid_i2s.h"
 
 // Map board_config.h names to Frodo names
 #ifndef SCREEN_FREQ
@@ -33,11 +35,13 @@ extern "C" {
 #include <cmath>
 #include <cstring>
 
-// Note: We don't use <complex> or <numbers> to reduce code size
-// Simple inline replacements for filter calculations
+#if SID_WRITE_QUEUE
+#include <atomic>
+#endif
 
-// Types for filter calculations (use float for RP2350 FPU)
-using filter_t = float;
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
 
 // SID waveforms
 enum {
@@ -52,8 +56,8 @@ enum {
     WAVE_NOISE
 };
 
-// Combined waveform tables
-#include "../SID_wave_tables.h"
+// Combined waveform tables, run-length coded
+#include "sid_wave_tables.h"
 
 // RP2350 Audio configuration
 constexpr int SAMPLE_FREQ = 44100;          // Target sample frequency
@@ -62,13 +66,50 @@ constexpr uint32_t SID_FREQ = 1022727;      // SID frequency (NTSC)
 #else
 constexpr uint32_t SID_FREQ = 985248;       // SID frequency (PAL)
 #endif
-constexpr size_t SAMPLE_BUF_SIZE = TOTAL_RASTERS * 2;  // Double buffered
 
-// External I2S interface (from sid_i2s.cpp)
-extern "C" {
-    void sid_add_sample(int16_t left, int16_t right);
-    int sid_get_buffer_fill(void);
-}
+// Oscillator increment per sample for a frequency register value, 16.16
+constexpr uint32_t SID_ADD_PER_FREQ = (uint32_t)(((uint64_t)SID_FREQ << 16) / SAMPLE_FREQ);
+
+// Samples rendered per voice in one pass of the block renderer; rendering
+// is deferred until a register write or until this many samples are due
+constexpr unsigned SID_BLOCK = 32;
+
+// $D418 writes waiting for the sample they fall in (power of two)
+constexpr unsigned SID_VOL_EVENTS = 64;
+
+// Write to $D418 (MODE/VOL), applied by mix_block() at the sample the
+// write falls in. Digi players write it several times per raster line.
+struct SIDVolEvent {
+    uint32_t sample;    // Sample number (sample_clock time)
+    uint8_t frac;       // Position within the sample, 1/256
+    uint8_t chip;
+    uint8_t mode_vol;
+};
+
+#if SID_WRITE_QUEUE
+// Register write or command queued for the rendering core
+struct SIDWrite {
+    uint8_t adr;        // SID register, or one of the SID_CMD_* values
+    uint8_t byte;       // Register value, or command argument
+    uint8_t cycle;      // Cycle within the raster line
+};
+
+enum {
+    SID_CMD_LINE = 0xfb,    // Start of the next raster line
+    SID_CMD_TYPE,           // byte = is6581
+    SID_CMD_CHIP,           // byte = chip | 0x80 if fitted, cycle = pan + 16
+    SID_CMD_RESET,          // Reset renderer state
+    SID_CMD_FLUSH           // Render the samples that are due
+};
+
+#if defined(FRODO_HOST)
+// Host build: the rendering thread may share the CPU with the emulation
+#include <thread>
+#define SID_WAIT() std::this_thread::yield()
+#else
+#define SID_WAIT()
+#endif
+#endif
 
 // Structure for one voice
 struct DRVoice {
@@ -79,6 +120,7 @@ struct DRVoice {
 
     uint32_t count;     // Phase accumulator, 8.16 fixed
     uint32_t add;       // Added to accumulator each sample
+    uint32_t add_inv;   // (256 << 16) / add, for the band-limited waveforms
 
     uint16_t freq;      // SID frequency value
     uint16_t pw;        // SID pulse-width value
@@ -97,6 +139,25 @@ struct DRVoice {
     bool sync;          // Sync modulation
 };
 
+// State of one emulated SID
+struct DRChip {
+    DRVoice voice[3];
+    uint32_t noise_seed;    // Noise generator shared by the voices
+
+    uint8_t mode_vol;       // MODE/VOL register
+    uint8_t res_filt;       // RES/FILT register
+    uint16_t volume;        // Master volume of the current sample, 4.8 fixed
+    uint16_t f_fc;          // Filter cutoff (11 bits)
+    uint8_t f_res;          // Filter resonance (4 bits)
+
+    SIDFilter filter;
+
+    bool fitted;            // Chip is mixed into the output
+    int pan;                // Stereo position, -16 (left) .. 16 (right)
+    int32_t gain_left;      // Gains in the stereo mix, 8.8 fixed
+    int32_t gain_right;
+};
+
 // Renderer class for RP2350
 class DigitalRenderer : public SIDRenderer {
 public:
@@ -106,47 +167,101 @@ public:
     void Reset() override;
     void EmulateLine() override;
     void WriteRegister(uint16_t adr, uint8_t byte) override;
+    void WriteRegisterAt(uint16_t adr, uint8_t byte, unsigned line_cycle) override;
     void NewPrefs(const Prefs *prefs) override;
     void Pause() override;
     void Resume() override;
+#if SID_WRITE_QUEUE
+    void RenderQueued() override;
+#endif
+    void WaitRendered() override;
 
 private:
-    void calc_filter();
+    void reset_state();
+    void reset_chip(DRChip &c);
+    void write_reg(uint16_t adr, uint8_t byte);
+    unsigned line_samples();
+    void start_line();
+    void write_at(uint16_t adr, uint8_t byte, unsigned line_cycle);
+    void add_vol_event(unsigned n, uint8_t byte, uint8_t frac);
+    void apply_vol_events();
+    void flush_samples();
+    void set_type(bool is6581);
+    void set_add(DRVoice &v);
+    void set_chip(unsigned n, bool fitted, int pan);
     void calc_samples(int count);
-    int16_t calc_single_sample();
+    void mix_block(sid_out_t *buf, unsigned count);
+    void mix_chips(sid_out_t *buf, unsigned count);
+    void calc_chip(DRChip &c, int32_t *out, unsigned count);
+    bool chip_idle(const DRChip &c) const;
+    bool voice_idle(const DRVoice &v) const;
+    void skip_wave(DRVoice &v, unsigned count);
+    int32_t calc_single_sample(DRChip &c);
+    int32_t mix_sample(DRChip &c, int32_t sum_output, int32_t sum_input_filter);
+    uint8_t noise_random(DRChip &c);
+
+    // Block renderer
+    bool block_possible(const DRChip &c) const;
+    void calc_block(DRChip &c, int32_t *out, unsigned count);
+    void calc_envelope(DRVoice *v, int16_t *env, unsigned count);
+    template <int WAVE, bool BAND_LIMIT> void calc_wave(DRChip &c, DRVoice *v, int16_t *out, unsigned count);
+
+    using WaveFunc = void (DigitalRenderer::*)(DRChip &c, DRVoice *v, int16_t *out, unsigned count);
+    static const WaveFunc wave_func[2][16];     // [band_limit][wave]
 
     bool ready;
     MOS6581 *the_sid;
 
-    uint8_t mode_vol;       // MODE/VOL register
-    uint8_t res_filt;       // RES/FILT register
-
     uint32_t sid_cycles_frac;   // SID cycles per sample (16.16)
 
-    DRVoice voice[3];
+    // The SID at $d400 and the extra SIDs, mixed in stereo if more than
+    // one is fitted
+    DRChip chip[SID_MAX_CHIPS];
+    bool stereo;
 
-    uint16_t f_fc;          // Filter cutoff (11 bits)
-    uint8_t f_res;          // Filter resonance (4 bits)
-
-    // Simplified IIR filter state (single-pole for RP2350)
-    filter_t lp_state;
-    filter_t hp_state;
-    filter_t bp_state;
-    filter_t filter_cutoff;
-    filter_t filter_resonance;
-
-    // Sample buffer for raster-synced playback
-    uint8_t sample_mode_vol[SAMPLE_BUF_SIZE];
-    uint8_t sample_res_filt[SAMPLE_BUF_SIZE];
-    unsigned sample_in_ptr;
+    SIDFilterCurve filter_curve;    // Filter tables for the current SID type
 
     // Fractional sample counting (16.16 fixed point)
     uint32_t samples_per_line_frac;  // Samples per line in 16.16 fixed point
     uint32_t sample_accum;           // Fractional sample accumulator
+    unsigned pending;                // Samples due but not rendered yet
+    uint32_t sample_clock;           // Samples rendered since the reset
+
+    unsigned line_total;    // Samples of the raster line being rendered
+    unsigned line_done;     // Samples of it already rendered or pending
+
+    // $D418 writes not reached by the rendering yet
+    SIDVolEvent vol_event[SID_VOL_EVENTS];
+    unsigned vol_event_head;
+    unsigned vol_event_tail;
 
     bool is6581;
+    int32_t dc_offset;  // DC offset of the voices and filter, scaled by the volume
+    bool band_limit;    // Prefs::SIDBandLimit, sampled for each block
+    int32_t out_gain;   // Volume applied to the output samples (1/65536), sampled for each write block
+
+    // Waveform outputs and envelopes of a block, voice j of sample i at
+    // [i][j], so two voices can be multiplied and summed with one SMLAD
+    // ([i][3] stays 0)
+    alignas(4) int16_t block_wave[SID_BLOCK][4];
+    alignas(4) int16_t block_env[SID_BLOCK][4];
+
+    // Output of one SID for a block before clamping, and the stereo mix
+    int32_t chip_out[SID_BLOCK];
+    int32_t mix_left[SID_BLOCK];
+    int32_t mix_right[SID_BLOCK];
+
+#if SID_WRITE_QUEUE
+    void push(uint8_t adr, uint8_t byte, uint8_t cycle);
+
+    SIDWrite write_queue[SID_WRITE_QUEUE];
+    std::atomic<unsigned> write_head;   // Entries queued by the emulation core
+    std::atomic<unsigned> write_tail;   // Entries processed by RenderQueued()
+#endif
 };
 
+static void build_band_limit_tables();
+
 // EG tables
 const int16_t MOS6581::EGDivTable[16] = {
     9, 32, 63, 95, 149, 220, 267, 313,
@@ -191,12 +306,25 @@ MOS6581::MOS6581()
         regs[i] = 0;
     }
 
-    // Open renderer
+    // Create the extra SIDs, then the renderer that mixes them all
+    set_extra_sids(&ThePrefs);
     open_close_renderer(SIDTYPE_NONE, ThePrefs.SIDType);
 }
 
+// Extra SID rendered as chip number 'chip' by the renderer of 'primary'
+MOS6581::MOS6581(MOS6581 *primary, unsigned chip)
+{
+    the_renderer = nullptr;
+    render_sid = primary;
+    chip_base = chip << 5;
+    Reset();
+}
+
 MOS6581::~MOS6581()
 {
+    for (MOS6581 *sid : extra_sid) {
+        delete sid;
+    }
     open_close_renderer(ThePrefs.SIDType, SIDTYPE_NONE);
 }
 
@@ -219,11 +347,18 @@ void MOS6581::Reset()
     if (the_renderer != nullptr) {
         the_renderer->Reset();
     }
+
+    for (MOS6581 *sid : extra_sid) {
+        if (sid != nullptr) {
+            sid->Reset();
+        }
+    }
 }
 
 void MOS6581::NewPrefs(const Prefs *prefs)
 {
     set_wave_tables(prefs->SIDType);
+    set_extra_sids(prefs);
     open_close_renderer(ThePrefs.SIDType, prefs->SIDType);
     if (the_renderer != nullptr) {
         the_renderer->NewPrefs(prefs);
@@ -244,18 +379,67 @@ void MOS6581::ResumeSound()
     }
 }
 
+/*
+ *  Combined waveform tables of the active SID type in SRAM (16 KB), shared
+ *  by all SIDs. Reading them from flash during sample generation competes
+ *  with the 6510 for the XIP cache; the run-length coded tables take 5.7 KB
+ *  of flash instead of the 64 KB of both types in 16-bit form.
+ */
+static uint8_t wave_tables[4][0x1000];
+static int wave_tables_type = SIDTYPE_NONE;
+
+uint32_t MOS6581::WaveTablesTime = 0;
+
+static void expand_wave_table(uint8_t *table, const uint8_t *rle)
+{
+    uint8_t *end = table + 0x1000;
+    while (table < end) {
+        unsigned len = *rle++;
+        memset(table, *rle++, len);
+        table += len;
+    }
+}
+
 void MOS6581::set_wave_tables(int sid_type)
 {
-    if (sid_type == SIDTYPE_DIGITAL_8580) {
-        TriSawTable = TriSawTable_8580;
-        TriRectTable = TriRectTable_8580;
-        SawRectTable = SawRectTable_8580;
-        TriSawRectTable = TriSawRectTable_8580;
-    } else {
-        TriSawTable = TriSawTable_6581;
-        TriRectTable = TriRectTable_6581;
-        SawRectTable = SawRectTable_6581;
-        TriSawRectTable = TriSawRectTable_6581;
+    bool is8580 = sid_type == SIDTYPE_DIGITAL_8580;
+    int table_type = is8580 ? SIDTYPE_DIGITAL_8580 : SIDTYPE_DIGITAL_6581;
+
+    if (table_type != wave_tables_type) {
+        uint64_t start = time_us_64();
+        expand_wave_table(wave_tables[0], is8580 ? TriSawRLE_8580 : TriSawRLE_6581);
+        expand_wave_table(wave_tables[1], is8580 ? TriRectRLE_8580 : TriRectRLE_6581);
+        expand_wave_table(wave_tables[2], is8580 ? SawRectRLE_8580 : SawRectRLE_6581);
+        expand_wave_table(wave_tables[3], is8580 ? TriSawRectRLE_8580 : TriSawRectRLE_6581);
+        WaveTablesTime = (uint32_t)(time_us_64() - start);
+        wave_tables_type = table_type;
+
+        MII_DEBUG_PRINTF("SID: %s wave tables expanded in %lu us, %u bytes SRAM\n",
+               is8580 ? "8580" : "6581", (unsigned long)WaveTablesTime, (unsigned)sizeof(wave_tables));
+    }
+
+    TriSawTable = wave_tables[0];
+    TriRectTable = wave_tables[1];
+    SawRectTable = wave_tables[2];
+    TriSawRectTable = wave_tables[3];
+}
+
+/*
+ *  Create or remove the extra SIDs for the addresses in the preferences
+ *  (the CPU maps them in MOS6510::SetChips())
+ */
+void MOS6581::set_extra_sids(const Prefs *prefs)
+{
+    const int adr[SID_MAX_CHIPS - 1] = { prefs->SID2Address, prefs->SID3Address };
+
+    for (unsigned i = 0; i < SID_MAX_CHIPS - 1; ++i) {
+        if (adr[i] == 0) {
+            delete extra_sid[i];
+            extra_sid[i] = nullptr;
+        } else if (extra_sid[i] == nullptr) {
+            extra_sid[i] = new MOS6581(this, i + 1);
+        }
+        extra_adr[i] = adr[i];
     }
 }
 
@@ -386,8 +570,21 @@ void MOS6581::open_close_renderer(int old_type, int new_type)
     }
 
     if (the_renderer != nullptr) {
-        for (unsigned i = 0; i < 25; ++i) {
-            the_renderer->WriteRegister(i, regs[i]);
+        write_renderer_regs();
+    }
+}
+
+// Send the registers of this SID and its extra SIDs to a new renderer
+void MOS6581::write_renderer_regs()
+{
+    for (unsigned i = 0; i < 25; ++i) {
+        the_renderer->WriteRegister(i, regs[i]);
+    }
+    for (const MOS6581 *sid : extra_sid) {
+        if (sid != nullptr) {
+            for (unsigned i = 0; i < 25; ++i) {
+                the_renderer->WriteRegister(sid->chip_base | i, sid->regs[i]);
+            }
         }
     }
 }
@@ -398,18 +595,30 @@ void MOS6581::open_close_renderer(int old_type, int new_type)
 DigitalRenderer::DigitalRenderer(MOS6581 *sid) : the_sid(sid)
 {
     // Link voices
-    voice[0].mod_by = &voice[2];
-    voice[1].mod_by = &voice[0];
-    voice[2].mod_by = &voice[1];
-    voice[0].mod_to = &voice[1];
-    voice[1].mod_to = &voice[2];
-    voice[2].mod_to = &voice[0];
-
-    Reset();
+    for (DRChip &c : chip) {
+        c.voice[0].mod_by = &c.voice[2];
+        c.voice[1].mod_by = &c.voice[0];
+        c.voice[2].mod_by = &c.voice[1];
+        c.voice[0].mod_to = &c.voice[1];
+        c.voice[1].mod_to = &c.voice[2];
+        c.voice[2].mod_to = &c.voice[0];
+        c.fitted = false;
+        c.pan = 0;
+    }
 
     // Calculate cycles per sample (16.16 fixed point)
     sid_cycles_frac = (uint32_t)((float)SID_FREQ / SAMPLE_FREQ * 65536.0f);
 
+    build_band_limit_tables();
+    band_limit = ThePrefs.SIDBandLimit;
+    out_gain = SID_OUT_UNITY;
+
+    reset_state();
+
+#if SID_WRITE_QUEUE
+    write_head = write_tail = 0;
+#endif
+
     // Samples per raster line (16.16 fixed point for accurate timing)
     // PAL: 44100 / (50 * 312) = 2.827 samples/line
     // NTSC: 44100 / (60 * 263) = 2.795 samples/line
@@ -419,7 +628,13 @@ DigitalRenderer::DigitalRenderer(MOS6581 *sid) : the_sid(sid)
     MII_DEBUG_PRINTF("SID: SCREEN_FREQ=%d, TOTAL_RASTERS=%d, samples_per_line=%.3f\n",
            SCREEN_FREQ, TOTAL_RASTERS, (float)samples_per_line_frac / 65536.0f);
 
-    is6581 = (ThePrefs.SIDType == SIDTYPE_DIGITAL_6581);
+    set_type(ThePrefs.SIDType == SIDTYPE_DIGITAL_6581);
+    set_chip(0, true, ThePrefs.SIDPan[0]);
+    set_chip(1, ThePrefs.SID2Address != 0, ThePrefs.SIDPan[1]);
+    set_chip(2, ThePrefs.SID3Address != 0, ThePrefs.SIDPan[2]);
+
+    memset(block_wave, 0, sizeof(block_wave));
+    memset(block_env, 0, sizeof(block_env));
 
     ready = true;
 }
@@ -430,14 +645,40 @@ DigitalRenderer::~DigitalRenderer()
 
 void DigitalRenderer::Reset()
 {
-    mode_vol = 0;
-    res_filt = 0;
+#if SID_WRITE_QUEUE
+    push(SID_CMD_RESET, 0, 0);
+#else
+    pending += line_total - line_done;
+    flush_samples();
+    reset_state();
+#endif
+}
+
+void DigitalRenderer::reset_state()
+{
+    for (DRChip &c : chip) {
+        reset_chip(c);
+    }
+
+    sample_accum = 0;
+    pending = 0;
+    sample_clock = 0;
+    line_total = line_done = 0;
+    vol_event_head = vol_event_tail = 0;
+}
+
+void DigitalRenderer::reset_chip(DRChip &c)
+{
+    c.mode_vol = 0;
+    c.res_filt = 0;
+    c.volume = 0;
 
+    DRVoice *voice = c.voice;
     for (unsigned v = 0; v < 3; ++v) {
         voice[v].wave = WAVE_NONE;
         voice[v].eg_state = EG_RELEASE;
         voice[v].count = 0x555555;
-        voice[v].add = 0;
+        voice[v].add = voice[v].add_inv = 0;
         voice[v].freq = voice[v].pw = 0;
         voice[v].eg_level = voice[v].s_level = 0;
         voice[v].a_add = voice[v].d_sub = voice[v].r_sub = sid_cycles_frac / MOS6581::EGDivTable[0];
@@ -445,16 +686,12 @@ void DigitalRenderer::Reset()
         voice[v].noise = 0x7ffff8;
     }
 
-    f_fc = f_res = 0;
-    lp_state = hp_state = bp_state = 0.0f;
-    filter_cutoff = 0.0f;
-    filter_resonance = 0.0f;
+    c.noise_seed = 1;
 
-    sample_in_ptr = 0;
-    memset(sample_mode_vol, 0, SAMPLE_BUF_SIZE);
-    memset(sample_res_filt, 0, SAMPLE_BUF_SIZE);
-
-    sample_accum = 0;
+    c.f_fc = c.f_res = 0;
+    c.filter.SetCurve(&filter_curve);
+    c.filter.SetRegs(c.f_fc, c.f_res);
+    c.filter.Reset();
 }
 
 void DigitalRenderer::Pause()
@@ -469,38 +706,51 @@ void DigitalRenderer::Resume()
 
 void DigitalRenderer::EmulateLine()
 {
-    // Record registers for sample playback
-    sample_mode_vol[sample_in_ptr] = mode_vol;
-    sample_res_filt[sample_in_ptr] = res_filt;
-    sample_in_ptr = (sample_in_ptr + 1) % SAMPLE_BUF_SIZE;
-
-    // Fractional sample counting: accumulate samples per line
-    // and generate the integer part, keeping fractional remainder
-    sample_accum += samples_per_line_frac;
-    unsigned samples_to_generate = sample_accum >> 16;  // Integer part
-    sample_accum &= 0xFFFF;  // Keep fractional part
-
-    if (samples_to_generate > 0) {
-        calc_samples(samples_to_generate);
-    }
+#if SID_WRITE_QUEUE
+    // The samples of the line are rendered by RenderQueued()
+    push(SID_CMD_LINE, 0, 0);
+#else
+    start_line();
+#endif
 }
 
 void DigitalRenderer::WriteRegister(uint16_t adr, uint8_t byte)
+{
+    WriteRegisterAt(adr, byte, 0);
+}
+
+void DigitalRenderer::WriteRegisterAt(uint16_t adr, uint8_t byte, unsigned line_cycle)
 {
     if (!ready)
         return;
 
-    unsigned v = adr / 7;
+#if SID_WRITE_QUEUE
+    push(adr, byte, line_cycle);
+#else
+    write_at(adr, byte, line_cycle);
+#endif
+}
+
+void DigitalRenderer::write_reg(uint16_t adr, uint8_t byte)
+{
+    if ((adr >> 5) >= SID_MAX_CHIPS) {
+        return;
+    }
+    DRChip &c = chip[adr >> 5];
+    DRVoice *voice = c.voice;
+
+    unsigned reg = adr & 0x1f;
+    unsigned v = reg / 7;
 
-    switch (adr) {
+    switch (reg) {
         case 0: case 7: case 14:
             voice[v].freq = (voice[v].freq & 0xff00) | byte;
-            voice[v].add = (uint32_t)((float)voice[v].freq / SAMPLE_FREQ * SID_FREQ);
+            set_add(voice[v]);
             break;
 
         case 1: case 8: case 15:
             voice[v].freq = (voice[v].freq & 0xff) | (byte << 8);
-            voice[v].add = (uint32_t)((float)voice[v].freq / SAMPLE_FREQ * SID_FREQ);
+            set_add(voice[v]);
             break;
 
         case 2: case 9: case 16:
@@ -539,57 +789,209 @@ void DigitalRenderer::WriteRegister(uint16_t adr, uint8_t byte)
             break;
 
         case 21:
-            f_fc = (f_fc & 0x7f8) | (byte & 7);
+            c.f_fc = (c.f_fc & 0x7f8) | (byte & 7);
+            c.filter.SetRegs(c.f_fc, c.f_res);
             break;
 
         case 22:
-            f_fc = (f_fc & 7) | (byte << 3);
+            c.f_fc = (c.f_fc & 7) | (byte << 3);
+            c.filter.SetRegs(c.f_fc, c.f_res);
             break;
 
         case 23:
-            res_filt = byte;
-            f_res = byte >> 4;
+            c.res_filt = byte;
+            c.f_res = byte >> 4;
+            c.filter.SetRegs(c.f_fc, c.f_res);
             break;
 
         case 24:
-            mode_vol = byte;
+            c.mode_vol = byte;
+            c.volume = (byte & 0xf) << 8;
             break;
     }
 }
 
 void DigitalRenderer::NewPrefs(const Prefs *prefs)
 {
-    is6581 = (prefs->SIDType == SIDTYPE_DIGITAL_6581);
+    const bool fitted[SID_MAX_CHIPS] = { true, prefs->SID2Address != 0, prefs->SID3Address != 0 };
+
+#if SID_WRITE_QUEUE
+    push(SID_CMD_TYPE, prefs->SIDType == SIDTYPE_DIGITAL_6581, 0);
+    for (unsigned n = 0; n < SID_MAX_CHIPS; ++n) {
+        push(SID_CMD_CHIP, n | (fitted[n] ? 0x80 : 0), prefs->SIDPan[n] + 16);
+    }
+#else
+    flush_samples();
+    set_type(prefs->SIDType == SIDTYPE_DIGITAL_6581);
+    for (unsigned n = 0; n < SID_MAX_CHIPS; ++n) {
+        set_chip(n, fitted[n], prefs->SIDPan[n]);
+    }
+#endif
 }
 
-void DigitalRenderer::calc_filter()
+
+/*
+ *  Switch between 6581 and 8580, which have different filter curves
+ */
+void DigitalRenderer::set_type(bool type_6581)
 {
-    // Simplified filter calculation for RP2350
-    // Convert 11-bit fc to normalized cutoff frequency
-    filter_cutoff = (float)f_fc / 2048.0f;
-    filter_resonance = 1.0f + (float)f_res / 15.0f;
+    is6581 = type_6581;
+    dc_offset = is6581 ? 0x800000 : 0x100000;
+    filter_curve.Build(is6581, SAMPLE_FREQ);
+    for (DRChip &c : chip) {
+        c.filter.SetCurve(&filter_curve);
+        c.filter.SetRegs(c.f_fc, c.f_res);
+    }
 }
 
-// Random number generator for noise waveform
-static uint8_t sid_random()
+
+/*
+ *  Fit or remove a SID and set its stereo position. With a single SID the
+ *  output is mono, with more each is panned by its gains (balance law:
+ *  the far side is attenuated, the near side stays at full level).
+ */
+void DigitalRenderer::set_chip(unsigned n, bool fitted, int pan)
+{
+    DRChip &c = chip[n];
+    if (c.fitted != fitted) {
+        c.fitted = fitted;
+        reset_chip(c);
+    }
+    c.pan = pan;
+
+    unsigned num_fitted = 0;
+    for (const DRChip &ch : chip) {
+        num_fitted += ch.fitted;
+    }
+    stereo = num_fitted > 1;
+
+    for (DRChip &ch : chip) {
+        if (stereo) {
+            ch.gain_left = (16 - ch.pan) * 16 < 256 ? (16 - ch.pan) * 16 : 256;
+            ch.gain_right = (16 + ch.pan) * 16 < 256 ? (16 + ch.pan) * 16 : 256;
+        } else {
+            ch.gain_left = ch.gain_right = 256;
+        }
+    }
+}
+
+/*
+ *  Clamp a mixed sample to 16 bits
+ */
+static inline int16_t clamp_sample(int32_t output)
+{
+    // Clamp to 16-bit range
+#if defined(__ARM_FEATURE_DSP)
+    output = __ssat(output, 16);
+#else
+    if (output > 32767) {
+        output = 32767;
+    } else if (output < -32768) {
+        output = -32768;
+    }
+#endif
+
+    return (int16_t)output;
+}
+
+
+/*
+ *  Band-limited waveforms (Prefs::SIDBandLimit). The naive saw, pulse and
+ *  triangle step or turn within a sample, which aliases the harmonics of
+ *  high notes back into the audible range. The samples less than one
+ *  sample period from a step get a polyBLEP correction, those around a
+ *  corner of the triangle a polyBLAMP correction, looked up in a table by
+ *  the distance to the edge in 1/256 of a sample. That is two compares per
+ *  edge and sample, plus a lookup near the edges; the combined waveforms
+ *  and noise stay as they are.
+ */
+
+// Corrections indexed by 256 + edge_pos(): for a step of -65536 (polyBLEP
+// residual), and for a change of the slope by 1 per sample (polyBLAMP
+// residual, 16.16 fixed)
+static int16_t blep_step[513];
+static uint16_t blamp_corner[513];
+
+static void build_band_limit_tables()
+{
+    for (unsigned i = 0; i < 256; ++i) {
+        float r = 1.0f - (i + 0.5f) / 256.0f;
+        int16_t step = (int16_t)(32768.0f * r * r + 0.5f);
+        blep_step[257 + i] = step;
+        blep_step[255 - i] = -step;
+        blamp_corner[257 + i] = blamp_corner[255 - i] = (uint16_t)(65536.0f * r * r * r / 6.0f + 0.5f);
+    }
+    blep_step[256] = 0;
+    blamp_corner[256] = 0;
+}
+
+// Distance of phase c from an edge at phase 'edge' in 1/256 of a sample,
+// counting from 1 after the edge and from -1 before it, or 0 if it is a
+// sample or more away
+static inline int edge_pos(uint32_t c, uint32_t edge, uint32_t add, uint32_t add_inv)
+{
+    uint32_t after = (c - edge) & 0xffffff;
+    if (after < add) {
+        return 1 + (int)((after * add_inv) >> 16);
+    }
+    uint32_t before = (edge - c) & 0xffffff;
+    if (before < add) {
+        return -1 - (int)((before * add_inv) >> 16);
+    }
+    return 0;
+}
+
+// Signed output of the band-limited waveforms for phase c; add is 0 while
+// the test bit is set
+static inline int16_t band_limited_saw(uint32_t c, uint32_t add, uint32_t add_inv)
+{
+    // Steps down at phase 0
+    return (int16_t)((c >> 8) ^ 0x8000) + blep_step[256 + edge_pos(c, 0, add, add_inv)];
+}
+
+static inline int16_t band_limited_rect(uint32_t c, uint32_t add, uint32_t add_inv, uint32_t pw, bool test)
+{
+    // Steps down at phase 0 and up at the pulse width; both edges may be
+    // within one sample
+    int32_t output = (test || (c >> 12) >= pw) ? 32767 : -32768;
+    output += blep_step[256 + edge_pos(c, 0, add, add_inv)];
+    output -= blep_step[256 + edge_pos(c, pw << 12, add, add_inv)];
+    return clamp_sample(output);
+}
+
+static inline int16_t band_limited_tri(uint32_t c, uint32_t add, uint32_t add_inv)
 {
-    static uint32_t seed = 1;
-    seed = seed * 1103515245 + 12345;
-    return seed >> 16;
+    // Turns up at phase 0 and down at phase 0x800000, the slope changes by
+    // 2 * 65536 per half period
+    int32_t output = (int16_t)(((c & 0x800000) ? (c >> 7) ^ 0xffff : c >> 7) ^ 0x8000);
+    int32_t slope_change = add >> 6;
+    output += (slope_change * blamp_corner[256 + edge_pos(c, 0, add, add_inv)]) >> 16;
+    output -= (slope_change * blamp_corner[256 + edge_pos(c, 0x800000, add, add_inv)]) >> 16;
+    return output;
 }
 
-int16_t DigitalRenderer::calc_single_sample()
+// Set the oscillator increment for the frequency register
+inline void DigitalRenderer::set_add(DRVoice &v)
 {
-    // Get current settings
-    uint8_t master_volume = mode_vol & 0xf;
+    v.add = ((uint64_t)v.freq * SID_ADD_PER_FREQ) >> 16;
+    v.add_inv = v.add ? (256u << 16) / v.add : 0;
+}
 
+// Random number generator for noise waveform
+inline uint8_t DigitalRenderer::noise_random(DRChip &c)
+{
+    c.noise_seed = c.noise_seed * 1103515245 + 12345;
+    return c.noise_seed >> 16;
+}
+
+int32_t DigitalRenderer::calc_single_sample(DRChip &c)
+{
     int32_t sum_output = 0;
     int32_t sum_input_filter = 0;
-    int32_t sum_output_filter = 0;
 
     // Loop for all three voices
     for (unsigned j = 0; j < 3; ++j) {
-        DRVoice *v = &voice[j];
+        DRVoice *v = &c.voice[j];
 
         // Envelope generator
         uint16_t envelope;
@@ -630,8 +1032,15 @@ int16_t DigitalRenderer::calc_single_sample()
 
         v->count &= 0xffffff;
 
+        // Oscillator increment of the sample, for the band-limited waveforms
+        const uint32_t add = v->test ? 0 : v->add;
+
         switch (v->wave) {
             case WAVE_TRI: {
+                if (band_limit && !v->ring) {
+                    output = (uint16_t)band_limited_tri(v->count, add, v->add_inv) ^ 0x8000;
+                    break;
+                }
                 uint32_t ctrl = v->count;
                 if (v->ring) {
                     ctrl ^= v->mod_by->count;
@@ -644,17 +1053,23 @@ int16_t DigitalRenderer::calc_single_sample()
                 break;
             }
             case WAVE_SAW:
-                output = v->count >> 8;
+                if (band_limit) {
+                    output = (uint16_t)band_limited_saw(v->count, add, v->add_inv) ^ 0x8000;
+                } else {
+                    output = v->count >> 8;
+                }
                 break;
             case WAVE_RECT:
-                if (v->test || (v->count >> 12) >= v->pw) {
+                if (band_limit) {
+                    output = (uint16_t)band_limited_rect(v->count, add, v->add_inv, v->pw, v->test) ^ 0x8000;
+                } else if (v->test || (v->count >> 12) >= v->pw) {
                     output = 0xffff;
                 } else {
                     output = 0;
                 }
                 break;
             case WAVE_TRISAW:
-                output = the_sid->TriSawTable[v->count >> 12];
+                output = the_sid->TriSawTable[v->count >> 12] * 0x101;
                 if (is6581) {
                     v->count &= 0x7fffff | (output << 8);
                 }
@@ -665,14 +1080,14 @@ int16_t DigitalRenderer::calc_single_sample()
                     if (v->ring) {
                         ctrl ^= ~(v->mod_by->count) & 0x800000;
                     }
-                    output = the_sid->TriRectTable[ctrl >> 12];
+                    output = the_sid->TriRectTable[ctrl >> 12] * 0x101;
                 } else {
                     output = 0;
                 }
                 break;
             case WAVE_SAWRECT:
                 if (v->test || (v->count >> 12) >= v->pw) {
-                    output = the_sid->SawRectTable[v->count >> 12];
+                    output = the_sid->SawRectTable[v->count >> 12] * 0x101;
                 } else {
                     output = 0;
                 }
@@ -682,7 +1097,7 @@ int16_t DigitalRenderer::calc_single_sample()
                 break;
             case WAVE_TRISAWRECT:
                 if (v->test || (v->count >> 12) >= v->pw) {
-                    output = the_sid->TriSawRectTable[v->count >> 12];
+                    output = the_sid->TriSawRectTable[v->count >> 12] * 0x101;
                 } else {
                     output = 0;
                 }
@@ -692,7 +1107,7 @@ int16_t DigitalRenderer::calc_single_sample()
                 break;
             case WAVE_NOISE:
                 if (v->count > 0x100000) {
-                    output = v->noise = sid_random() << 8;
+                    output = v->noise = noise_random(c) << 8;
                     v->count &= 0xfffff;
                 } else {
                     output = v->noise;
@@ -704,65 +1119,670 @@ int16_t DigitalRenderer::calc_single_sample()
         }
 
         // Route voice through filter if selected
-        if (res_filt & (1 << j)) {
+        if (c.res_filt & (1 << j)) {
             sum_input_filter += (int16_t)(output ^ 0x8000) * envelope;
-        } else if (j != 2 || (mode_vol & 0x80) == 0) {
+        } else if (j != 2 || (c.mode_vol & 0x80) == 0) {
             sum_output += (int16_t)(output ^ 0x8000) * envelope;
         }
     }
 
-    // Simplified filter (single-pole IIR for RP2350)
-    float cutoff = 0.1f + filter_cutoff * 0.8f;  // Map to useful range
+    return mix_sample(c, sum_output, sum_input_filter);
+}
+
 
-    // Low-pass
-    if (mode_vol & 0x10) {
-        lp_state = lp_state + cutoff * ((float)sum_input_filter - lp_state);
-        sum_output_filter += (int32_t)lp_state;
+/*
+ *  Filter the summed voices and apply the master volume (not clamped yet,
+ *  the SIDs are mixed first)
+ */
+inline int32_t DigitalRenderer::mix_sample(DRChip &c, int32_t sum_output, int32_t sum_input_filter)
+{
+    int32_t sum_output_filter = c.filter.Clock(sum_input_filter, c.mode_vol);
+
+    // Mix and apply master volume. The DC offset is scaled by the volume
+    // as on the real chip, so $D418 writes alone produce sound (digis).
+    // Scale down to prevent clipping (>> 16 instead of >> 14)
+    int32_t output = ((sum_output + sum_output_filter + dc_offset) >> 8) * c.volume;
+    return output >> 16;
+}
+
+
+/*
+ *  Block renderer: runs the envelope and the oscillator of each voice over
+ *  a whole block of samples in tight loops specialized by waveform, then
+ *  mixes and filters the block. Produces the same samples as
+ *  calc_single_sample(), which is still used when the voices depend on
+ *  each other within a sample (sync, ring modulation, or noise_random()
+ *  used by more than one voice).
+ */
+bool DigitalRenderer::block_possible(const DRChip &c) const
+{
+    unsigned noise_voices = 0;
+    for (unsigned j = 0; j < 3; ++j) {
+        const DRVoice *v = &c.voice[j];
+        if (v->sync) {
+            return false;
+        }
+        if (v->ring && (v->wave == WAVE_TRI || v->wave == WAVE_TRIRECT)) {
+            return false;
+        }
+        if (v->wave == WAVE_NOISE) {
+            ++noise_voices;
+        }
     }
+    return noise_voices <= 1;
+}
+
+// Envelope levels of one voice, written to every 4th element of env
+void DigitalRenderer::calc_envelope(DRVoice *v, int16_t *env, unsigned count)
+{
+    int32_t level = v->eg_level;
+    unsigned i = 0;
+
+    while (i < count) {
+        switch (v->eg_state) {
+            case EG_ATTACK:
+                for (; i < count; ++i) {
+                    level += v->a_add;
+                    if (level > 0xffffff) {
+                        level = 0xffffff;
+                        v->eg_state = EG_DECAY_SUSTAIN;
+                        env[i++ * 4] = level >> 16;
+                        break;
+                    }
+                    env[i * 4] = level >> 16;
+                }
+                break;
 
-    // Band-pass (difference of two low-passes)
-    if (mode_vol & 0x20) {
-        float bp_input = (float)sum_input_filter;
-        float bp_lp = bp_state + cutoff * (bp_input - bp_state);
-        bp_state = bp_lp;
-        sum_output_filter += (int32_t)(bp_input - bp_lp) * (int32_t)(filter_resonance);
+            case EG_DECAY_SUSTAIN:
+                if (level <= v->s_level) {
+                    // Sustain, the level stays put
+                    level = v->s_level;
+                    for (; i < count; ++i) {
+                        env[i * 4] = level >> 16;
+                    }
+                    break;
+                }
+                for (; i < count; ++i) {
+                    level -= v->d_sub >> MOS6581::EGDRShift[level >> 16];
+                    if (level < v->s_level) {
+                        level = v->s_level;
+                    }
+                    env[i * 4] = level >> 16;
+                }
+                break;
+
+            case EG_RELEASE:
+                if (level <= 0) {
+                    level = 0;
+                    for (; i < count; ++i) {
+                        env[i * 4] = 0;
+                    }
+                    break;
+                }
+                for (; i < count; ++i) {
+                    level -= v->r_sub >> MOS6581::EGDRShift[level >> 16];
+                    if (level < 0) {
+                        level = 0;
+                    }
+                    env[i * 4] = level >> 16;
+                }
+                break;
+        }
     }
 
-    // High-pass
-    if (mode_vol & 0x40) {
-        hp_state = hp_state + cutoff * ((float)sum_input_filter - hp_state);
-        sum_output_filter += (int32_t)((float)sum_input_filter - hp_state);
+    v->eg_level = level;
+}
+
+// Signed waveform output of one voice, written to every 4th element of out
+template <int WAVE, bool BAND_LIMIT>
+void DigitalRenderer::calc_wave(DRChip &ch, DRVoice *v, int16_t *out, unsigned count)
+{
+    uint32_t c = v->count;
+    const uint32_t add = v->test ? 0 : v->add;
+    const bool test = v->test;
+    const uint32_t pw = v->pw;
+    const uint32_t add_inv = v->add_inv;
+    const bool mask_count = is6581;
+
+    const uint8_t *table = nullptr;
+    if (WAVE == WAVE_TRISAW) {
+        table = the_sid->TriSawTable;
+    } else if (WAVE == WAVE_TRIRECT) {
+        table = the_sid->TriRectTable;
+    } else if (WAVE == WAVE_SAWRECT) {
+        table = the_sid->SawRectTable;
+    } else if (WAVE == WAVE_TRISAWRECT) {
+        table = the_sid->TriSawRectTable;
     }
 
-    // Mix and apply master volume
-    // Scale down to prevent clipping (>> 16 instead of >> 14)
-    int32_t output = (sum_output + sum_output_filter) * master_volume;
-    output = output >> 16;
+    for (unsigned i = 0; i < count; ++i) {
+        c = (c + add) & 0xffffff;
 
-    // Add small DC offset for 6581 (after volume scaling)
-    if (is6581) {
-        output += 128;
+        uint16_t output;
+        if constexpr (BAND_LIMIT && WAVE == WAVE_TRI) {
+            out[i * 4] = band_limited_tri(c, add, add_inv);
+            continue;
+        } else if constexpr (BAND_LIMIT && WAVE == WAVE_SAW) {
+            out[i * 4] = band_limited_saw(c, add, add_inv);
+            continue;
+        } else if constexpr (BAND_LIMIT && WAVE == WAVE_RECT) {
+            out[i * 4] = band_limited_rect(c, add, add_inv, pw, test);
+            continue;
+        } else if constexpr (WAVE == WAVE_TRI) {
+            output = (c & 0x800000) ? (c >> 7) ^ 0xffff : c >> 7;
+        } else if constexpr (WAVE == WAVE_SAW) {
+            output = c >> 8;
+        } else if constexpr (WAVE == WAVE_RECT) {
+            output = (test || (c >> 12) >= pw) ? 0xffff : 0;
+        } else if constexpr (WAVE == WAVE_TRISAW) {
+            output = table[c >> 12] * 0x101;
+            if (mask_count) {
+                c &= 0x7fffff | (output << 8);
+            }
+        } else if constexpr (WAVE == WAVE_TRIRECT) {
+            output = (test || (c >> 12) >= pw) ? table[c >> 12] * 0x101 : 0;
+        } else if constexpr (WAVE == WAVE_SAWRECT || WAVE == WAVE_TRISAWRECT) {
+            output = (test || (c >> 12) >= pw) ? table[c >> 12] * 0x101 : 0;
+            if (mask_count) {
+                c &= 0x7fffff | (output << 8);
+            }
+        } else if constexpr (WAVE == WAVE_NOISE) {
+            if (c > 0x100000) {
+                v->noise = noise_random(ch) << 8;
+                c &= 0xfffff;
+            }
+            output = v->noise;
+        } else {
+            output = 0x8000;
+        }
+
+        out[i * 4] = (int16_t)(output ^ 0x8000);
     }
 
-    // Clamp to 16-bit range
-    if (output > 32767) {
-        output = 32767;
-    } else if (output < -32768) {
-        output = -32768;
+    v->count = c;
+}
+
+const DigitalRenderer::WaveFunc DigitalRenderer::wave_func[2][16] = {
+    {
+        &DigitalRenderer::calc_wave<WAVE_NONE, false>,
+        &DigitalRenderer::calc_wave<WAVE_TRI, false>,
+        &DigitalRenderer::calc_wave<WAVE_SAW, false>,
+        &DigitalRenderer::calc_wave<WAVE_TRISAW, false>,
+        &DigitalRenderer::calc_wave<WAVE_RECT, false>,
+        &DigitalRenderer::calc_wave<WAVE_TRIRECT, false>,
+        &DigitalRenderer::calc_wave<WAVE_SAWRECT, false>,
+        &DigitalRenderer::calc_wave<WAVE_TRISAWRECT, false>,
+        &DigitalRenderer::calc_wave<WAVE_NOISE, false>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, false>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, false>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, false>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, false>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, false>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, false>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, false>
+    },
+    {
+        &DigitalRenderer::calc_wave<WAVE_NONE, true>,
+        &DigitalRenderer::calc_wave<WAVE_TRI, true>,
+        &DigitalRenderer::calc_wave<WAVE_SAW, true>,
+        &DigitalRenderer::calc_wave<WAVE_TRISAW, true>,
+        &DigitalRenderer::calc_wave<WAVE_RECT, true>,
+        &DigitalRenderer::calc_wave<WAVE_TRIRECT, true>,
+        &DigitalRenderer::calc_wave<WAVE_SAWRECT, true>,
+        &DigitalRenderer::calc_wave<WAVE_TRISAWRECT, true>,
+        &DigitalRenderer::calc_wave<WAVE_NOISE, true>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, true>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, true>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, true>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, true>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, true>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, true>,
+        &DigitalRenderer::calc_wave<WAVE_NONE, true>
     }
+};
 
-    return (int16_t)output;
+// Render count (<= SID_BLOCK) samples of one SID to out
+void DigitalRenderer::calc_block(DRChip &c, int32_t *out, unsigned count)
+{
+    for (unsigned j = 0; j < 3; ++j) {
+        DRVoice *v = &c.voice[j];
+        bool idle = voice_idle(*v);
+        calc_envelope(v, &block_env[0][j], count);
+        if (idle) {
+            // Envelope is all zero, the waveform output does not matter
+            skip_wave(*v, count);
+        } else {
+            (this->*wave_func[band_limit][v->wave])(c, v, &block_wave[0][j], count);
+        }
+    }
+
+    // Voice routing: to the filter, straight to the output, or off (voice 3)
+    bool to_filter[3], to_output[3];
+    for (unsigned j = 0; j < 3; ++j) {
+        to_filter[j] = c.res_filt & (1 << j);
+        to_output[j] = !to_filter[j] && (j != 2 || (c.mode_vol & 0x80) == 0);
+    }
+
+#if defined(__ARM_FEATURE_DSP)
+    // Halfword masks selecting the envelopes of the voices of each route
+    const uint32_t filter01 = (to_filter[0] ? 0xffff : 0) | (to_filter[1] ? 0xffff0000 : 0);
+    const uint32_t filter2 = to_filter[2] ? 0xffff : 0;
+    const uint32_t output01 = (to_output[0] ? 0xffff : 0) | (to_output[1] ? 0xffff0000 : 0);
+    const uint32_t output2 = to_output[2] ? 0xffff : 0;
+
+    for (unsigned i = 0; i < count; ++i) {
+        const uint32_t *wave = (const uint32_t *)block_wave[i];
+        const uint32_t *env = (const uint32_t *)block_env[i];
+        int32_t sum_output = __smlad(wave[0], env[0] & output01, __smuad(wave[1], env[1] & output2));
+        int32_t sum_input_filter = __smlad(wave[0], env[0] & filter01, __smuad(wave[1], env[1] & filter2));
+        out[i] = mix_sample(c, sum_output, sum_input_filter);
+    }
+#else
+    for (unsigned i = 0; i < count; ++i) {
+        int32_t sum_output = 0;
+        int32_t sum_input_filter = 0;
+        for (unsigned j = 0; j < 3; ++j) {
+            int32_t voice_out = block_wave[i][j] * block_env[i][j];
+            if (to_filter[j]) {
+                sum_input_filter += voice_out;
+            } else if (to_output[j]) {
+                sum_output += voice_out;
+            }
+        }
+        out[i] = mix_sample(c, sum_output, sum_input_filter);
+    }
+#endif
+}
+
+
+/*
+ *  A voice whose envelope is at zero in the release phase is silent. Its
+ *  oscillator is then advanced in one step instead of being rendered,
+ *  unless the count depends on the waveform (noise, masked 6581 combined
+ *  waveforms) or the voice syncs another one.
+ */
+bool DigitalRenderer::voice_idle(const DRVoice &v) const
+{
+    if (v.eg_state != EG_RELEASE || v.eg_level != 0 || v.sync || v.wave == WAVE_NOISE) {
+        return false;
+    }
+    return !is6581 || (v.wave != WAVE_TRISAW && v.wave != WAVE_SAWRECT && v.wave != WAVE_TRISAWRECT);
+}
+
+inline void DigitalRenderer::skip_wave(DRVoice &v, unsigned count)
+{
+    if (!v.test) {
+        v.count = (v.count + v.add * count) & 0xffffff;
+    }
+}
+
+// A SID with all voices idle and the filter settled outputs a constant level
+bool DigitalRenderer::chip_idle(const DRChip &c) const
+{
+    if (!c.filter.Idle()) {
+        return false;
+    }
+    for (const DRVoice &v : c.voice) {
+        if (!voice_idle(v)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*
+ *  Render count (<= SID_BLOCK) samples of one SID to out, not clamped
+ */
+void DigitalRenderer::calc_chip(DRChip &c, int32_t *out, unsigned count)
+{
+    if (chip_idle(c)) {
+        for (DRVoice &v : c.voice) {
+            skip_wave(v, count);
+        }
+        int32_t level = mix_sample(c, 0, 0);
+        for (unsigned i = 0; i < count; ++i) {
+            out[i] = level;
+        }
+    } else if (ThePrefs.SIDBlockRender && block_possible(c)) {
+        calc_block(c, out, count);
+    } else {
+        for (unsigned i = 0; i < count; ++i) {
+            out[i] = calc_single_sample(c);
+        }
+    }
+}
+
+
+// Store a sample pair in the output ring buffer format (stereo pairs, or
+// one word per sample with AUDIO_DIRECT)
+static inline void store_sample(sid_out_t *buf, unsigned i, int16_t left, int16_t right, int32_t gain)
+{
+#if SID_OUT_CHANNELS == 2
+    buf[i * 2] = sid_out_sample(left, gain);
+    buf[i * 2 + 1] = sid_out_sample(right, gain);
+#else
+    buf[i] = sid_out_sample((left + right) >> 1, gain);
+#endif
+}
+
+
+/*
+ *  Render count (<= SID_BLOCK) samples of all fitted SIDs to buf (nullptr
+ *  = discard them). A sample with $D418 writes is rendered on its own,
+ *  without writes the block is rendered in one go.
+ */
+void DigitalRenderer::mix_block(sid_out_t *buf, unsigned count)
+{
+    band_limit = ThePrefs.SIDBandLimit;
+
+    while (vol_event_head != vol_event_tail) {
+        int32_t at = (int32_t)(vol_event[vol_event_tail % SID_VOL_EVENTS].sample - sample_clock);
+        if (at >= (int32_t)count) {
+            break;
+        }
+        if (at > 0) {
+            mix_chips(buf, at);
+            sample_clock += at;
+            count -= at;
+            if (buf != nullptr) {
+                buf += at * SID_OUT_CHANNELS;
+            }
+        }
+
+        apply_vol_events();
+        mix_chips(buf, 1);
+        sample_clock++;
+        count--;
+        if (buf != nullptr) {
+            buf += SID_OUT_CHANNELS;
+        }
+        for (DRChip &c : chip) {
+            c.volume = (c.mode_vol & 0xf) << 8;
+        }
+    }
+
+    if (count > 0) {
+        mix_chips(buf, count);
+        sample_clock += count;
+    }
+}
+
+
+/*
+ *  Take the $D418 writes of the next sample. Filter mode and voice 3 off
+ *  switch at the start of the sample; the volume of the sample is the
+ *  average of the volumes over it, weighted by the time each was set.
+ */
+void DigitalRenderer::apply_vol_events()
+{
+    unsigned weighted[SID_MAX_CHIPS];
+    unsigned last_frac[SID_MAX_CHIPS] = {};
+    for (unsigned n = 0; n < SID_MAX_CHIPS; ++n) {
+        weighted[n] = 0;
+    }
+
+    uint32_t sample = vol_event[vol_event_tail % SID_VOL_EVENTS].sample;
+    while (vol_event_tail != vol_event_head) {
+        const SIDVolEvent &e = vol_event[vol_event_tail % SID_VOL_EVENTS];
+        if ((int32_t)(e.sample - sample) > 0) {
+            break;
+        }
+        DRChip &c = chip[e.chip];
+        weighted[e.chip] += (c.mode_vol & 0xf) * (e.frac - last_frac[e.chip]);
+        last_frac[e.chip] = e.frac;
+        c.mode_vol = e.mode_vol;
+        ++vol_event_tail;
+    }
+
+    for (unsigned n = 0; n < SID_MAX_CHIPS; ++n) {
+        chip[n].volume = weighted[n] + (chip[n].mode_vol & 0xf) * (256 - last_frac[n]);
+    }
+}
+
+
+/*
+ *  Render count samples of all fitted SIDs to buf (nullptr = discard
+ *  them). Extra SIDs are mixed in 8.8 fixed point with their stereo gains
+ *  and the sum is clamped once.
+ */
+void DigitalRenderer::mix_chips(sid_out_t *buf, unsigned count)
+{
+    if (!stereo) {
+        calc_chip(chip[0], chip_out, count);
+        if (buf != nullptr) {
+            for (unsigned i = 0; i < count; ++i) {
+                int16_t sample = clamp_sample(chip_out[i]);
+                store_sample(buf, i, sample, sample, out_gain);
+            }
+        }
+        return;
+    }
+
+    memset(mix_left, 0, count * sizeof(int32_t));
+    memset(mix_right, 0, count * sizeof(int32_t));
+    for (DRChip &c : chip) {
+        if (!c.fitted) {
+            continue;
+        }
+        calc_chip(c, chip_out, count);
+        for (unsigned i = 0; i < count; ++i) {
+            mix_left[i] += chip_out[i] * c.gain_left;
+            mix_right[i] += chip_out[i] * c.gain_right;
+        }
+    }
+
+    if (buf != nullptr) {
+        for (unsigned i = 0; i < count; ++i) {
+            store_sample(buf, i, clamp_sample(mix_left[i] >> 8), clamp_sample(mix_right[i] >> 8), out_gain);
+        }
+    }
 }
 
 void DigitalRenderer::calc_samples(int count)
 {
-    // Debug: track sample generation rate
-    calc_filter();
+    // Render straight into the output ring buffer. With AUDIO_DIRECT the
+    // DMA plays it as written, so the volume is applied here.
+#if AUDIO_DIRECT
+    out_gain = sid_out_gain();
+#else
+    out_gain = SID_OUT_UNITY;
+#endif
+    while (count > 0) {
+        unsigned n;
+        sid_out_t *buf = sid_get_write_block(&n);
+        if (n == 0) {
+            // Buffer full, drop the samples but keep the voices running
+            sid_drop_samples(count);
+            for (; count > 0; count -= SID_BLOCK) {
+                mix_block(nullptr, count < (int)SID_BLOCK ? count : SID_BLOCK);
+            }
+            break;
+        }
+        if (n > (unsigned)count) {
+            n = count;
+        }
+
+        for (unsigned i = 0; i < n; i += SID_BLOCK) {
+            mix_block(buf + i * SID_OUT_CHANNELS, n - i < SID_BLOCK ? n - i : SID_BLOCK);
+        }
+        sid_commit_samples(n);
+        count -= n;
+    }
+}
 
-    for (int i = 0; i < count; ++i) {
-        int16_t sample = calc_single_sample();
 
-        // Output to I2S (stereo, same on both channels)
-        sid_add_sample(sample, sample);
+/*
+ *  Number of samples in the next raster line (fractional sample counting:
+ *  accumulate samples per line, keep the fractional remainder). The rate
+ *  is corrected to follow the audio output clock.
+ */
+inline unsigned DigitalRenderer::line_samples()
+{
+    int32_t adjust = ((int32_t)samples_per_line_frac * sid_get_rate_adjust()) >> 20;
+    sample_accum += samples_per_line_frac + adjust;
+    unsigned samples = sample_accum >> 16;
+    sample_accum &= 0xFFFF;
+    return samples;
+}
+
+
+/*
+ *  Start the next raster line: the samples of the previous one are due
+ */
+void DigitalRenderer::start_line()
+{
+    pending += line_total - line_done;
+    if (pending >= SID_BLOCK) {
+        flush_samples();
+    }
+    line_total = line_samples();
+    line_done = 0;
+}
+
+
+/*
+ *  Register write at a cycle of the raster line, which takes effect at the
+ *  sample that cycle falls on. Writes to $D418 are only timestamped and
+ *  applied by the mixer, so digi players writing it several times per
+ *  line neither break up the rendering into single samples nor lose the
+ *  volumes between two samples.
+ */
+void DigitalRenderer::write_at(uint16_t adr, uint8_t byte, unsigned line_cycle)
+{
+    unsigned cycle = line_cycle < SID_CYCLES_PER_LINE ? line_cycle : SID_CYCLES_PER_LINE - 1;
+    unsigned pos = (cycle * line_total << 8) / SID_CYCLES_PER_LINE;    // 24.8 fixed
+    uint8_t frac = pos & 0xff;
+    if ((pos >> 8) >= line_done) {
+        pending += (pos >> 8) - line_done;
+        line_done = pos >> 8;
+    } else {
+        frac = 0;   // Sample already rendered, take effect at the next one
+    }
+
+    if ((adr & 0x1f) == 24 && (adr >> 5) < SID_MAX_CHIPS) {
+        add_vol_event(adr >> 5, byte, frac);
+    } else {
+        flush_samples();
+        write_reg(adr, byte);
     }
 }
+
+
+/*
+ *  Queue a $D418 write for the first sample that is not due yet
+ */
+void DigitalRenderer::add_vol_event(unsigned n, uint8_t byte, uint8_t frac)
+{
+    if (vol_event_head - vol_event_tail == SID_VOL_EVENTS) {
+        flush_samples();
+        if (vol_event_head - vol_event_tail == SID_VOL_EVENTS) {
+            // All writes are for this sample, apply the oldest right away
+            const SIDVolEvent &e = vol_event[vol_event_tail++ % SID_VOL_EVENTS];
+            write_reg((e.chip << 5) | 24, e.mode_vol);
+        }
+    }
+    vol_event[vol_event_head++ % SID_VOL_EVENTS] = { sample_clock + pending, frac, (uint8_t)n, byte };
+}
+
+
+/*
+ *  Render the samples that are due
+ */
+void DigitalRenderer::flush_samples()
+{
+    if (pending > 0) {
+        calc_samples(pending);
+        pending = 0;
+    }
+}
+
+
+#if SID_WRITE_QUEUE
+/*
+ *  Queue a register write or command for RenderQueued() (emulation core)
+ */
+inline void DigitalRenderer::push(uint8_t adr, uint8_t byte, uint8_t cycle)
+{
+    unsigned head = write_head.load(std::memory_order_relaxed);
+    while (head - write_tail.load(std::memory_order_acquire) >= SID_WRITE_QUEUE) {
+        SID_WAIT();     // Queue full, wait for the rendering core
+    }
+    write_queue[head % SID_WRITE_QUEUE] = { adr, byte, cycle };
+    write_head.store(head + 1, std::memory_order_release);
+}
+
+
+/*
+ *  Render the queued register writes, called in a loop by the second core.
+ *  Each write takes effect at the sample of the raster line its CPU cycle
+ *  falls on.
+ */
+void DigitalRenderer::RenderQueued()
+{
+    unsigned tail = write_tail.load(std::memory_order_relaxed);
+    unsigned head = write_head.load(std::memory_order_acquire);
+
+    while (tail != head) {
+        const SIDWrite &w = write_queue[tail % SID_WRITE_QUEUE];
+
+        switch (w.adr) {
+            case SID_CMD_LINE:
+                start_line();
+                break;
+
+            case SID_CMD_TYPE:
+                flush_samples();
+                set_type(w.byte);
+                break;
+
+            case SID_CMD_CHIP:
+                flush_samples();
+                set_chip(w.byte & 0x7f, w.byte & 0x80, (int)w.cycle - 16);
+                break;
+
+            case SID_CMD_RESET:
+                pending += line_total - line_done;
+                flush_samples();
+                reset_state();
+                break;
+
+            case SID_CMD_FLUSH:
+                flush_samples();
+                break;
+
+            default:
+                write_at(w.adr, w.byte, w.cycle);
+                break;
+        }
+
+        write_tail.store(++tail, std::memory_order_release);
+        if (tail == head) {
+            head = write_head.load(std::memory_order_acquire);
+        }
+    }
+}
+
+
+/*
+ *  Wait until the rendering core has processed all queued writes
+ */
+void DigitalRenderer::WaitRendered()
+{
+    push(SID_CMD_FLUSH, 0, 0);
+    unsigned head = write_head.load(std::memory_order_relaxed);
+    while (write_tail.load(std::memory_order_acquire) != head) {
+        SID_WAIT();
+    }
+}
+
+#else
+
+/*
+ *  Render all samples that are due
+ */
+void DigitalRenderer::WaitRendered()
+{
+    flush_samples();
+}
+#endif
@@ -0,0 +1,80 @@
+/*
+ *  c64_profile.h - Per-chip frame profiler for c64_run_frame()
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Compiled in with -DPROFILER=ON (C64_PROFILE=1). Time is measured with
+ *  the core's SysTick, so all values are CPU clock cycles; divide by
+ *  clock_mhz for microseconds. With PRECISE_CIA_CYCLES the CIA timers are
+ *  clocked from inside the CPU loop and their time is counted as CPU.
+ */
+
+#ifndef C64_PROFILE_H
+#define C64_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef C64_PROFILE
+#define C64_PROFILE 0
+#endif
+
+// Number of frames kept in the ring buffer
+#ifndef C64_PROFILE_FRAMES
+#define C64_PROFILE_FRAMES 64
+#endif
+
+// Number of raster lines tracked for worst-case line cost (PAL)
+#define C64_PROFILE_LINES 312
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    C64_PROF_VIC,
+    C64_PROF_SID,
+    C64_PROF_CIA1,
+    C64_PROF_CIA2,
+    C64_PROF_CPU,
+    C64_PROF_1541,
+    C64_PROF_NUM
+};
+
+typedef struct {
+    uint32_t frame;                     // Frame number
+    uint32_t total;                     // Whole c64_run_frame() incl. input polling
+    uint32_t chip[C64_PROF_NUM];        // Time per chip
+    uint16_t lines;                     // Lines emulated in this frame
+    uint16_t worst_line;                // Line (counted from VBLANK) with the highest cost
+    uint32_t worst_line_cycles;         // Cost of that line, all chips
+} c64_frame_profile_t;
+
+typedef struct {
+    c64_frame_profile_t frames[C64_PROFILE_FRAMES];  // Ring, next slot is count % C64_PROFILE_FRAMES
+    uint32_t count;                     // Frames recorded since reset
+    uint32_t line_worst[C64_PROFILE_LINES];  // Worst cost per line since reset
+    uint32_t clock_mhz;                 // Cycles per microsecond
+} c64_profile_t;
+
+// Profile data, or NULL if the profiler is not compiled in
+const c64_profile_t *c64_get_profile(void);
+
+// Clear the ring buffer and the per-line worst cases
+void c64_reset_profile(void);
+
+// Show/hide the profiler line of the on-screen overlay
+void c64_set_profile_overlay(bool enable);
+bool c64_get_profile_overlay(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C64_PROFILE_H
@@ -177,41 +177,36 @@ static void clamp_scroll(void)
         scroll_offset = 0;
 }
 
-extern uint8_t g_pixels[384 * 272];
-// Source: VIC buffer (384x272, 8-bit indexed color)
-// Dest: HDMI framebuffer (320x240, 8-bit indexed color)
+// Line y of the visible 320x240 screen (Display_rp2350.cpp)
+extern uint8_t *display_get_screen_line(int y);
 
 // Draw a filled rectangle
 static void draw_rect(int x, int y, int w, int h, uint8_t color) {
-    x += C64_CROP_LEFT;
-    y += C64_CROP_TOP;
-    uint8_t *fb = g_pixels;
     for (int dy = 0; dy < h; dy++) {
-        if (y + dy < 0 || y + dy >= C64_DISPLAY_HEIGHT) continue;
+        if (y + dy < 0 || y + dy >= FB_HEIGHT) continue;
+        uint8_t *line = display_get_screen_line(y + dy);
         for (int dx = 0; dx < w; dx++) {
-            if (x + dx < 0 || x + dx >= C64_DISPLAY_WIDTH) continue;
-            fb[(y + dy) * C64_DISPLAY_WIDTH + (x + dx)] = color;
+            if (x + dx < 0 || x + dx >= FB_WIDTH) continue;
+            line[x + dx] = color;
         }
     }
 }
 
 // Draw a character using the 6x8 bitmap font
 static void draw_char(int x, int y, char c, uint8_t color) {
-    x += C64_CROP_LEFT;
-    y += C64_CROP_TOP;
-    uint8_t *fb = g_pixels;
     int idx = (unsigned char)c - 32;
     if (idx < 0 || idx > 94) return;
 
     const uint8_t *glyph = font_6x8[idx];
 
     for (int row = 0; row < 8; row++) {
-        if (y + row < 0 || y + row >= (C64_DISPLAY_HEIGHT - C64_CROP_TOP * 2)) continue;
+        if (y + row < 0 || y + row >= FB_HEIGHT) continue;
+        uint8_t *line = display_get_screen_line(y + row);
         uint8_t bits = glyph[row];
         for (int col = 0; col < 6; col++) {
-            if (x + col < 0 || x + col >= C64_DISPLAY_WIDTH) continue;
+            if (x + col < 0 || x + col >= FB_WIDTH) continue;
             if (bits & (0x80 >> col)) {
-                fb[(y + row) * C64_DISPLAY_WIDTH + (x + col)] = color;
+                line[x + col] = color;
             }
         }
     }
@@ -174,3 +174,10 @@ void fatfs_rewind(FATFS_FILE *fp) {
     if (!fp || !fp->is_open) return;
     f_lseek(&fp->fil, 0);
 }
+
+int fatfs_fflush(FATFS_FILE *fp) {
+    if (!fp || !fp->is_open) return -1;
+
+    FRESULT fr = f_sync(&fp->fil);
+    return (fr == FR_OK) ? 0 : -1;
+}
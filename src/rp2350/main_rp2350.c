@@ -63,13 +63,16 @@ extern "C" {
 void c64_init(void);
 void c64_reset(void);
 bool c64_run_frame(void);
+void c64_render_lines(void);
+void c64_render_audio(void);
+void c64_run_drive(void);
 uint8_t *c64_get_framebuffer(void);
 void c64_set_drive_leds(int l0, int l1, int l2, int l3);
 void c64_show_notification(const char *msg);
+void c64_set_speedometer(int speed);
 
 // Audio interface (from sid_i2s.cpp)
 void sid_i2s_init(void);
-void sid_i2s_update(void);
 
 // Input interface (from input_rp2350.cpp)
 void input_rp2350_init(void);
@@ -114,6 +117,19 @@ static void core1_video_task(void) {
             continue;
         }
 
+#if VIC_RENDER_QUEUE
+        // Draw the raster lines queued by the VIC on core 0
+        c64_render_lines();
+#endif
+#if SID_WRITE_QUEUE
+        // Render the SID register writes queued on core 0
+        c64_render_audio();
+#endif
+#if DRIVE_IEC_QUEUE
+        // Run the 1541 processor up to the C64's cycle
+        c64_run_drive();
+#endif
+
         // Wait for vsync (new frame)
         uint32_t frame_count = get_frame_count();
         if (frame_count == last_frame_count) {
@@ -138,6 +154,27 @@ static void core1_video_task(void) {
 
     MII_DEBUG_PRINTF("Core 1: Video task ending\n");
 }
+#elif VIC_RENDER_QUEUE || SID_WRITE_QUEUE || DRIVE_IEC_QUEUE
+static void core1_render_task(void) {
+    MII_DEBUG_PRINTF("Core 1: Starting render task\n");
+    multicore_lockout_victim_init();
+
+    while (!g_quit_requested) {
+        if (!g_emulator_ready) {
+            sleep_ms(1);
+            continue;
+        }
+#if VIC_RENDER_QUEUE
+        c64_render_lines();
+#endif
+#if SID_WRITE_QUEUE
+        c64_render_audio();
+#endif
+#if DRIVE_IEC_QUEUE
+        c64_run_drive();
+#endif
+    }
+}
 #endif
 
 //=============================================================================
@@ -508,14 +545,12 @@ static void emulator_main_loop(void) {
     // watchdog_enable(2000, true);
 
     while (!g_quit_requested) {
+        uint64_t frame_start_us = rp2350_get_ticks_us();
         if (!disk_ui_is_visible()) {
             // Run one frame of C64 emulation
           //  if (first_frame) MII_DEBUG_PRINTF("Running first frame...\n");
             c64_run_frame();
           //  if (first_frame) { MII_DEBUG_PRINTF("First frame done\n"); first_frame = false; }
-
-            // Update audio (SID -> I2S)
-            sid_i2s_update();
         } else {
             input_rp2350_poll_no_c64_acts();
             disk_ui_render();
@@ -528,6 +563,9 @@ static void emulator_main_loop(void) {
         next_frame_time += FRAME_TIME_US;
         uint64_t now_us = rp2350_get_ticks_us();
 
+        // Speedometer shows up when a frame takes longer than real time
+        c64_set_speedometer((int)(FRAME_TIME_US * 100 / (now_us - frame_start_us + 1)));
+
         if (now_us < next_frame_time) {
             // Emulation is faster than real-time, wait
             uint32_t wait_us = (uint32_t)(next_frame_time - now_us);
@@ -585,6 +623,10 @@ int main(void) {
     MII_DEBUG_PRINTF("Launching Core 1...\n");
     multicore_launch_core1(core1_video_task);
     sleep_ms(100);  // Let Core 1 initialize HDMI IRQ
+#elif VIC_RENDER_QUEUE || SID_WRITE_QUEUE || DRIVE_IEC_QUEUE
+    // Core 1 draws the VIC raster lines, renders the SID audio and/or runs
+    // the 1541 processor
+    multicore_launch_core1(core1_render_task);
 #endif
 
     // Show start screen with system information
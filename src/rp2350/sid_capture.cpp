@@ -0,0 +1,178 @@
+/*
+ *  sid_capture.cpp - SID register write capture
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Records are collected in a RAM buffer and appended to the file from the
+ *  frame loop, so the SD card is only touched between frames (or when a
+ *  digi player fills the buffer within a frame).
+ */
+
+#include "../sysdeps.h"
+#include "../C64.h"
+#include "../VIC.h"
+#include "../SID.h"
+
+#if SID_CAPTURE
+
+#include "debug_log.h"
+#include "fatfs/ff.h"
+
+#include <cstring>
+
+// Size of the record buffer
+static constexpr unsigned CAPTURE_BUFFER_SIZE = 4096;
+
+// Frames between writes of the buffer to the file
+static constexpr unsigned CAPTURE_SYNC_FRAMES = 50;
+
+bool sid_capture_active = false;
+uint32_t sid_capture_lines = 0;
+
+static FIL capture_file;
+static uint8_t capture_buffer[CAPTURE_BUFFER_SIZE];
+static unsigned capture_fill = 0;
+static unsigned capture_frames = 0;
+
+
+/*
+ *  Append the buffer to the file
+ */
+
+static void write_buffer()
+{
+    UINT written = 0;
+    if (capture_fill > 0 && (f_write(&capture_file, capture_buffer, capture_fill, &written) != FR_OK || written != capture_fill)) {
+        MII_DEBUG_PRINTF("SID capture: write failed, stopped\n");
+        sid_capture_active = false;
+        f_close(&capture_file);
+    }
+    capture_fill = 0;
+}
+
+
+/*
+ *  Add records for the lines since the last record
+ */
+
+static void put_skip()
+{
+    while (sid_capture_lines > 0 && sid_capture_active) {
+        uint32_t lines = sid_capture_lines < 0xffffff ? sid_capture_lines : 0xffffff;
+        if (capture_fill + SID_CAPTURE_RECORD_SIZE > CAPTURE_BUFFER_SIZE) {
+            write_buffer();
+        }
+        uint8_t *p = capture_buffer + capture_fill;
+        p[0] = SID_CAPTURE_SKIP;
+        p[1] = lines & 0xff;
+        p[2] = (lines >> 8) & 0xff;
+        p[3] = lines >> 16;
+        capture_fill += SID_CAPTURE_RECORD_SIZE;
+        sid_capture_lines -= lines;
+    }
+}
+
+
+/*
+ *  Log one register write
+ */
+
+void sid_capture_record(uint8_t reg, uint8_t val, uint8_t cycle)
+{
+    if (sid_capture_lines > 0xff) {
+        put_skip();
+    }
+    if (capture_fill + SID_CAPTURE_RECORD_SIZE > CAPTURE_BUFFER_SIZE) {
+        write_buffer();
+        if (!sid_capture_active) {
+            return;
+        }
+    }
+
+    uint8_t *p = capture_buffer + capture_fill;
+    p[0] = reg;
+    p[1] = val;
+    p[2] = cycle;
+    p[3] = (uint8_t)sid_capture_lines;
+    capture_fill += SID_CAPTURE_RECORD_SIZE;
+    sid_capture_lines = 0;
+}
+
+
+/*
+ *  Start a new log
+ */
+
+void sid_capture_start(int sid_type, uint16_t sid2_adr, uint16_t sid3_adr)
+{
+    sid_capture_stop();
+
+    if (f_open(&capture_file, SID_CAPTURE_FILE, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+        MII_DEBUG_PRINTF("SID capture: cannot create %s\n", SID_CAPTURE_FILE);
+        return;
+    }
+
+    uint8_t *h = capture_buffer;
+    memset(h, 0, SID_CAPTURE_HEADER_SIZE);
+    memcpy(h, "SIDL", 4);
+    h[4] = SID_CAPTURE_VERSION;
+    h[5] = (uint8_t)sid_type;
+    h[6] = CYCLES_PER_LINE;
+    h[8] = TOTAL_RASTERS & 0xff;
+    h[9] = TOTAL_RASTERS >> 8;
+    h[10] = sid2_adr & 0xff;
+    h[11] = sid2_adr >> 8;
+    h[12] = sid3_adr & 0xff;
+    h[13] = sid3_adr >> 8;
+    capture_fill = SID_CAPTURE_HEADER_SIZE;
+    capture_frames = 0;
+    sid_capture_lines = 0;
+    sid_capture_active = true;
+
+    MII_DEBUG_PRINTF("SID capture: logging to %s\n", SID_CAPTURE_FILE);
+}
+
+
+/*
+ *  Stop logging
+ */
+
+void sid_capture_stop()
+{
+    if (sid_capture_active) {
+        put_skip();
+        write_buffer();
+        if (sid_capture_active) {
+            f_close(&capture_file);
+            sid_capture_active = false;
+        }
+    }
+}
+
+
+/*
+ *  Write out the log every CAPTURE_SYNC_FRAMES frames, so the file on the
+ *  card is complete up to the last second when the power goes off
+ */
+
+void sid_capture_flush()
+{
+    if (!sid_capture_active || ++capture_frames < CAPTURE_SYNC_FRAMES) {
+        return;
+    }
+    capture_frames = 0;
+
+    put_skip();
+    write_buffer();
+    if (sid_capture_active) {
+        f_sync(&capture_file);
+    }
+}
+
+#endif // SID_CAPTURE
@@ -0,0 +1,86 @@
+/*
+ *  sid_capture.h - SID register write capture
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  With SID_CAPTURE, every write to a SID register is logged with its
+ *  raster line and cycle to SID_CAPTURE_FILE on the SD card. The log
+ *  restarts on every C64 reset and is written out once per frame.
+ *  murmc64_sidbench -log replays it through the SID renderer.
+ *
+ *  File format (little-endian):
+ *
+ *    Header, 16 bytes:
+ *      0   "SIDL"
+ *      4   format version (SID_CAPTURE_VERSION)
+ *      5   SID type (Prefs::SIDType)
+ *      6   cycles per raster line
+ *      7   reserved (0)
+ *      8   raster lines per frame (16 bits)
+ *      10  address of the second and third SID (16 bits each, 0 = none)
+ *      14  reserved (0)
+ *
+ *    Records, 4 bytes each:
+ *      0   register | chip << 5 (chip 0 = $d400, 1/2 = extra SIDs)
+ *      1   value
+ *      2   cycle within the raster line
+ *      3   raster lines since the previous record
+ *    or
+ *      0   SID_CAPTURE_SKIP
+ *      1   number of raster lines without a write (24 bits)
+ *
+ *  A raster line is counted when MOS6581::EmulateLine() runs, which is
+ *  before the CPU executes that line.
+ */
+
+#ifndef SID_CAPTURE_H
+#define SID_CAPTURE_H
+
+#include <stdint.h>
+
+#define SID_CAPTURE_FILE "/sidcap.bin"
+
+constexpr uint8_t SID_CAPTURE_VERSION = 1;
+constexpr unsigned SID_CAPTURE_HEADER_SIZE = 16;
+constexpr unsigned SID_CAPTURE_RECORD_SIZE = 4;
+constexpr uint8_t SID_CAPTURE_SKIP = 0x80;
+
+#if SID_CAPTURE
+
+extern bool sid_capture_active;
+extern uint32_t sid_capture_lines;  // Lines since the last record
+
+// Start a new log, replacing an existing file
+void sid_capture_start(int sid_type, uint16_t sid2_adr, uint16_t sid3_adr);
+
+// Stop logging and close the file
+void sid_capture_stop();
+
+// Write the logged records to the file, called once per frame
+void sid_capture_flush();
+
+void sid_capture_record(uint8_t reg, uint8_t val, uint8_t cycle);
+
+// Called by MOS6581::EmulateLine() of the SID at $d400
+static inline void sid_capture_line()
+{
+    ++sid_capture_lines;
+}
+
+// Called by MOS6581::WriteRegister(), reg carries the chip number
+static inline void sid_capture_write(uint8_t reg, uint8_t val, unsigned cycle)
+{
+    if (sid_capture_active) {
+        sid_capture_record(reg, val, (uint8_t)cycle);
+    }
+}
+
+#endif // SID_CAPTURE
+
+#endif // SID_CAPTURE_H
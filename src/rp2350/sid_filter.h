@@ -0,0 +1,257 @@
+/*
+ *  sid_filter.h - Fixed-point SID filter for RP2350
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Two-integrator (Chamberlin) state-variable filter, run once per output
+ *  sample. The 11-bit cutoff register is mapped to the filter coefficient
+ *  through a table built for the 6581 or 8580 curve when the SID type is
+ *  set (SIDFilterCurve, shared by the filters of all emulated SIDs), and
+ *  the resonance through a 16-entry table, so clocking the filter takes
+ *  three integer multiplies and no floating point.
+ *
+ *  SIDFilterFloat is the same filter computed in float from the same
+ *  curves. It is not used by the emulator; murmc64_sidbench runs both and
+ *  compares their output.
+ */
+
+#ifndef SID_FILTER_H
+#define SID_FILTER_H
+
+#include <stdint.h>
+#include <math.h>
+
+// Fractional bits of the filter coefficients
+constexpr int SID_FILTER_FRAC = 15;
+
+// Upper limit of the cutoff coefficient. Beyond 2 * sin(pi * f / fs) =
+// sqrt(q^2 + 4) - q the filter is unstable; keep some distance from it.
+constexpr float SID_FILTER_MAX_W0 = 1.25f;
+constexpr float SID_FILTER_STABILITY = 0.9f;
+
+
+/*
+ *  Cutoff frequency in Hz for an FC register value (0..2047)
+ */
+inline float sid_filter_cutoff_hz(unsigned fc, bool is6581)
+{
+    struct Point {
+        uint16_t fc;
+        uint16_t hz;
+    };
+
+    // Measured 6581 curve, strongly non-linear with a step at FC = 1024
+    static const Point curve_6581[] = {
+        {    0,   220 }, {  128,   230 }, {  256,   250 }, {  384,   300 },
+        {  512,   420 }, {  640,   780 }, {  768,  1600 }, {  832,  2300 },
+        {  896,  3200 }, {  960,  4300 }, {  992,  5000 }, { 1008,  5400 },
+        { 1016,  5700 }, { 1023,  6000 }, { 1024,  4600 }, { 1032,  4800 },
+        { 1056,  5300 }, { 1088,  6000 }, { 1120,  6600 }, { 1152,  7200 },
+        { 1280,  9500 }, { 1536, 12000 }, { 1792, 14500 }, { 2047, 16000 }
+    };
+
+    // The 8580 is close to linear
+    static const Point curve_8580[] = {
+        {    0,    30 }, { 2047, 12500 }
+    };
+
+    const Point *curve = is6581 ? curve_6581 : curve_8580;
+    unsigned n = is6581 ? sizeof(curve_6581) / sizeof(Point) : sizeof(curve_8580) / sizeof(Point);
+
+    unsigned i = 1;
+    while (i < n - 1 && fc > curve[i].fc) {
+        ++i;
+    }
+    const Point &a = curve[i - 1];
+    const Point &b = curve[i];
+    return a.hz + (float)(b.hz - a.hz) * (float)(fc - a.fc) / (float)(b.fc - a.fc);
+}
+
+
+/*
+ *  Damping 1/Q for a resonance value (0..15)
+ */
+inline float sid_filter_damping(unsigned res, bool is6581)
+{
+    if (is6581) {
+        return 1.0f / (0.707f + (float)res / 15.0f);
+    } else {
+        return powf(2.0f, (4.0f - (float)res) / 8.0f);
+    }
+}
+
+
+/*
+ *  Largest stable cutoff coefficient for a damping value
+ */
+inline float sid_filter_max_w0(float damping)
+{
+    float limit = (sqrtf(damping * damping + 4.0f) - damping) * SID_FILTER_STABILITY;
+    return limit < SID_FILTER_MAX_W0 ? limit : SID_FILTER_MAX_W0;
+}
+
+
+/*
+ *  Cutoff coefficient 2 * sin(pi * f / fs), not yet limited
+ */
+inline float sid_filter_w0(unsigned fc, bool is6581, unsigned sample_freq)
+{
+    return 2.0f * sinf(3.14159265f * sid_filter_cutoff_hz(fc, is6581) / (float)sample_freq);
+}
+
+
+/*
+ *  Coefficient tables of the fixed-point filter for one SID type, shared
+ *  by all filters of that type
+ */
+struct SIDFilterCurve {
+    void Build(bool is6581, unsigned sample_freq)
+    {
+        for (unsigned fc = 0; fc < 2048; ++fc) {
+            float w0 = sid_filter_w0(fc, is6581, sample_freq);
+            if (w0 > SID_FILTER_MAX_W0) {
+                w0 = SID_FILTER_MAX_W0;
+            }
+            w0_table[fc] = (uint16_t)(w0 * (1 << SID_FILTER_FRAC) + 0.5f);
+        }
+        for (unsigned res = 0; res < 16; ++res) {
+            float damping = sid_filter_damping(res, is6581);
+            damping_table[res] = (uint16_t)(damping * (1 << SID_FILTER_FRAC) + 0.5f);
+            w0_max[res] = (uint16_t)(sid_filter_max_w0(damping) * (1 << SID_FILTER_FRAC) + 0.5f);
+        }
+    }
+
+    uint16_t w0_table[2048] = {};     // Cutoff coefficient per FC value
+    uint16_t damping_table[16] = {};  // 1/Q per resonance value
+    uint16_t w0_max[16] = {};         // Stability limit of w0 per resonance value
+};
+
+
+/*
+ *  Fixed-point filter
+ */
+class SIDFilter {
+public:
+    // Select the tables for the SID type, then call SetRegs()
+    void SetCurve(const SIDFilterCurve *c)
+    {
+        curve = c;
+    }
+
+    void SetRegs(uint16_t fc, uint8_t res)
+    {
+        w0 = curve->w0_table[fc & 0x7ff];
+        if (w0 > curve->w0_max[res & 0xf]) {
+            w0 = curve->w0_max[res & 0xf];
+        }
+        damping = curve->damping_table[res & 0xf];
+    }
+
+    void Reset()
+    {
+        bp = lp = 0;
+    }
+
+    // True if the filter has settled to zero, so it outputs zero as long
+    // as its input is zero
+    bool Idle() const
+    {
+        return (bp | lp) == 0;
+    }
+
+    // Clock one sample; mode is the MODE/VOL register (bits 4..6 select
+    // low-, band- and high-pass)
+    int32_t Clock(int32_t in, uint8_t mode)
+    {
+        int32_t hp = in - lp - (int32_t)(((int64_t)bp * damping) >> SID_FILTER_FRAC);
+        bp += (int32_t)(((int64_t)hp * w0) >> SID_FILTER_FRAC);
+        lp += (int32_t)(((int64_t)bp * w0) >> SID_FILTER_FRAC);
+
+        int32_t out = 0;
+        if (mode & 0x10) {
+            out += lp;
+        }
+        if (mode & 0x20) {
+            out += bp;
+        }
+        if (mode & 0x40) {
+            out += hp;
+        }
+        return out;
+    }
+
+private:
+    const SIDFilterCurve *curve = nullptr;
+
+    int32_t w0 = 0;
+    int32_t damping = 0;
+    int32_t bp = 0;
+    int32_t lp = 0;
+};
+
+
+/*
+ *  Float reference of SIDFilter
+ */
+class SIDFilterFloat {
+public:
+    void SetType(bool is6581_, unsigned sample_freq_)
+    {
+        is6581 = is6581_;
+        sample_freq = sample_freq_;
+    }
+
+    void SetRegs(uint16_t fc, uint8_t res)
+    {
+        damping = sid_filter_damping(res & 0xf, is6581);
+        w0 = sid_filter_w0(fc & 0x7ff, is6581, sample_freq);
+        if (w0 > SID_FILTER_MAX_W0) {
+            w0 = SID_FILTER_MAX_W0;
+        }
+        float limit = sid_filter_max_w0(damping);
+        if (w0 > limit) {
+            w0 = limit;
+        }
+    }
+
+    void Reset()
+    {
+        bp = lp = 0.0f;
+    }
+
+    int32_t Clock(int32_t in, uint8_t mode)
+    {
+        float hp = (float)in - lp - bp * damping;
+        bp += hp * w0;
+        lp += bp * w0;
+
+        float out = 0.0f;
+        if (mode & 0x10) {
+            out += lp;
+        }
+        if (mode & 0x20) {
+            out += bp;
+        }
+        if (mode & 0x40) {
+            out += hp;
+        }
+        return (int32_t)out;
+    }
+
+private:
+    bool is6581 = true;
+    unsigned sample_freq = 44100;
+
+    float w0 = 0.0f;
+    float damping = 0.0f;
+    float bp = 0.0f;
+    float lp = 0.0f;
+};
+
+#endif // SID_FILTER_H
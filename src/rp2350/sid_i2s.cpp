@@ -9,10 +9,13 @@
  *  the Free Software Foundation; either version 2 of the License, or
  *  (at your option) any later version.
  *
- *  Uses the murmgenesis audio driver (double-buffered DMA ping-pong).
+ *  Uses the murmgenesis audio driver (double-buffered DMA ping-pong). The
+ *  DMA interrupt pulls each buffer from the ring as it is played, and the
+ *  SID sample rate follows the fill level of the ring.
  */
 
 #include "../board_config.h"
+#include "sid_i2s.h"
 
 extern "C" {
 #include "debug_log.h"
@@ -28,13 +31,34 @@ extern "C" {
 // Configuration
 //=============================================================================
 
-// Ring buffer for SID samples - large enough for smooth playback
+// Ring buffer for SID samples (power of two)
 #define SID_RING_BUFFER_SIZE 4096
 
-// Target samples per frame (PAL: 50Hz, NTSC: 60Hz)
-// At 44100 Hz: PAL = 882 samples/frame, NTSC = 735 samples/frame
-#define TARGET_SAMPLES_PAL   882
-#define TARGET_SAMPLES_NTSC  735
+// Ring fill the clock recovery aims for, measured after the DMA interrupt
+// took a buffer. This is the margin for frames that finish late (17 ms);
+// the latency it adds is the price for not running dry.
+#ifndef SID_AUDIO_TARGET_FILL
+#define SID_AUDIO_TARGET_FILL 768
+#endif
+
+// Largest correction of the SID sample rate (0.5%, in 2^-20 units)
+#define SID_RATE_ADJUST_MAX 5243
+
+// Samples crossfaded from the held output when playback resumes
+#define SID_FADE_SAMPLES 16
+
+#if AUDIO_DIRECT
+// Largest block of the ring handed to the DMA at once (5.8 ms), and the
+// smallest, so the interrupt has time to queue the next block
+#define SID_DIRECT_BLOCK     256
+#define SID_DIRECT_MIN_BLOCK 32
+
+// Block played while the ring is empty, fading the last level to silence
+#define SID_HOLD_SAMPLES 64
+
+static_assert(SID_PWM_BITS == AUDIO_PWM_BITS, "PWM resolution mismatch");
+static_assert(SID_OUT_UNITY == AUDIO_GAIN_UNITY, "Output gain mismatch");
+#endif
 
 //=============================================================================
 // I2S Audio State
@@ -44,136 +68,302 @@ static struct {
     bool initialized;
 
     // Ring buffer for samples from SID emulation
-    int16_t ring_buffer[SID_RING_BUFFER_SIZE * 2];  // Stereo
+    sid_out_t ring_buffer[SID_RING_BUFFER_SIZE * SID_OUT_CHANNELS];
     volatile uint32_t write_index;
     volatile uint32_t read_index;
+#if AUDIO_DIRECT
+    uint32_t queue_index;   // Samples handed to the DMA (read_index..queue_index playing)
+
+    // Alternating blocks played on underrun, one may still be queued
+    sid_out_t hold_block[2][SID_HOLD_SAMPLES];
+    unsigned hold_next;
+#endif
+
+    // Playback only starts (again) once the ring is filled to the target
+    bool playing;
+    unsigned fade_pos;      // Samples played since playback resumed
 
     // Last sample for crossfade (to prevent clicks)
     int16_t last_left;
     int16_t last_right;
 
+    // Clock recovery
+    int32_t integral;       // Sum of the fill errors
+    volatile int32_t rate_adjust;
+
+    sid_audio_stats_t stats;
+
 } audio_state;
 
-// Mixed buffer for output to I2S
-static int16_t __attribute__((aligned(4))) mixed_buffer[AUDIO_BUFFER_SAMPLES * 2];
+//=============================================================================
+// Audio clock recovery
+//=============================================================================
+
+// PI controller on the ring fill, run once per DMA buffer: too full means
+// the SID produces faster than the DAC plays, so its rate is lowered
+static void recover_clock(uint32_t fill, uint32_t played)
+{
+    int32_t error = (int32_t)fill - SID_AUDIO_TARGET_FILL;
+
+    // Integrate per 1024 samples played, whatever the buffer size
+    int32_t integral = audio_state.integral + ((error * (int32_t)played) >> 10);
+    const int32_t integral_max = SID_RATE_ADJUST_MAX << 4;
+    if (integral > integral_max) {
+        integral = integral_max;
+    } else if (integral < -integral_max) {
+        integral = -integral_max;
+    }
+    audio_state.integral = integral;
+
+    int32_t adjust = -(error * 6 + (integral >> 4));
+    if (adjust > SID_RATE_ADJUST_MAX) {
+        adjust = SID_RATE_ADJUST_MAX;
+    } else if (adjust < -SID_RATE_ADJUST_MAX) {
+        adjust = -SID_RATE_ADJUST_MAX;
+    }
+    audio_state.rate_adjust = adjust;
+
+    sid_audio_stats_t &st = audio_state.stats;
+    st.fill = fill;
+    if (fill < st.fill_min) {
+        st.fill_min = fill;
+    }
+    if (fill > st.fill_max) {
+        st.fill_max = fill;
+    }
+}
 
 //=============================================================================
 // I2S Audio Functions
 //=============================================================================
 
-extern "C" {
+#if AUDIO_DIRECT
 
-void sid_i2s_init(void)
+// Level of a sample in the output format, and back
+static inline int32_t out_level(sid_out_t v)
 {
-    if (audio_state.initialized) {
-        return;
-    }
-
-    memset(&audio_state, 0, sizeof(audio_state));
+#if defined(FEATURE_AUDIO_PWM)
+    return v;
+#else
+    return (int16_t)v;
+#endif
+}
 
-    // Initialize the murmgenesis audio driver
-    if (!audio_init()) {
-        MII_DEBUG_PRINTF("sid_i2s_init: audio_init failed\n");
-        return;
+// Hand the DMA a block fading the last output level to silence
+static const uint16_t *sid_hold_block(uint32_t *count)
+{
+    sid_out_t *block = audio_state.hold_block[audio_state.hold_next];
+    audio_state.hold_next ^= 1;
+
+    const int32_t zero = out_level(sid_out_sample(0));
+    int32_t level = audio_state.last_left;
+    for (unsigned i = 0; i < SID_HOLD_SAMPLES; ++i) {
+        level = zero + (((level - zero) * 240) >> 8);
+        block[i] = (sid_out_t)level;
     }
+    audio_state.last_left = (int16_t)(level - zero);
 
-    audio_state.initialized = true;
-    MII_DEBUG_PRINTF("SID I2S audio initialized (murmgenesis driver)\n");
+    *count = SID_HOLD_SAMPLES;
+    return block;
 }
 
-void sid_i2s_update(void)
+// Retire the block the DMA finished and hand it the next part of the ring
+// (called from the audio DMA interrupt)
+static const uint16_t *sid_next_block(const uint16_t *done, uint32_t done_count, uint32_t *count)
 {
-    if (!audio_state.initialized) {
-        return;
+    const sid_out_t *ring = audio_state.ring_buffer;
+    if (done >= ring && done < ring + SID_RING_BUFFER_SIZE) {
+        // The renderer may use this part of the ring again
+        __dmb();
+        audio_state.read_index = audio_state.read_index + done_count;
     }
 
-    // Memory barrier to ensure we see latest write_index
+    uint32_t queue_idx = audio_state.queue_index;
+    uint32_t available = audio_state.write_index - queue_idx;
     __dmb();
 
-    // Calculate how many samples are available in ring buffer
+    if (!audio_state.playing) {
+        // (Re)start once there is a block plus the margin
+        if (available < SID_DIRECT_BLOCK + SID_AUDIO_TARGET_FILL) {
+            return sid_hold_block(count);
+        }
+        audio_state.playing = true;
+        audio_state.fade_pos = 0;
+    }
+
+    if (available < SID_DIRECT_MIN_BLOCK) {
+        // Buffer underrun: fade to silence and wait for the ring to refill
+        audio_state.playing = false;
+        audio_state.stats.underruns++;
+        audio_state.stats.underrun_samples += SID_HOLD_SAMPLES;
+        return sid_hold_block(count);
+    }
+
+    uint32_t pos = queue_idx & (SID_RING_BUFFER_SIZE - 1);
+    uint32_t n = available < SID_DIRECT_BLOCK ? available : SID_DIRECT_BLOCK;
+    if (n > SID_RING_BUFFER_SIZE - pos) {
+        n = SID_RING_BUFFER_SIZE - pos;
+    }
+    sid_out_t *block = &audio_state.ring_buffer[pos];
+
+    // Crossfade in place from the held level after a restart (the renderer
+    // does not touch committed samples)
+    const int32_t zero = out_level(sid_out_sample(0));
+    int32_t held = zero + audio_state.last_left;
+    for (uint32_t i = 0; i < n && audio_state.fade_pos < SID_FADE_SAMPLES; ++i) {
+        int fade_in = (audio_state.fade_pos++ * 256) / SID_FADE_SAMPLES;
+        int fade_out = 256 - fade_in;
+        block[i] = (sid_out_t)((out_level(block[i]) * fade_in + held * fade_out) >> 8);
+    }
+    audio_state.last_left = (int16_t)(out_level(block[n - 1]) - zero);
+
+    audio_state.queue_index = queue_idx + n;
+    recover_clock(available - n, n);
+
+    *count = n;
+    return block;
+}
+
+#else
+
+// Fill a DMA buffer from the ring (called from the audio DMA interrupt)
+static void sid_fill_buffer(int16_t *out, uint32_t count)
+{
     uint32_t read_idx = audio_state.read_index;
-    uint32_t write_idx = audio_state.write_index;
-    int32_t available = (int32_t)(write_idx - read_idx);
-    if (available < 0) available = 0;
-
-    // Target samples per frame (use PAL timing for C64)
-    int target_samples = TARGET_SAMPLES_PAL;
-
-    // Fill output buffer from ring buffer
-    for (int i = 0; i < target_samples; i++) {
-        int16_t left = 0;
-        int16_t right = 0;
-
-        if (available > 0) {
-            // Read from ring buffer
-            uint32_t buf_idx = (read_idx & (SID_RING_BUFFER_SIZE - 1)) * 2;
-            left = audio_state.ring_buffer[buf_idx];
-            right = audio_state.ring_buffer[buf_idx + 1];
-            read_idx++;
-            available--;
-
-            // Crossfade from last sample at start of buffer
-            if (i < 16) {
-                int fade_in = (i * 256) / 16;
-                int fade_out = 256 - fade_in;
-                left = (int16_t)((left * fade_in + audio_state.last_left * fade_out) >> 8);
-                right = (int16_t)((right * fade_in + audio_state.last_right * fade_out) >> 8);
-            }
+    uint32_t available = audio_state.write_index - read_idx;
+    __dmb();
+
+    if (!audio_state.playing) {
+        // (Re)start once there is enough for this buffer and the margin
+        if (available >= count + SID_AUDIO_TARGET_FILL) {
+            audio_state.playing = true;
+            audio_state.fade_pos = 0;
         } else {
-            // Buffer underrun: fade to silence
-            left = (audio_state.last_left * 240) >> 8;
-            right = (audio_state.last_right * 240) >> 8;
+            memset(out, 0, count * 2 * sizeof(int16_t));
+            audio_state.last_left = audio_state.last_right = 0;
+            return;
         }
+    }
+
+    uint32_t n = available < count ? available : count;
+
+    // Copy in up to two pieces around the end of the ring
+    uint32_t pos = read_idx & (SID_RING_BUFFER_SIZE - 1);
+    uint32_t first = SID_RING_BUFFER_SIZE - pos;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(out, &audio_state.ring_buffer[pos * 2], first * 2 * sizeof(int16_t));
+    memcpy(out + first * 2, audio_state.ring_buffer, (n - first) * 2 * sizeof(int16_t));
+
+    // Crossfade from the held sample after a restart
+    for (uint32_t i = 0; i < n && audio_state.fade_pos < SID_FADE_SAMPLES; ++i) {
+        int fade_in = (audio_state.fade_pos++ * 256) / SID_FADE_SAMPLES;
+        int fade_out = 256 - fade_in;
+        out[i * 2] = (int16_t)((out[i * 2] * fade_in + audio_state.last_left * fade_out) >> 8);
+        out[i * 2 + 1] = (int16_t)((out[i * 2 + 1] * fade_in + audio_state.last_right * fade_out) >> 8);
+    }
+
+    if (n > 0) {
+        audio_state.last_left = out[(n - 1) * 2];
+        audio_state.last_right = out[(n - 1) * 2 + 1];
+    }
 
-        // Update last sample
+    if (n < count) {
+        // Buffer underrun: fade to silence and wait for the ring to refill
+        int16_t left = audio_state.last_left;
+        int16_t right = audio_state.last_right;
+        for (uint32_t i = n; i < count; ++i) {
+            left = (left * 240) >> 8;
+            right = (right * 240) >> 8;
+            out[i * 2] = left;
+            out[i * 2 + 1] = right;
+        }
         audio_state.last_left = left;
         audio_state.last_right = right;
-
-        // Write to output buffer (stereo interleaved)
-        mixed_buffer[i * 2] = left;
-        mixed_buffer[i * 2 + 1] = right;
+        audio_state.playing = false;
+        audio_state.stats.underruns++;
+        audio_state.stats.underrun_samples += count - n;
     }
 
     // Update read index
     __dmb();
-    audio_state.read_index = read_idx;
+    audio_state.read_index = read_idx + n;
 
-#if defined(FEATURE_AUDIO_I2S)
-    // Submit to I2S DMA
-    i2s_config_t *config = audio_get_i2s_config();
-    i2s_dma_write_count(config, mixed_buffer, target_samples);
-#endif
-#if defined(FEATURE_AUDIO_PWM)
-    pwm_dma_write_count(mixed_buffer, target_samples);
+    recover_clock(available - n, count);
+}
+
+#endif  // AUDIO_DIRECT
+
+extern "C" {
+
+void sid_i2s_init(void)
+{
+    if (audio_state.initialized) {
+        return;
+    }
+
+    memset(&audio_state, 0, sizeof(audio_state));
+    sid_reset_audio_stats();
+
+    // Initialize the murmgenesis audio driver
+    if (!audio_init()) {
+        MII_DEBUG_PRINTF("sid_i2s_init: audio_init failed\n");
+        return;
+    }
+
+    audio_state.initialized = true;
+
+    // From now on the DMA interrupt pulls the samples
+#if AUDIO_DIRECT
+    audio_start_direct(sid_next_block);
+#else
+    audio_start_callback(sid_fill_buffer);
 #endif
+    MII_DEBUG_PRINTF("SID I2S audio initialized (murmgenesis driver)\n");
 }
 
-// Add samples to the SID ring buffer (called from SID emulation)
-void sid_add_sample(int16_t left, int16_t right)
+sid_out_t *sid_get_write_block(unsigned *count)
 {
     if (!audio_state.initialized) {
-        return;
+        *count = 0;
+        return nullptr;
     }
 
     uint32_t write_idx = audio_state.write_index;
     uint32_t read_idx = audio_state.read_index;
 
-    // Calculate available space (with wrap-around)
+    // Free space up to the read position, but not across the end of the ring
+    uint32_t pos = write_idx & (SID_RING_BUFFER_SIZE - 1);
     uint32_t available = SID_RING_BUFFER_SIZE - ((write_idx - read_idx) & (SID_RING_BUFFER_SIZE - 1)) - 1;
+    if (available > SID_RING_BUFFER_SIZE - pos) {
+        available = SID_RING_BUFFER_SIZE - pos;
+    }
 
-    if (available > 0) {
-        uint32_t buf_idx = (write_idx & (SID_RING_BUFFER_SIZE - 1)) * 2;
-        audio_state.ring_buffer[buf_idx] = left;
-        audio_state.ring_buffer[buf_idx + 1] = right;
+    *count = available;
+    return &audio_state.ring_buffer[pos * SID_OUT_CHANNELS];
+}
 
-        // Memory barrier before updating write index
-        __dmb();
-        audio_state.write_index = write_idx + 1;
-    }
-    // else: buffer full, drop sample
+void sid_commit_samples(unsigned count)
+{
+    // Memory barrier before updating write index
+    __dmb();
+    audio_state.write_index = audio_state.write_index + count;
+}
+
+#if AUDIO_DIRECT
+int32_t sid_out_gain(void)
+{
+    return audio_get_gain();
+}
+#endif
+
+void sid_drop_samples(unsigned count)
+{
+    audio_state.stats.overruns++;
+    audio_state.stats.overrun_samples += count;
 }
 
-// Get current sample buffer fill level
 int sid_get_buffer_fill(void)
 {
     int32_t fill = (int32_t)(audio_state.write_index - audio_state.read_index);
@@ -181,4 +371,24 @@ int sid_get_buffer_fill(void)
     return (int)fill;
 }
 
+int32_t sid_get_rate_adjust(void)
+{
+    return audio_state.rate_adjust;
+}
+
+void sid_get_audio_stats(sid_audio_stats_t *stats)
+{
+    *stats = audio_state.stats;
+    stats->rate_ppm = (int32_t)(((int64_t)audio_state.rate_adjust * 1000000) >> 20);
+}
+
+void sid_reset_audio_stats(void)
+{
+    uint32_t irq_state = save_and_disable_interrupts();
+    memset(&audio_state.stats, 0, sizeof(audio_state.stats));
+    audio_state.stats.fill_min = UINT32_MAX;
+    audio_state.stats.target = SID_AUDIO_TARGET_FILL;
+    restore_interrupts(irq_state);
+}
+
 }  // extern "C"
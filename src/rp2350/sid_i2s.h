@@ -0,0 +1,112 @@
+/*
+ *  sid_i2s.h - SID audio output via I2S/PWM for RP2350
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The SID renderer writes samples into a ring buffer that the audio DMA
+ *  interrupt drains at the DAC's clock. The ring fill is kept at a target
+ *  level by slightly adjusting the SID sample rate (audio clock recovery),
+ *  so the emulation and the DAC can run from different clocks.
+ *
+ *  With AUDIO_DIRECT the ring holds one 16-bit word per sample in the
+ *  format the DMA sends to the DAC (signed sample for I2S, compare value
+ *  for PWM), and the DMA plays straight from it. The volume is applied
+ *  in that conversion.
+ */
+
+#ifndef SID_I2S_H
+#define SID_I2S_H
+
+#include <stdint.h>
+
+#ifndef AUDIO_DIRECT
+#define AUDIO_DIRECT 0
+#endif
+
+// PWM compare value range, AUDIO_PWM_BITS of drivers/audio.h
+#define SID_PWM_BITS 12
+
+#if AUDIO_DIRECT
+// One word per sample, played on both channels
+typedef uint16_t sid_out_t;
+#define SID_OUT_CHANNELS 1
+#else
+// Stereo pairs with the same sample on both channels
+typedef int16_t sid_out_t;
+#define SID_OUT_CHANNELS 2
+#endif
+
+// Output gain in 1/65536, AUDIO_GAIN_UNITY of drivers/audio.h
+#define SID_OUT_UNITY 65536
+
+// Convert a sample to the ring buffer format, scaled by gain
+static inline sid_out_t sid_out_sample(int16_t sample, int32_t gain = SID_OUT_UNITY)
+{
+    int32_t s = sample;
+    if (gain != SID_OUT_UNITY) {
+        s = (s * gain) >> 16;
+    }
+#if AUDIO_DIRECT && defined(FEATURE_AUDIO_PWM)
+    return (uint16_t)(s ^ 0x8000) >> (16 - SID_PWM_BITS);
+#else
+    return (sid_out_t)s;
+#endif
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t fill;              // Ring fill after the last buffer was taken
+    uint32_t fill_min;          // Lowest/highest of these since reset
+    uint32_t fill_max;
+    uint32_t target;            // Fill the clock recovery aims for
+    uint32_t underruns;         // Buffers that ran out of samples
+    uint32_t underrun_samples;  // Samples missing in them
+    uint32_t overruns;          // Blocks dropped because the ring was full
+    uint32_t overrun_samples;   // Samples dropped
+    int32_t rate_ppm;           // Current correction of the SID sample rate
+} sid_audio_stats_t;
+
+// Start audio output
+void sid_i2s_init(void);
+
+// Get the free space at the write position of the ring buffer: returns
+// where up to *count samples (SID_OUT_CHANNELS words each) can be written
+// in one piece, sid_commit_samples() then makes them visible
+sid_out_t *sid_get_write_block(unsigned *count);
+
+// Publish samples written to the block from sid_get_write_block()
+void sid_commit_samples(unsigned count);
+
+#if AUDIO_DIRECT
+// Gain of the audio volume settings: the DMA plays the ring as written,
+// so the renderer applies it when converting the samples
+int32_t sid_out_gain(void);
+#endif
+
+// Count samples the renderer had to drop because the ring was full
+void sid_drop_samples(unsigned count);
+
+// Number of samples in the ring buffer
+int sid_get_buffer_fill(void);
+
+// Correction of the SID sample rate in units of 2^-20 of the nominal rate
+int32_t sid_get_rate_adjust(void);
+
+// Audio statistics
+void sid_get_audio_stats(sid_audio_stats_t *stats);
+void sid_reset_audio_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SID_I2S_H
@@ -0,0 +1,419 @@
+/*
+ *  sid_wave_tables.h - Run-length coded combined waveform tables for RP2350
+ *
+ *  MurmC64 - Commodore 64 Emulator for RP2350
+ *  Copyright (c) 2024-2026 Mikhail Matveev <xtreme@rh1.tech>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The tables of ../SID_wave_tables.h (sampled from a 6581R4AR and an
+ *  8580), coded as (length, value) byte pairs. Every entry of those tables
+ *  is a byte repeated in both halves (0x3f3f), so only the byte is kept;
+ *  runs longer than 255 entries are split. MOS6581::set_wave_tables()
+ *  expands the four tables of the active SID type into SRAM.
+ */
+
+#ifndef SID_WAVE_TABLES_RLE_H
+#define SID_WAVE_TABLES_RLE_H
+
+#include <stdint.h>
+
+
+static const uint8_t TriSawRLE_6581[210] = {
+ 0x7e, 0x00, 0x02, 0x03, 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03, 0x3f, 0x00, 0x01, 0x01,
+ 0x38, 0x00, 0x04, 0x0e, 0x04, 0x0f, 0x7e, 0x00, 0x02, 0x03, 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00,
+ 0x02, 0x03, 0x3f, 0x00, 0x01, 0x01, 0x30, 0x00, 0x08, 0x1c, 0x04, 0x1e, 0x04, 0x1f, 0x7e, 0x00,
+ 0x02, 0x03, 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03, 0x3f, 0x00, 0x01, 0x01, 0x38, 0x00,
+ 0x04, 0x0e, 0x04, 0x0f, 0x7e, 0x00, 0x02, 0x03, 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03,
+ 0x3f, 0x00, 0x01, 0x01, 0x20, 0x00, 0x10, 0x38, 0x08, 0x3c, 0x04, 0x3e, 0x04, 0x3f, 0x7e, 0x00,
+ 0x02, 0x03, 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03, 0x3f, 0x00, 0x01, 0x01, 0x38, 0x00,
+ 0x04, 0x0e, 0x04, 0x0f, 0x7e, 0x00, 0x02, 0x03, 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03,
+ 0x3f, 0x00, 0x01, 0x01, 0x30, 0x00, 0x08, 0x1c, 0x04, 0x1e, 0x04, 0x1f, 0x7e, 0x00, 0x02, 0x03,
+ 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03, 0x3f, 0x00, 0x01, 0x01, 0x20, 0x00, 0x18, 0x80,
+ 0x04, 0x8e, 0x01, 0x8f, 0x03, 0x9f, 0x03, 0xc0, 0x02, 0x80, 0x17, 0xc0, 0x01, 0x80, 0x61, 0xc0,
+ 0x02, 0xc3, 0x3f, 0xc0, 0x01, 0xc1, 0x3c, 0xc0, 0x02, 0xc7, 0x02, 0xcf, 0x40, 0xc0, 0x3e, 0xe0,
+ 0x02, 0xe3, 0x30, 0xe0, 0x0f, 0xf0, 0x01, 0xf1, 0x10, 0xf0, 0x1e, 0xf8, 0x09, 0xfc, 0x04, 0xfe,
+ 0x05, 0xff
+};
+
+static const uint8_t TriRectRLE_6581[1224] = {
+ 0xff, 0x00, 0xff, 0x00, 0x01, 0x00, 0x01, 0x3f, 0xff, 0x00, 0x01, 0x5f, 0x7e, 0x00, 0x01, 0x40,
+ 0x01, 0x6f, 0x3d, 0x00, 0x01, 0x40, 0x01, 0x60, 0x01, 0x77, 0x17, 0x00, 0x01, 0x40, 0x03, 0x00,
+ 0x01, 0x60, 0x01, 0x00, 0x02, 0x60, 0x01, 0x7b, 0x07, 0x00, 0x01, 0x60, 0x03, 0x00, 0x01, 0x60,
+ 0x01, 0x00, 0x02, 0x70, 0x01, 0x7d, 0x03, 0x00, 0x01, 0x70, 0x01, 0x00, 0x01, 0x70, 0x01, 0x78,
+ 0x01, 0x7e, 0x01, 0x40, 0x02, 0x78, 0x01, 0x7f, 0x01, 0x78, 0x03, 0x7f, 0xef, 0x00, 0x01, 0x80,
+ 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x02, 0x80, 0x01, 0x9f, 0x3f, 0x00,
+ 0x01, 0x80, 0x1f, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00,
+ 0x01, 0x80, 0x01, 0x00, 0x02, 0x80, 0x01, 0xaf, 0x1f, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80,
+ 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x03, 0x80, 0x01, 0xa0, 0x01, 0xb7, 0x0f, 0x00, 0x01, 0x80,
+ 0x07, 0x00, 0x01, 0x80, 0x01, 0x00, 0x02, 0x80, 0x01, 0xa0, 0x01, 0x80, 0x02, 0xa0, 0x01, 0xbb,
+ 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x02, 0x80, 0x01, 0xa0, 0x01, 0x00, 0x02, 0x80, 0x01, 0xa0,
+ 0x01, 0x80, 0x02, 0xb0, 0x01, 0xbd, 0x01, 0x00, 0x02, 0x80, 0x01, 0xb0, 0x01, 0x80, 0x02, 0xb0,
+ 0x01, 0xbe, 0x01, 0x80, 0x02, 0xb8, 0x01, 0xbf, 0x01, 0xb8, 0x03, 0xbf, 0x3f, 0x00, 0x01, 0x80,
+ 0x1f, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x02, 0x00, 0x01, 0x80,
+ 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xcf, 0x1f, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x01, 0xc0,
+ 0x05, 0x00, 0x02, 0x80, 0x01, 0xc0, 0x01, 0x00, 0x02, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0,
+ 0x01, 0xd7, 0x0b, 0x00, 0x01, 0x80, 0x01, 0x00, 0x02, 0x80, 0x01, 0xc0, 0x03, 0x00, 0x01, 0x80,
+ 0x01, 0x00, 0x02, 0x80, 0x01, 0xc0, 0x01, 0x00, 0x02, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0,
+ 0x01, 0xdb, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x02, 0x80, 0x01, 0xc0, 0x03, 0x80, 0x03, 0xc0,
+ 0x01, 0xd0, 0x01, 0xdd, 0x02, 0x80, 0x03, 0xc0, 0x02, 0xd0, 0x01, 0xde, 0x01, 0xc0, 0x01, 0xd0,
+ 0x01, 0xd8, 0x01, 0xdf, 0x01, 0xd8, 0x03, 0xdf, 0x1b, 0x00, 0x01, 0x80, 0x01, 0x00, 0x02, 0x80,
+ 0x01, 0xc0, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x02, 0x80, 0x01, 0xc0,
+ 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x02, 0x80, 0x01, 0xc0, 0x01, 0x00, 0x02, 0x80, 0x01, 0xe0,
+ 0x01, 0x80, 0x02, 0xe0, 0x01, 0xe7, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00,
+ 0x02, 0x80, 0x01, 0xe0, 0x03, 0x00, 0x04, 0x80, 0x01, 0xe0, 0x02, 0x80, 0x01, 0xc0, 0x01, 0xe0,
+ 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xeb, 0x01, 0x00, 0x04, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0x80,
+ 0x02, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xed, 0x01, 0x80, 0x02, 0xc0, 0x04, 0xe0,
+ 0x01, 0xee, 0x02, 0xe0, 0x01, 0xe8, 0x01, 0xef, 0x01, 0xe8, 0x03, 0xef, 0x06, 0x00, 0x02, 0x80,
+ 0x01, 0x00, 0x04, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0x00, 0x02, 0x80, 0x01, 0xc0, 0x01, 0x80,
+ 0x02, 0xc0, 0x01, 0xe0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x02, 0xf0, 0x01, 0xf3,
+ 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xf0, 0x01, 0x80, 0x01, 0xc0, 0x01, 0xe0,
+ 0x01, 0xf0, 0x01, 0xe0, 0x02, 0xf0, 0x01, 0xf5, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xf0, 0x01, 0xe0,
+ 0x02, 0xf0, 0x01, 0xf6, 0x01, 0xe0, 0x02, 0xf0, 0x01, 0xf7, 0x01, 0xf0, 0x03, 0xf7, 0x02, 0x80,
+ 0x01, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xf0, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xf0,
+ 0x01, 0xe0, 0x01, 0xf0, 0x01, 0xf8, 0x01, 0xf9, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xf0, 0x01, 0xe0,
+ 0x02, 0xf8, 0x01, 0xfa, 0x01, 0xf0, 0x02, 0xf8, 0x01, 0xfb, 0x01, 0xf8, 0x03, 0xfb, 0x01, 0xe0,
+ 0x02, 0xf0, 0x01, 0xf8, 0x01, 0xf0, 0x02, 0xf8, 0x01, 0xfc, 0x01, 0xf0, 0x02, 0xf8, 0x01, 0xfd,
+ 0x01, 0xfc, 0x03, 0xfd, 0x02, 0xf8, 0x01, 0xfc, 0x01, 0xfe, 0x01, 0xfc, 0x03, 0xfe, 0x01, 0xfc,
+ 0x0e, 0xff, 0x01, 0xfc, 0x03, 0xfe, 0x01, 0xfc, 0x01, 0xfe, 0x01, 0xfc, 0x02, 0xf8, 0x03, 0xfd,
+ 0x01, 0xfc, 0x01, 0xfd, 0x02, 0xf8, 0x01, 0xf0, 0x01, 0xfc, 0x02, 0xf8, 0x01, 0xf0, 0x01, 0xf8,
+ 0x02, 0xf0, 0x01, 0xe0, 0x03, 0xfb, 0x01, 0xf8, 0x01, 0xfb, 0x02, 0xf8, 0x01, 0xf0, 0x01, 0xfa,
+ 0x02, 0xf8, 0x01, 0xe0, 0x01, 0xf0, 0x02, 0xe0, 0x01, 0xc0, 0x01, 0xf9, 0x01, 0xf8, 0x01, 0xf0,
+ 0x01, 0xe0, 0x01, 0xf0, 0x02, 0xe0, 0x01, 0xc0, 0x01, 0xf0, 0x02, 0xe0, 0x01, 0xc0, 0x01, 0xe0,
+ 0x01, 0xc0, 0x02, 0x80, 0x03, 0xf7, 0x01, 0xf0, 0x01, 0xf7, 0x02, 0xf0, 0x01, 0xe0, 0x01, 0xf6,
+ 0x02, 0xf0, 0x01, 0xe0, 0x01, 0xf0, 0x02, 0xe0, 0x01, 0xc0, 0x01, 0xf5, 0x02, 0xf0, 0x01, 0xe0,
+ 0x01, 0xf0, 0x01, 0xe0, 0x01, 0xc0, 0x01, 0x80, 0x01, 0xf0, 0x02, 0xc0, 0x01, 0x80, 0x01, 0xc0,
+ 0x03, 0x80, 0x01, 0xf3, 0x02, 0xf0, 0x01, 0xc0, 0x01, 0xe0, 0x02, 0xc0, 0x01, 0x80, 0x01, 0xe0,
+ 0x02, 0xc0, 0x01, 0x80, 0x01, 0xc0, 0x02, 0x80, 0x01, 0x00, 0x01, 0xe0, 0x02, 0xc0, 0x04, 0x80,
+ 0x01, 0x00, 0x03, 0x80, 0x05, 0x00, 0x03, 0xef, 0x01, 0xe8, 0x01, 0xef, 0x02, 0xe8, 0x01, 0xe0,
+ 0x01, 0xee, 0x04, 0xe0, 0x02, 0xc0, 0x01, 0x80, 0x01, 0xed, 0x02, 0xe0, 0x01, 0xc0, 0x01, 0xe0,
+ 0x02, 0xc0, 0x01, 0x80, 0x01, 0xe0, 0x02, 0xc0, 0x01, 0x80, 0x01, 0xc0, 0x02, 0x80, 0x01, 0x00,
+ 0x01, 0xeb, 0x02, 0xe0, 0x01, 0xc0, 0x01, 0xe0, 0x02, 0xc0, 0x01, 0x80, 0x01, 0xe0, 0x04, 0x80,
+ 0x03, 0x00, 0x01, 0xe0, 0x02, 0x80, 0x01, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x07, 0x00,
+ 0x01, 0xe7, 0x02, 0xe0, 0x01, 0x80, 0x01, 0xe0, 0x02, 0x80, 0x01, 0x00, 0x01, 0xe0, 0x02, 0x80,
+ 0x01, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0xc0, 0x02, 0x80, 0x01, 0x00, 0x01, 0x80, 0x03, 0x00,
+ 0x01, 0x80, 0x07, 0x00, 0x01, 0xc0, 0x02, 0x80, 0x01, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80,
+ 0x17, 0x00, 0x03, 0xdf, 0x01, 0xd8, 0x01, 0xdf, 0x01, 0xd8, 0x01, 0xd0, 0x01, 0xc0, 0x01, 0xde,
+ 0x02, 0xd0, 0x03, 0xc0, 0x02, 0x80, 0x01, 0xdd, 0x01, 0xd0, 0x03, 0xc0, 0x03, 0x80, 0x01, 0xc0,
+ 0x02, 0x80, 0x01, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0xdb, 0x02, 0xc0, 0x01, 0x80, 0x01, 0xc0,
+ 0x02, 0x80, 0x01, 0x00, 0x01, 0xc0, 0x02, 0x80, 0x01, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0xc0,
+ 0x02, 0x80, 0x01, 0x00, 0x01, 0x80, 0x0b, 0x00, 0x01, 0xd7, 0x02, 0xc0, 0x01, 0x80, 0x01, 0xc0,
+ 0x02, 0x80, 0x01, 0x00, 0x01, 0xc0, 0x02, 0x80, 0x05, 0x00, 0x01, 0xc0, 0x0f, 0x00, 0x01, 0xc0,
+ 0x1f, 0x00, 0x01, 0xcf, 0x02, 0xc0, 0x01, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0x00, 0x01, 0x80,
+ 0x07, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x1f, 0x00, 0x01, 0x80, 0x3f, 0x00, 0x03, 0xbf,
+ 0x01, 0xb8, 0x01, 0xbf, 0x02, 0xb8, 0x01, 0x80, 0x01, 0xbe, 0x02, 0xb0, 0x01, 0x80, 0x01, 0xb0,
+ 0x02, 0x80, 0x01, 0x00, 0x01, 0xbd, 0x02, 0xb0, 0x01, 0x80, 0x01, 0xa0, 0x02, 0x80, 0x01, 0x00,
+ 0x01, 0xa0, 0x02, 0x80, 0x01, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0xbb, 0x02, 0xa0, 0x01, 0x80,
+ 0x01, 0xa0, 0x02, 0x80, 0x01, 0x00, 0x02, 0x80, 0x06, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x01, 0xb7,
+ 0x01, 0xa0, 0x03, 0x80, 0x03, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80,
+ 0x1f, 0x00, 0x01, 0xaf, 0x02, 0x80, 0x01, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x07, 0x00,
+ 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x1f, 0x00, 0x01, 0x80, 0x3f, 0x00, 0x01, 0x9f, 0x02, 0x80,
+ 0x01, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0xef, 0x00, 0x03, 0x7f,
+ 0x01, 0x78, 0x01, 0x7f, 0x02, 0x78, 0x01, 0x40, 0x01, 0x7e, 0x02, 0x70, 0x01, 0x00, 0x01, 0x70,
+ 0x03, 0x00, 0x01, 0x7d, 0x02, 0x70, 0x01, 0x00, 0x01, 0x60, 0x03, 0x00, 0x01, 0x60, 0x07, 0x00,
+ 0x01, 0x7b, 0x02, 0x60, 0x01, 0x00, 0x01, 0x60, 0x03, 0x00, 0x01, 0x40, 0x17, 0x00, 0x01, 0x77,
+ 0x01, 0x60, 0x01, 0x40, 0x3d, 0x00, 0x01, 0x6f, 0x01, 0x40, 0x7e, 0x00, 0x01, 0x5f, 0xff, 0x00,
+ 0x01, 0x3f, 0xff, 0x00, 0xff, 0x00, 0x01, 0x00
+};
+
+static const uint8_t SawRectRLE_6581[1784] = {
+ 0xff, 0x00, 0x01, 0x03, 0x7f, 0x00, 0x01, 0x01, 0x3f, 0x00, 0x01, 0x01, 0x3f, 0x00, 0x01, 0x1f,
+ 0x7f, 0x00, 0x01, 0x01, 0x7f, 0x00, 0x01, 0x2f, 0x7f, 0x00, 0x01, 0x37, 0x3f, 0x00, 0x01, 0x3b,
+ 0x1f, 0x00, 0x01, 0x3d, 0x0f, 0x00, 0x01, 0x3e, 0x07, 0x00, 0x01, 0x3f, 0x03, 0x00, 0x01, 0x3f,
+ 0x01, 0x00, 0x03, 0x3f, 0x7f, 0x00, 0x01, 0x01, 0x7f, 0x00, 0x01, 0x4f, 0x7f, 0x00, 0x01, 0x57,
+ 0x3f, 0x00, 0x01, 0x5b, 0x1f, 0x00, 0x01, 0x5d, 0x0f, 0x00, 0x01, 0x5e, 0x07, 0x00, 0x01, 0x5f,
+ 0x03, 0x00, 0x01, 0x5f, 0x01, 0x00, 0x03, 0x5f, 0x7f, 0x00, 0x01, 0x67, 0x3f, 0x00, 0x01, 0x6b,
+ 0x1f, 0x00, 0x01, 0x6d, 0x0f, 0x00, 0x01, 0x6e, 0x07, 0x00, 0x01, 0x6f, 0x02, 0x00, 0x01, 0x40,
+ 0x01, 0x6f, 0x01, 0x40, 0x03, 0x6f, 0x3f, 0x00, 0x01, 0x73, 0x1f, 0x00, 0x01, 0x75, 0x0f, 0x00,
+ 0x01, 0x76, 0x05, 0x00, 0x02, 0x40, 0x01, 0x77, 0x01, 0x00, 0x01, 0x40, 0x01, 0x60, 0x01, 0x77,
+ 0x01, 0x60, 0x03, 0x77, 0x0f, 0x00, 0x01, 0x40, 0x07, 0x00, 0x01, 0x40, 0x03, 0x00, 0x01, 0x40,
+ 0x01, 0x00, 0x02, 0x40, 0x01, 0x79, 0x07, 0x00, 0x01, 0x40, 0x03, 0x00, 0x01, 0x40, 0x01, 0x00,
+ 0x02, 0x60, 0x01, 0x7a, 0x03, 0x00, 0x01, 0x60, 0x01, 0x00, 0x02, 0x60, 0x01, 0x7b, 0x01, 0x00,
+ 0x02, 0x60, 0x01, 0x7b, 0x01, 0x70, 0x03, 0x7b, 0x07, 0x00, 0x01, 0x60, 0x03, 0x00, 0x01, 0x60,
+ 0x01, 0x00, 0x02, 0x60, 0x01, 0x7c, 0x03, 0x00, 0x01, 0x60, 0x01, 0x00, 0x02, 0x70, 0x01, 0x7d,
+ 0x01, 0x00, 0x02, 0x70, 0x01, 0x7d, 0x01, 0x78, 0x03, 0x7d, 0x03, 0x00, 0x01, 0x70, 0x01, 0x00,
+ 0x02, 0x70, 0x01, 0x7e, 0x01, 0x00, 0x02, 0x78, 0x01, 0x7e, 0x01, 0x78, 0x03, 0x7e, 0x01, 0x40,
+ 0x02, 0x78, 0x01, 0x7f, 0x01, 0x78, 0x03, 0x7f, 0x01, 0x78, 0x07, 0x7f, 0x3f, 0x00, 0x01, 0x80,
+ 0x1f, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80,
+ 0x01, 0x00, 0x02, 0x80, 0x01, 0x83, 0x1f, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00,
+ 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x02, 0x80, 0x01, 0x81, 0x0f, 0x00, 0x01, 0x80,
+ 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x07, 0x00, 0x01, 0x80,
+ 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x0a, 0x80,
+ 0x01, 0x8f, 0x1f, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00,
+ 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00,
+ 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00,
+ 0x03, 0x80, 0x03, 0x00, 0x0c, 0x80, 0x01, 0x97, 0x0f, 0x00, 0x01, 0x80, 0x06, 0x00, 0x02, 0x80,
+ 0x02, 0x00, 0x06, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x01, 0x00, 0x07, 0x80,
+ 0x01, 0x00, 0x0e, 0x80, 0x01, 0x9b, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x01, 0x00,
+ 0x07, 0x80, 0x01, 0x00, 0x0e, 0x80, 0x01, 0x9d, 0x0f, 0x80, 0x01, 0x9e, 0x05, 0x80, 0x01, 0x90,
+ 0x01, 0x98, 0x01, 0x9f, 0x01, 0x80, 0x02, 0x98, 0x01, 0x9f, 0x01, 0x98, 0x03, 0x9f, 0x1f, 0x00,
+ 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x05, 0x80, 0x0e, 0x00,
+ 0x02, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x01, 0x00, 0x07, 0x80, 0x03, 0x00,
+ 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x01, 0x00, 0x07, 0x80, 0x01, 0x00, 0x0e, 0x80, 0x01, 0xa7,
+ 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x03, 0x00, 0x01, 0x80,
+ 0x01, 0x00, 0x03, 0x80, 0x01, 0x00, 0x07, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80,
+ 0x01, 0x00, 0x07, 0x80, 0x01, 0x00, 0x0c, 0x80, 0x02, 0xa0, 0x01, 0xab, 0x03, 0x00, 0x01, 0x80,
+ 0x01, 0x00, 0x0a, 0x80, 0x01, 0xa0, 0x07, 0x80, 0x01, 0xa0, 0x03, 0x80, 0x01, 0xa0, 0x01, 0x80,
+ 0x02, 0xa0, 0x01, 0xad, 0x07, 0x80, 0x01, 0xa0, 0x03, 0x80, 0x01, 0xa0, 0x01, 0x80, 0x02, 0xa0,
+ 0x01, 0xae, 0x03, 0x80, 0x01, 0xa0, 0x01, 0x80, 0x02, 0xa0, 0x01, 0xaf, 0x01, 0x80, 0x01, 0xa0,
+ 0x01, 0xa8, 0x01, 0xaf, 0x01, 0xa8, 0x03, 0xaf, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80,
+ 0x01, 0x00, 0x03, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x0a, 0x80, 0x01, 0xa0, 0x02, 0x00,
+ 0x0d, 0x80, 0x01, 0xa0, 0x07, 0x80, 0x01, 0xa0, 0x03, 0x80, 0x01, 0xa0, 0x01, 0x80, 0x02, 0xa0,
+ 0x01, 0xb3, 0x01, 0x00, 0x0e, 0x80, 0x01, 0xa0, 0x07, 0x80, 0x01, 0xa0, 0x03, 0x80, 0x01, 0xa0,
+ 0x01, 0x80, 0x02, 0xa0, 0x01, 0xb5, 0x07, 0x80, 0x01, 0xa0, 0x03, 0x80, 0x01, 0xa0, 0x01, 0x80,
+ 0x01, 0xa0, 0x01, 0xb0, 0x01, 0xb6, 0x03, 0x80, 0x01, 0xb0, 0x01, 0x80, 0x02, 0xb0, 0x01, 0xb7,
+ 0x01, 0x80, 0x02, 0xb0, 0x01, 0xb7, 0x01, 0xb0, 0x03, 0xb7, 0x0f, 0x80, 0x01, 0xb0, 0x07, 0x80,
+ 0x01, 0xb0, 0x03, 0x80, 0x01, 0xb0, 0x01, 0x80, 0x02, 0xb0, 0x01, 0xb9, 0x07, 0x80, 0x01, 0xb0,
+ 0x03, 0x80, 0x01, 0xb0, 0x01, 0x80, 0x02, 0xb0, 0x01, 0xba, 0x03, 0x80, 0x01, 0xb0, 0x01, 0x80,
+ 0x01, 0xb0, 0x01, 0xb8, 0x01, 0xbb, 0x01, 0x80, 0x02, 0xb8, 0x01, 0xbb, 0x01, 0xb8, 0x03, 0xbb,
+ 0x07, 0x80, 0x01, 0xb8, 0x03, 0x80, 0x01, 0xb8, 0x01, 0x80, 0x02, 0xb8, 0x01, 0xbc, 0x03, 0x80,
+ 0x01, 0xb8, 0x01, 0x80, 0x02, 0xb8, 0x01, 0xbd, 0x01, 0xa0, 0x02, 0xb8, 0x01, 0xbd, 0x01, 0xb8,
+ 0x03, 0xbd, 0x01, 0x80, 0x02, 0xa0, 0x01, 0xb8, 0x01, 0xa0, 0x02, 0xb8, 0x01, 0xbe, 0x01, 0xa0,
+ 0x02, 0xb8, 0x01, 0xbe, 0x01, 0xbc, 0x03, 0xbe, 0x01, 0xb0, 0x02, 0xbc, 0x01, 0xbf, 0x01, 0xbc,
+ 0x03, 0xbf, 0x01, 0xbe, 0x07, 0xbf, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00,
+ 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00,
+ 0x03, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x01, 0x00, 0x06, 0x80, 0x01, 0xc0,
+ 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x03, 0x00, 0x01, 0x80,
+ 0x01, 0x00, 0x03, 0x80, 0x01, 0x00, 0x06, 0x80, 0x01, 0xc0, 0x02, 0x00, 0x0d, 0x80, 0x01, 0xc0,
+ 0x07, 0x80, 0x01, 0xc0, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xc7, 0x07, 0x00,
+ 0x01, 0x80, 0x03, 0x00, 0x05, 0x80, 0x01, 0x00, 0x0e, 0x80, 0x01, 0xc0, 0x01, 0x00, 0x0e, 0x80,
+ 0x01, 0xc0, 0x07, 0x80, 0x01, 0xc0, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xcb,
+ 0x01, 0x00, 0x0e, 0x80, 0x01, 0xc0, 0x07, 0x80, 0x01, 0xc0, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80,
+ 0x02, 0xc0, 0x01, 0xcd, 0x07, 0x80, 0x01, 0xc0, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0,
+ 0x01, 0xce, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xcf, 0x03, 0xc0, 0x01, 0xcf,
+ 0x01, 0xc8, 0x03, 0xcf, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x01, 0x00, 0x07, 0x80,
+ 0x01, 0x00, 0x0e, 0x80, 0x01, 0xc0, 0x0f, 0x80, 0x01, 0xc0, 0x07, 0x80, 0x01, 0xc0, 0x03, 0x80,
+ 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xd3, 0x0f, 0x80, 0x01, 0xc0, 0x07, 0x80, 0x01, 0xc0,
+ 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xd5, 0x07, 0x80, 0x01, 0xc0, 0x03, 0x80,
+ 0x04, 0xc0, 0x01, 0xd6, 0x01, 0x80, 0x04, 0xc0, 0x02, 0xd0, 0x01, 0xd7, 0x01, 0xc0, 0x02, 0xd0,
+ 0x01, 0xd7, 0x01, 0xd0, 0x03, 0xd7, 0x0f, 0x80, 0x01, 0xd0, 0x07, 0x80, 0x01, 0xd0, 0x01, 0x80,
+ 0x02, 0xc0, 0x01, 0xd0, 0x01, 0xc0, 0x02, 0xd0, 0x01, 0xd9, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80,
+ 0x02, 0xc0, 0x01, 0xd0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xd0, 0x01, 0xc0, 0x02, 0xd0, 0x01, 0xda,
+ 0x01, 0x80, 0x02, 0xc0, 0x01, 0xd0, 0x01, 0xc0, 0x02, 0xd0, 0x01, 0xdb, 0x01, 0xc0, 0x02, 0xd8,
+ 0x01, 0xdb, 0x01, 0xd8, 0x03, 0xdb, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xd8,
+ 0x01, 0x80, 0x02, 0xc0, 0x01, 0xd8, 0x01, 0xc0, 0x02, 0xd8, 0x01, 0xdc, 0x01, 0x80, 0x02, 0xc0,
+ 0x01, 0xd8, 0x01, 0xc0, 0x02, 0xd8, 0x01, 0xdd, 0x01, 0xc0, 0x02, 0xd8, 0x01, 0xdd, 0x01, 0xd8,
+ 0x03, 0xdd, 0x03, 0xc0, 0x01, 0xd8, 0x01, 0xc0, 0x02, 0xd8, 0x01, 0xde, 0x01, 0xc0, 0x02, 0xd8,
+ 0x01, 0xde, 0x01, 0xdc, 0x03, 0xde, 0x01, 0xd0, 0x02, 0xdc, 0x01, 0xdf, 0x01, 0xdc, 0x03, 0xdf,
+ 0x01, 0xdc, 0x07, 0xdf, 0x01, 0x00, 0x1e, 0x80, 0x01, 0xe0, 0x0f, 0x80, 0x01, 0xe0, 0x07, 0x80,
+ 0x01, 0xe0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xe3, 0x07, 0x80,
+ 0x01, 0xc0, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x03, 0x80, 0x01, 0xc0,
+ 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x02, 0xe0,
+ 0x01, 0xe5, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0x80, 0x02, 0xc0,
+ 0x01, 0xe0, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xe6, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0xc0,
+ 0x02, 0xe0, 0x01, 0xe7, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xe7, 0x01, 0xe0, 0x03, 0xe7, 0x07, 0x80,
+ 0x01, 0xc0, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x03, 0x80, 0x01, 0xc0,
+ 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x02, 0xe0,
+ 0x01, 0xe9, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0x80, 0x02, 0xc0,
+ 0x01, 0xe0, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xea, 0x02, 0xc0, 0x05, 0xe0, 0x01, 0xeb, 0x01, 0xe0,
+ 0x02, 0xe8, 0x01, 0xeb, 0x01, 0xe8, 0x03, 0xeb, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0xc0,
+ 0x02, 0xe0, 0x01, 0xe8, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xe8, 0x01, 0xe0, 0x02, 0xe8, 0x01, 0xec,
+ 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xe8, 0x01, 0xe0, 0x02, 0xe8, 0x01, 0xed, 0x01, 0xe0, 0x02, 0xe8,
+ 0x01, 0xed, 0x01, 0xe8, 0x03, 0xed, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xe8, 0x01, 0xe0, 0x02, 0xe8,
+ 0x01, 0xee, 0x01, 0xe0, 0x02, 0xe8, 0x01, 0xee, 0x01, 0xec, 0x03, 0xee, 0x01, 0xe0, 0x02, 0xec,
+ 0x01, 0xef, 0x01, 0xec, 0x03, 0xef, 0x01, 0xec, 0x07, 0xef, 0x07, 0x80, 0x01, 0xc0, 0x03, 0x80,
+ 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xf0, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x01, 0xc0,
+ 0x01, 0xe0, 0x01, 0xf0, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xf0, 0x01, 0xe0, 0x02, 0xf0, 0x01, 0xf1,
+ 0x01, 0x80, 0x02, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xf0, 0x01, 0xc0, 0x02, 0xe0,
+ 0x01, 0xf0, 0x01, 0xe0, 0x02, 0xf0, 0x01, 0xf2, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xf0, 0x01, 0xe0,
+ 0x02, 0xf0, 0x01, 0xf3, 0x01, 0xe0, 0x02, 0xf0, 0x01, 0xf3, 0x01, 0xf0, 0x03, 0xf3, 0x01, 0x80,
+ 0x02, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xf0, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xf0,
+ 0x01, 0xe0, 0x02, 0xf0, 0x01, 0xf4, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xf0, 0x01, 0xe0, 0x02, 0xf0,
+ 0x01, 0xf5, 0x01, 0xe0, 0x02, 0xf0, 0x01, 0xf5, 0x01, 0xf0, 0x03, 0xf5, 0x03, 0xe0, 0x04, 0xf0,
+ 0x01, 0xf6, 0x03, 0xf0, 0x01, 0xf6, 0x01, 0xf0, 0x03, 0xf6, 0x02, 0xf0, 0x01, 0xf4, 0x01, 0xf7,
+ 0x01, 0xf4, 0x03, 0xf7, 0x01, 0xf4, 0x07, 0xf7, 0x03, 0xc0, 0x04, 0xe0, 0x01, 0xf8, 0x03, 0xe0,
+ 0x01, 0xf8, 0x01, 0xf0, 0x03, 0xf8, 0x01, 0xe0, 0x02, 0xf0, 0x01, 0xf8, 0x01, 0xf0, 0x02, 0xf8,
+ 0x01, 0xf9, 0x01, 0xf0, 0x02, 0xf8, 0x01, 0xf9, 0x01, 0xf8, 0x03, 0xf9, 0x01, 0xe0, 0x02, 0xf0,
+ 0x01, 0xf8, 0x01, 0xf0, 0x02, 0xf8, 0x01, 0xfa, 0x01, 0xf0, 0x02, 0xf8, 0x01, 0xfa, 0x01, 0xf8,
+ 0x03, 0xfa, 0x01, 0xf0, 0x02, 0xf8, 0x01, 0xfb, 0x01, 0xf8, 0x03, 0xfb, 0x01, 0xf8, 0x07, 0xfb,
+ 0x01, 0xe0, 0x02, 0xf0, 0x01, 0xfc, 0x01, 0xf8, 0x03, 0xfc, 0x01, 0xf8, 0x07, 0xfc, 0x01, 0xf8,
+ 0x02, 0xfc, 0x01, 0xfd, 0x01, 0xfc, 0x03, 0xfd, 0x01, 0xfc, 0x07, 0xfd, 0x01, 0xf8, 0x02, 0xfc,
+ 0x01, 0xfe, 0x01, 0xfc, 0x0c, 0xfe, 0x0f, 0xff
+};
+
+static const uint8_t TriSawRectRLE_6581[262] = {
+ 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x03, 0x00, 0x01, 0x1f, 0xff, 0x00, 0xff, 0x00,
+ 0xff, 0x00, 0xfa, 0x00, 0x01, 0x20, 0x03, 0x00, 0x01, 0x38, 0x01, 0x30, 0x01, 0x7c, 0x02, 0x7f,
+ 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x02, 0x00, 0x01, 0x3e, 0x01, 0x3f, 0xff, 0x00,
+ 0x01, 0x80, 0x7f, 0x00, 0x01, 0x80, 0x3f, 0x00, 0x01, 0x80, 0x1f, 0x00, 0x01, 0x80, 0x0f, 0x00,
+ 0x01, 0x80, 0x06, 0x00, 0x08, 0x80, 0x01, 0x8c, 0x01, 0x9f, 0x3f, 0x00, 0x01, 0x80, 0x1f, 0x00,
+ 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x02, 0x00, 0x06, 0x80, 0x1f, 0x00,
+ 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x05, 0x80, 0x0e, 0x00,
+ 0x02, 0x80, 0x06, 0x00, 0x02, 0x80, 0x01, 0x00, 0x07, 0x80, 0x02, 0x00, 0x19, 0x80, 0x04, 0xc0,
+ 0x01, 0xcf, 0x0e, 0x00, 0x02, 0x80, 0x06, 0x00, 0x02, 0x80, 0x01, 0x00, 0x07, 0x80, 0x06, 0x00,
+ 0x02, 0x80, 0x01, 0x00, 0x15, 0x80, 0x02, 0xc0, 0x03, 0x00, 0x1b, 0x80, 0x02, 0xc0, 0x0e, 0x80,
+ 0x02, 0xc0, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x08, 0xc0, 0x02, 0xe0, 0x01, 0xe7, 0x0e, 0x80,
+ 0x02, 0xc0, 0x07, 0x80, 0x01, 0xc0, 0x02, 0x80, 0x04, 0xc0, 0x02, 0xe0, 0x06, 0x80, 0x02, 0xc0,
+ 0x02, 0x80, 0x05, 0xc0, 0x01, 0xe0, 0x06, 0xc0, 0x02, 0xe0, 0x01, 0xc0, 0x05, 0xe0, 0x01, 0xf0,
+ 0x01, 0xf3, 0x06, 0xc0, 0x02, 0xe0, 0x03, 0xc0, 0x04, 0xe0, 0x01, 0xf0, 0x02, 0xc0, 0x05, 0xe0,
+ 0x01, 0xf0, 0x02, 0xe0, 0x04, 0xf0, 0x01, 0xf8, 0x01, 0xf9, 0x03, 0xe0, 0x04, 0xf0, 0x01, 0xf8,
+ 0x03, 0xf0, 0x04, 0xf8, 0x01, 0xfc, 0x03, 0xf8, 0x01, 0xfc, 0x01, 0xf8, 0x02, 0xfc, 0x01, 0xfe,
+ 0x01, 0xfc, 0x02, 0xfe, 0x05, 0xff
+};
+
+static const uint8_t TriSawRLE_8580[194] = {
+ 0x7e, 0x00, 0x02, 0x03, 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03, 0x78, 0x00, 0x04, 0x0e,
+ 0x04, 0x0f, 0x7e, 0x00, 0x02, 0x03, 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03, 0x3f, 0x00,
+ 0x01, 0x01, 0x30, 0x00, 0x08, 0x1c, 0x04, 0x1e, 0x04, 0x1f, 0x7e, 0x00, 0x02, 0x03, 0x7c, 0x00,
+ 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03, 0x78, 0x00, 0x04, 0x0e, 0x04, 0x0f, 0x7e, 0x00, 0x02, 0x03,
+ 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03, 0x3f, 0x00, 0x01, 0x01, 0x20, 0x00, 0x10, 0x38,
+ 0x08, 0x3c, 0x08, 0x3f, 0x7e, 0x00, 0x02, 0x03, 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03,
+ 0x3f, 0x00, 0x01, 0x01, 0x38, 0x00, 0x04, 0x0e, 0x04, 0x0f, 0x7e, 0x00, 0x02, 0x03, 0x7c, 0x00,
+ 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03, 0x3f, 0x00, 0x01, 0x01, 0x30, 0x00, 0x08, 0x1c, 0x04, 0x1e,
+ 0x04, 0x3f, 0x7e, 0x00, 0x02, 0x03, 0x7c, 0x00, 0x04, 0x07, 0x7e, 0x00, 0x02, 0x03, 0x3f, 0x00,
+ 0x01, 0x01, 0x38, 0x00, 0x04, 0x0e, 0x02, 0x0f, 0x02, 0x1f, 0x7e, 0x80, 0x02, 0x83, 0x7c, 0x80,
+ 0x02, 0x87, 0x02, 0x8f, 0x30, 0xc0, 0x02, 0xe0, 0x01, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x01, 0xe0,
+ 0x01, 0xc0, 0x47, 0xe0, 0x02, 0xe3, 0x3f, 0xf0, 0x01, 0xf1, 0x20, 0xf8, 0x10, 0xfc, 0x08, 0xfe,
+ 0x08, 0xff
+};
+
+static const uint8_t TriRectRLE_8580[888] = {
+ 0xff, 0x00, 0xfe, 0x00, 0x01, 0x10, 0x01, 0x3c, 0x01, 0x3f, 0xfe, 0x00, 0x01, 0x40, 0x01, 0x5f,
+ 0x7b, 0x00, 0x01, 0x40, 0x01, 0x00, 0x01, 0x40, 0x01, 0x60, 0x01, 0x6f, 0x2f, 0x00, 0x01, 0x40,
+ 0x07, 0x00, 0x01, 0x40, 0x02, 0x00, 0x01, 0x40, 0x01, 0x60, 0x01, 0x40, 0x01, 0x60, 0x01, 0x70,
+ 0x01, 0x77, 0x0e, 0x00, 0x01, 0x40, 0x01, 0x60, 0x03, 0x00, 0x01, 0x40, 0x01, 0x00, 0x02, 0x40,
+ 0x01, 0x60, 0x02, 0x40, 0x01, 0x60, 0x01, 0x70, 0x01, 0x60, 0x02, 0x70, 0x01, 0x7b, 0x03, 0x40,
+ 0x01, 0x60, 0x01, 0x40, 0x02, 0x60, 0x01, 0x70, 0x02, 0x60, 0x03, 0x70, 0x02, 0x78, 0x01, 0x7c,
+ 0x03, 0x70, 0x03, 0x78, 0x01, 0x7c, 0x01, 0x7e, 0x01, 0x78, 0x02, 0x7c, 0x01, 0x7f, 0x01, 0x7e,
+ 0x03, 0x7f, 0xbf, 0x00, 0x01, 0x80, 0x1f, 0x00, 0x01, 0x80, 0x0d, 0x00, 0x03, 0x80, 0x03, 0x00,
+ 0x01, 0x80, 0x01, 0x00, 0x0a, 0x80, 0x01, 0x9f, 0x3d, 0x00, 0x03, 0x80, 0x1b, 0x00, 0x05, 0x80,
+ 0x07, 0x00, 0x01, 0x80, 0x01, 0x00, 0x16, 0x80, 0x01, 0xaf, 0x0b, 0x00, 0x01, 0x80, 0x01, 0x00,
+ 0x03, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x28, 0x80, 0x02, 0xa0, 0x01, 0xb7, 0x17, 0x80,
+ 0x01, 0xa0, 0x03, 0x80, 0x02, 0xa0, 0x02, 0xb0, 0x01, 0xbb, 0x05, 0x80, 0x02, 0xa0, 0x01, 0xb0,
+ 0x01, 0x80, 0x02, 0xa0, 0x03, 0xb0, 0x01, 0xb8, 0x01, 0xbc, 0x01, 0xa0, 0x02, 0xb0, 0x01, 0xb8,
+ 0x01, 0xb0, 0x02, 0xb8, 0x01, 0xbe, 0x01, 0xb8, 0x02, 0xbc, 0x01, 0xbf, 0x01, 0xbe, 0x03, 0xbf,
+ 0x1b, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x05, 0x80,
+ 0x01, 0x00, 0x0e, 0x80, 0x01, 0xc0, 0x02, 0x00, 0x1d, 0x80, 0x01, 0xc0, 0x0f, 0x80, 0x01, 0xc0,
+ 0x05, 0x80, 0x03, 0xc0, 0x01, 0x80, 0x06, 0xc0, 0x01, 0xcf, 0x1d, 0x80, 0x03, 0xc0, 0x07, 0x80,
+ 0x01, 0xc0, 0x03, 0x80, 0x05, 0xc0, 0x01, 0x80, 0x0e, 0xc0, 0x01, 0xd7, 0x03, 0x80, 0x1b, 0xc0,
+ 0x01, 0xd0, 0x01, 0xd8, 0x0b, 0xc0, 0x01, 0xd0, 0x01, 0xc0, 0x02, 0xd0, 0x01, 0xdc, 0x01, 0xc0,
+ 0x04, 0xd0, 0x02, 0xd8, 0x01, 0xde, 0x01, 0xd8, 0x02, 0xdc, 0x01, 0xdf, 0x01, 0xde, 0x03, 0xdf,
+ 0x07, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x16, 0xc0, 0x01, 0xe0, 0x0f, 0xc0, 0x01, 0xe0, 0x06, 0xc0,
+ 0x02, 0xe0, 0x01, 0xc0, 0x06, 0xe0, 0x01, 0xe7, 0x0b, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x03, 0xe0,
+ 0x02, 0xc0, 0x0d, 0xe0, 0x01, 0xe8, 0x0f, 0xe0, 0x01, 0xec, 0x05, 0xe0, 0x02, 0xe8, 0x01, 0xec,
+ 0x01, 0xe0, 0x01, 0xe8, 0x01, 0xec, 0x01, 0xee, 0x01, 0xec, 0x03, 0xef, 0x0f, 0xe0, 0x01, 0xf0,
+ 0x07, 0xe0, 0x01, 0xf0, 0x02, 0xe0, 0x06, 0xf0, 0x03, 0xe0, 0x01, 0xf0, 0x01, 0xe0, 0x0a, 0xf0,
+ 0x01, 0xf4, 0x07, 0xf0, 0x01, 0xf4, 0x02, 0xf0, 0x01, 0xf4, 0x01, 0xf6, 0x01, 0xf4, 0x03, 0xf7,
+ 0x07, 0xf0, 0x01, 0xf8, 0x03, 0xf0, 0x05, 0xf8, 0x01, 0xf0, 0x0a, 0xf8, 0x01, 0xfa, 0x01, 0xf8,
+ 0x03, 0xfb, 0x05, 0xf8, 0x09, 0xfc, 0x02, 0xfd, 0x02, 0xfc, 0x07, 0xfe, 0x0e, 0xff, 0x07, 0xfe,
+ 0x02, 0xfc, 0x02, 0xfd, 0x09, 0xfc, 0x05, 0xf8, 0x03, 0xfb, 0x01, 0xf8, 0x01, 0xfa, 0x0a, 0xf8,
+ 0x01, 0xf0, 0x05, 0xf8, 0x03, 0xf0, 0x01, 0xf8, 0x07, 0xf0, 0x03, 0xf7, 0x01, 0xf4, 0x01, 0xf6,
+ 0x01, 0xf4, 0x02, 0xf0, 0x01, 0xf4, 0x07, 0xf0, 0x01, 0xf4, 0x0a, 0xf0, 0x01, 0xe0, 0x01, 0xf0,
+ 0x03, 0xe0, 0x07, 0xf0, 0x01, 0xe0, 0x01, 0xf0, 0x07, 0xe0, 0x01, 0xf0, 0x0f, 0xe0, 0x03, 0xef,
+ 0x01, 0xec, 0x01, 0xee, 0x01, 0xec, 0x02, 0xe8, 0x01, 0xee, 0x02, 0xe8, 0x05, 0xe0, 0x01, 0xec,
+ 0x0f, 0xe0, 0x01, 0xe8, 0x0d, 0xe0, 0x02, 0xc0, 0x03, 0xe0, 0x01, 0xc0, 0x01, 0xe0, 0x0b, 0xc0,
+ 0x01, 0xe7, 0x06, 0xe0, 0x01, 0xc0, 0x02, 0xe0, 0x06, 0xc0, 0x01, 0xe0, 0x0f, 0xc0, 0x01, 0xe0,
+ 0x16, 0xc0, 0x01, 0x80, 0x01, 0xc0, 0x07, 0x80, 0x03, 0xdf, 0x01, 0xde, 0x01, 0xdf, 0x02, 0xdc,
+ 0x01, 0xd8, 0x01, 0xde, 0x02, 0xd8, 0x04, 0xd0, 0x01, 0xc0, 0x01, 0xdc, 0x02, 0xd0, 0x01, 0xc0,
+ 0x01, 0xd0, 0x03, 0xc0, 0x01, 0xd0, 0x07, 0xc0, 0x01, 0xd8, 0x01, 0xd0, 0x1b, 0xc0, 0x03, 0x80,
+ 0x01, 0xd7, 0x0e, 0xc0, 0x01, 0x80, 0x05, 0xc0, 0x03, 0x80, 0x01, 0xc0, 0x07, 0x80, 0x03, 0xc0,
+ 0x1d, 0x80, 0x01, 0xcf, 0x06, 0xc0, 0x01, 0x80, 0x03, 0xc0, 0x05, 0x80, 0x01, 0xc0, 0x0f, 0x80,
+ 0x01, 0xc0, 0x1a, 0x80, 0x01, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0xc0, 0x0e, 0x80, 0x01, 0x00,
+ 0x06, 0x80, 0x02, 0x00, 0x01, 0x80, 0x07, 0x00, 0x03, 0x80, 0x1d, 0x00, 0x03, 0xbf, 0x01, 0xbe,
+ 0x01, 0xbf, 0x02, 0xbc, 0x01, 0xb8, 0x01, 0xbe, 0x02, 0xb8, 0x01, 0xb0, 0x01, 0xb8, 0x02, 0xb0,
+ 0x01, 0xa0, 0x01, 0xbc, 0x01, 0xb8, 0x03, 0xb0, 0x02, 0xa0, 0x01, 0x80, 0x01, 0xb0, 0x02, 0xa0,
+ 0x05, 0x80, 0x01, 0xbb, 0x02, 0xb0, 0x02, 0xa0, 0x03, 0x80, 0x01, 0xa0, 0x17, 0x80, 0x01, 0xb7,
+ 0x02, 0xa0, 0x2a, 0x80, 0x03, 0x00, 0x03, 0x80, 0x0d, 0x00, 0x01, 0xaf, 0x16, 0x80, 0x01, 0x00,
+ 0x01, 0x80, 0x07, 0x00, 0x03, 0x80, 0x01, 0x00, 0x01, 0x80, 0x1b, 0x00, 0x03, 0x80, 0x3d, 0x00,
+ 0x01, 0x9f, 0x0a, 0x80, 0x01, 0x00, 0x01, 0x80, 0x03, 0x00, 0x03, 0x80, 0x0d, 0x00, 0x01, 0x80,
+ 0x1f, 0x00, 0x01, 0x80, 0xbf, 0x00, 0x03, 0x7f, 0x01, 0x7e, 0x01, 0x7f, 0x02, 0x7c, 0x01, 0x78,
+ 0x01, 0x7e, 0x01, 0x7c, 0x03, 0x78, 0x03, 0x70, 0x01, 0x7c, 0x02, 0x78, 0x03, 0x70, 0x02, 0x60,
+ 0x01, 0x70, 0x02, 0x60, 0x01, 0x40, 0x01, 0x60, 0x03, 0x40, 0x01, 0x7b, 0x02, 0x70, 0x01, 0x60,
+ 0x01, 0x70, 0x02, 0x60, 0x01, 0x40, 0x01, 0x60, 0x02, 0x40, 0x01, 0x00, 0x01, 0x40, 0x03, 0x00,
+ 0x01, 0x60, 0x02, 0x40, 0x0d, 0x00, 0x01, 0x77, 0x01, 0x70, 0x01, 0x60, 0x01, 0x40, 0x01, 0x60,
+ 0x01, 0x40, 0x02, 0x00, 0x01, 0x40, 0x07, 0x00, 0x01, 0x40, 0x2f, 0x00, 0x01, 0x6f, 0x01, 0x60,
+ 0x01, 0x40, 0x01, 0x00, 0x01, 0x40, 0x7b, 0x00, 0x01, 0x5f, 0x01, 0x40, 0xfe, 0x00, 0x01, 0x3f,
+ 0x01, 0x3c, 0x01, 0x18, 0xff, 0x00, 0xfe, 0x00
+};
+
+static const uint8_t SawRectRLE_8580[1122] = {
+ 0x7f, 0x00, 0x01, 0x01, 0x7f, 0x00, 0x01, 0x07, 0x7f, 0x00, 0x01, 0x03, 0x3f, 0x00, 0x01, 0x03,
+ 0x1f, 0x00, 0x01, 0x01, 0x1e, 0x00, 0x01, 0x01, 0x01, 0x1f, 0x7f, 0x00, 0x01, 0x03, 0x3f, 0x00,
+ 0x01, 0x01, 0x3f, 0x00, 0x01, 0x2f, 0x3f, 0x00, 0x01, 0x01, 0x3f, 0x00, 0x01, 0x37, 0x3f, 0x00,
+ 0x01, 0x3b, 0x1f, 0x00, 0x01, 0x3d, 0x0f, 0x00, 0x01, 0x3e, 0x07, 0x00, 0x01, 0x3f, 0x03, 0x00,
+ 0x01, 0x3f, 0x01, 0x1c, 0x03, 0x3f, 0x7f, 0x00, 0x01, 0x03, 0x3f, 0x00, 0x01, 0x01, 0x3f, 0x00,
+ 0x01, 0x0f, 0x3f, 0x00, 0x01, 0x01, 0x3f, 0x00, 0x01, 0x07, 0x3f, 0x00, 0x01, 0x5b, 0x1f, 0x00,
+ 0x01, 0x5d, 0x0f, 0x00, 0x01, 0x5e, 0x07, 0x00, 0x01, 0x5f, 0x03, 0x00, 0x01, 0x5f, 0x01, 0x00,
+ 0x03, 0x5f, 0x7f, 0x00, 0x01, 0x67, 0x3f, 0x00, 0x01, 0x63, 0x1f, 0x00, 0x01, 0x6d, 0x0f, 0x00,
+ 0x01, 0x6e, 0x07, 0x00, 0x01, 0x6f, 0x03, 0x00, 0x01, 0x6f, 0x01, 0x40, 0x03, 0x6f, 0x3f, 0x00,
+ 0x01, 0x73, 0x1f, 0x00, 0x01, 0x71, 0x0f, 0x00, 0x01, 0x70, 0x03, 0x00, 0x01, 0x40, 0x01, 0x00,
+ 0x02, 0x40, 0x01, 0x72, 0x01, 0x00, 0x02, 0x40, 0x01, 0x77, 0x01, 0x60, 0x03, 0x77, 0x0f, 0x00,
+ 0x01, 0x40, 0x07, 0x00, 0x01, 0x40, 0x03, 0x00, 0x01, 0x40, 0x01, 0x00, 0x02, 0x40, 0x01, 0x79,
+ 0x07, 0x00, 0x01, 0x40, 0x03, 0x00, 0x03, 0x40, 0x01, 0x60, 0x01, 0x78, 0x01, 0x00, 0x02, 0x40,
+ 0x01, 0x60, 0x01, 0x40, 0x02, 0x60, 0x01, 0x78, 0x01, 0x40, 0x02, 0x60, 0x01, 0x78, 0x01, 0x70,
+ 0x03, 0x7b, 0x03, 0x00, 0x01, 0x40, 0x01, 0x00, 0x02, 0x40, 0x01, 0x60, 0x03, 0x40, 0x03, 0x60,
+ 0x01, 0x70, 0x01, 0x7c, 0x01, 0x40, 0x02, 0x60, 0x01, 0x70, 0x01, 0x60, 0x02, 0x70, 0x01, 0x7c,
+ 0x03, 0x70, 0x01, 0x7c, 0x01, 0x78, 0x02, 0x7c, 0x01, 0x7d, 0x01, 0x60, 0x04, 0x70, 0x02, 0x78,
+ 0x01, 0x7e, 0x01, 0x70, 0x02, 0x78, 0x01, 0x7e, 0x01, 0x78, 0x03, 0x7e, 0x01, 0x78, 0x02, 0x7c,
+ 0x01, 0x7e, 0x01, 0x7c, 0x03, 0x7f, 0x01, 0x7e, 0x07, 0x7f, 0x7f, 0x00, 0x01, 0x03, 0x3f, 0x00,
+ 0x01, 0x01, 0x3f, 0x00, 0x01, 0x8f, 0x7f, 0x00, 0x01, 0x87, 0x3f, 0x00, 0x01, 0x9b, 0x1f, 0x00,
+ 0x01, 0x9d, 0x0d, 0x00, 0x02, 0x80, 0x01, 0x9e, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x02, 0x80,
+ 0x01, 0x9f, 0x01, 0x00, 0x02, 0x80, 0x01, 0x9f, 0x01, 0x80, 0x03, 0x9f, 0x7f, 0x00, 0x01, 0x87,
+ 0x3d, 0x00, 0x02, 0x80, 0x01, 0x83, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00,
+ 0x01, 0x80, 0x01, 0x00, 0x02, 0x80, 0x01, 0x85, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00, 0x04, 0x80,
+ 0x01, 0xae, 0x01, 0x00, 0x06, 0x80, 0x01, 0xaf, 0x03, 0x80, 0x01, 0xaf, 0x01, 0x80, 0x03, 0xaf,
+ 0x1f, 0x00, 0x01, 0x80, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00, 0x01, 0x80, 0x02, 0x00, 0x05, 0x80,
+ 0x01, 0xb3, 0x0f, 0x00, 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x01, 0x00,
+ 0x06, 0x80, 0x01, 0xb1, 0x03, 0x00, 0x0c, 0x80, 0x01, 0xb0, 0x07, 0x80, 0x01, 0xb2, 0x03, 0x80,
+ 0x01, 0xb7, 0x01, 0x80, 0x03, 0xb7, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x1a, 0x80, 0x01, 0xb1,
+ 0x0f, 0x80, 0x01, 0xb8, 0x07, 0x80, 0x01, 0xb8, 0x01, 0x80, 0x02, 0xa0, 0x01, 0xb8, 0x01, 0xa0,
+ 0x01, 0xb8, 0x02, 0xbb, 0x07, 0x80, 0x01, 0xa0, 0x03, 0x80, 0x01, 0xa0, 0x01, 0x80, 0x02, 0xa0,
+ 0x01, 0xb8, 0x03, 0x80, 0x01, 0xa0, 0x01, 0x80, 0x01, 0xa0, 0x01, 0xb0, 0x01, 0xbc, 0x01, 0xa0,
+ 0x02, 0xb0, 0x01, 0xbc, 0x01, 0xb0, 0x02, 0xbc, 0x01, 0xbd, 0x01, 0x80, 0x02, 0xa0, 0x01, 0xb0,
+ 0x01, 0xa0, 0x02, 0xb0, 0x01, 0xbc, 0x01, 0xb0, 0x02, 0xb8, 0x01, 0xbc, 0x01, 0xb8, 0x03, 0xbe,
+ 0x01, 0xb0, 0x02, 0xb8, 0x01, 0xbe, 0x01, 0xbc, 0x01, 0xbe, 0x02, 0xbf, 0x01, 0xbe, 0x07, 0xbf,
+ 0x3f, 0x00, 0x01, 0x80, 0x1f, 0x00, 0x01, 0x80, 0x0b, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80,
+ 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x0a, 0x80, 0x01, 0xc7, 0x0f, 0x00, 0x01, 0x80, 0x07, 0x00,
+ 0x01, 0x80, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x03, 0x80, 0x07, 0x00, 0x01, 0x80, 0x03, 0x00,
+ 0x05, 0x80, 0x01, 0x00, 0x0e, 0x80, 0x01, 0xc3, 0x03, 0x00, 0x01, 0x80, 0x01, 0x00, 0x19, 0x80,
+ 0x01, 0xc0, 0x01, 0xc1, 0x07, 0x80, 0x01, 0xc0, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0,
+ 0x01, 0xc6, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xcf, 0x03, 0xc0, 0x01, 0xcf,
+ 0x01, 0xc0, 0x03, 0xcf, 0x07, 0x00, 0x01, 0x80, 0x02, 0x00, 0x02, 0x80, 0x01, 0x00, 0x03, 0x80,
+ 0x01, 0x00, 0x0e, 0x80, 0x01, 0xc0, 0x0f, 0x80, 0x01, 0xc0, 0x07, 0x80, 0x01, 0xc0, 0x03, 0x80,
+ 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xc3, 0x0f, 0x80, 0x01, 0xc0, 0x07, 0x80, 0x01, 0xc0,
+ 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x02, 0xc0, 0x01, 0xc1, 0x07, 0x80, 0x01, 0xc0, 0x01, 0x80,
+ 0x0e, 0xc0, 0x01, 0xd0, 0x03, 0xc0, 0x01, 0xd3, 0x01, 0xc0, 0x03, 0xd7, 0x07, 0x80, 0x01, 0xc0,
+ 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x03, 0xc0, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x0a, 0xc0,
+ 0x01, 0xd1, 0x01, 0x80, 0x0e, 0xc0, 0x01, 0xd0, 0x07, 0xc0, 0x01, 0xd0, 0x03, 0xc0, 0x01, 0xd8,
+ 0x01, 0xc0, 0x01, 0xd8, 0x02, 0xdb, 0x0f, 0xc0, 0x01, 0xd8, 0x07, 0xc0, 0x01, 0xd8, 0x02, 0xc0,
+ 0x01, 0xd0, 0x01, 0xd8, 0x01, 0xd0, 0x02, 0xdc, 0x01, 0xdd, 0x03, 0xc0, 0x01, 0xd0, 0x01, 0xc0,
+ 0x02, 0xd0, 0x01, 0xdc, 0x01, 0xc0, 0x02, 0xd0, 0x01, 0xdc, 0x01, 0xd8, 0x01, 0xdc, 0x02, 0xde,
+ 0x01, 0xd0, 0x02, 0xd8, 0x01, 0xde, 0x01, 0xd8, 0x02, 0xde, 0x01, 0xdf, 0x01, 0xdc, 0x07, 0xdf,
+ 0x0f, 0x80, 0x01, 0xc0, 0x07, 0x80, 0x01, 0xc0, 0x03, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x03, 0xc0,
+ 0x07, 0x80, 0x01, 0xc0, 0x01, 0x80, 0x07, 0xc0, 0x01, 0x80, 0x0e, 0xc0, 0x01, 0xe3, 0x02, 0x80,
+ 0x1d, 0xc0, 0x01, 0xe1, 0x0b, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x03, 0xe0, 0x03, 0xc0, 0x01, 0xe0,
+ 0x01, 0xc0, 0x08, 0xe0, 0x01, 0xe3, 0x02, 0xe7, 0x0f, 0xc0, 0x01, 0xe0, 0x07, 0xc0, 0x01, 0xe0,
+ 0x03, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x02, 0xe0, 0x01, 0xe1, 0x07, 0xc0, 0x01, 0xe0, 0x03, 0xc0,
+ 0x05, 0xe0, 0x01, 0xc0, 0x0c, 0xe0, 0x02, 0xe8, 0x01, 0xeb, 0x01, 0xc0, 0x01, 0xe0, 0x01, 0xc0,
+ 0x0c, 0xe0, 0x01, 0xe8, 0x07, 0xe0, 0x01, 0xe8, 0x03, 0xe0, 0x01, 0xe8, 0x01, 0xe0, 0x01, 0xe8,
+ 0x01, 0xec, 0x01, 0xed, 0x07, 0xe0, 0x01, 0xec, 0x03, 0xe0, 0x01, 0xec, 0x01, 0xe0, 0x01, 0xec,
+ 0x02, 0xee, 0x01, 0xe0, 0x02, 0xe8, 0x01, 0xee, 0x01, 0xe8, 0x02, 0xee, 0x01, 0xef, 0x01, 0xec,
+ 0x07, 0xef, 0x03, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x03, 0xe0, 0x01, 0xc0, 0x16, 0xe0, 0x01, 0xf0,
+ 0x0e, 0xe0, 0x02, 0xf0, 0x03, 0xe0, 0x01, 0xf0, 0x01, 0xe0, 0x03, 0xf0, 0x01, 0xe0, 0x06, 0xf0,
+ 0x01, 0xf3, 0x07, 0xe0, 0x01, 0xf0, 0x03, 0xe0, 0x01, 0xf0, 0x01, 0xe0, 0x03, 0xf0, 0x01, 0xe0,
+ 0x0e, 0xf0, 0x01, 0xf5, 0x07, 0xf0, 0x01, 0xf4, 0x03, 0xf0, 0x01, 0xf4, 0x01, 0xf0, 0x02, 0xf4,
+ 0x01, 0xf6, 0x03, 0xf0, 0x01, 0xf6, 0x01, 0xf0, 0x02, 0xf6, 0x01, 0xf7, 0x01, 0xf4, 0x01, 0xf6,
+ 0x06, 0xf7, 0x0f, 0xf0, 0x01, 0xf8, 0x06, 0xf0, 0x02, 0xf8, 0x01, 0xf0, 0x06, 0xf8, 0x01, 0xf9,
+ 0x03, 0xf0, 0x01, 0xf8, 0x01, 0xf0, 0x0a, 0xf8, 0x01, 0xfa, 0x06, 0xf8, 0x01, 0xfa, 0x01, 0xfb,
+ 0x01, 0xf8, 0x01, 0xfa, 0x06, 0xfb, 0x07, 0xf8, 0x01, 0xfc, 0x03, 0xf8, 0x05, 0xfc, 0x01, 0xf8,
+ 0x06, 0xfc, 0x01, 0xfd, 0x03, 0xfc, 0x05, 0xfd, 0x03, 0xfc, 0x01, 0xfe, 0x01, 0xfc, 0x0c, 0xfe,
+ 0x0f, 0xff
+};
+
+static const uint8_t TriSawRectRLE_8580[152] = {
+ 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x03, 0x00, 0x01, 0x1f, 0xff, 0x00, 0xff, 0x00,
+ 0xff, 0x00, 0xf2, 0x00, 0x01, 0x20, 0x06, 0x00, 0x01, 0x30, 0x01, 0x70, 0x01, 0x30, 0x01, 0x70,
+ 0x01, 0x78, 0x02, 0x7c, 0x01, 0x7e, 0x02, 0x7f, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+ 0x01, 0x00, 0x01, 0x18, 0x01, 0x3e, 0x01, 0x3f, 0xff, 0x00, 0xf8, 0x00, 0x01, 0x80, 0x01, 0x00,
+ 0x05, 0x80, 0x01, 0x8c, 0x01, 0x9f, 0x7b, 0x00, 0x05, 0x80, 0x37, 0x00, 0x01, 0x80, 0x02, 0x00,
+ 0x06, 0x80, 0x07, 0x00, 0x01, 0x80, 0x04, 0x00, 0x04, 0x80, 0x02, 0x00, 0x25, 0x80, 0x08, 0xc0,
+ 0x01, 0xcf, 0x1f, 0x80, 0x01, 0xc0, 0x0f, 0x80, 0x01, 0xc0, 0x06, 0x80, 0x0a, 0xc0, 0x0c, 0x80,
+ 0x04, 0xc0, 0x01, 0x80, 0x26, 0xc0, 0x01, 0xe0, 0x01, 0xc0, 0x06, 0xe0, 0x01, 0xe7, 0x0e, 0xc0,
+ 0x02, 0xe0, 0x03, 0xc0, 0x01, 0xe0, 0x02, 0xc0, 0x25, 0xe0, 0x05, 0xf0, 0x03, 0xe0, 0x19, 0xf0,
+ 0x12, 0xf8, 0x08, 0xfc, 0x05, 0xfe, 0x05, 0xff
+};
+
+#endif
@@ -285,40 +285,39 @@ uint8_t *fb =;
 }
 #endif
 
-extern uint8_t g_pixels[384 * 272];
-// Source: VIC buffer (384x272, 8-bit indexed color)
-// Dest: HDMI framebuffer (320x240, 8-bit indexed color)
+// Line y of the visible 320x240 screen (Display_rp2350.cpp)
+extern uint8_t *display_get_screen_line(int y);
+
+// Set a pixel of the visible screen, clipped
+static void put_pixel(int x, int y, uint8_t color) {
+    if (x >= 0 && x < SCREEN_WIDTH && y >= 0 && y < SCREEN_HEIGHT) {
+        display_get_screen_line(y)[x] = color;
+    }
+}
 
 // Draw a character with drop shadow
 static void draw_char_shadow(int x, int y, char c, uint8_t color) {
     int idx = (unsigned char)c - 32;
     if (idx < 0 || idx > 94) return;
-    uint8_t *fb = g_pixels;
-    x += C64_CROP_LEFT;
-    y += C64_CROP_TOP;
 
     const uint8_t *glyph = font_6x8[idx];
 
     // Draw shadow first (offset by 1,1)
     for (int row = 0; row < 8; row++) {
-        if (y + row + 1 < 0 || y + row + 1 >= C64_DISPLAY_HEIGHT) continue;
         uint8_t bits = glyph[row];
         for (int col = 0; col < 6; col++) {
-            if (x + col + 1 < 0 || x + col + 1 >= C64_DISPLAY_WIDTH) continue;
             if (bits & (0x80 >> col)) {
-                fb[(y + row + 1) * C64_DISPLAY_WIDTH + (x + col + 1)] = COLOR_TEXT_SHADOW;
+                put_pixel(x + col + 1, y + row + 1, COLOR_TEXT_SHADOW);
             }
         }
     }
 
     // Draw main character
     for (int row = 0; row < 8; row++) {
-        if (y + row < 0 || y + row >= C64_DISPLAY_HEIGHT) continue;
         uint8_t bits = glyph[row];
         for (int col = 0; col < 6; col++) {
-            if (x + col < 0 || x + col >= C64_DISPLAY_WIDTH) continue;
             if (bits & (0x80 >> col)) {
-                fb[(y + row) * C64_DISPLAY_WIDTH + (x + col)] = color;
+                put_pixel(x + col, y + row, color);
             }
         }
     }
@@ -347,20 +346,17 @@ static void draw_centered_shadow(int y, const char *str, uint8_t color) {
 
 // Draw a semi-transparent box (darkens background)
 static void draw_dark_box(int x, int y, int w, int h) {
-    uint8_t *fb = g_pixels;
-    x += C64_CROP_LEFT;
-    y += C64_CROP_TOP;
     for (int dy = 0; dy < h; dy++) {
-        if (y + dy < 0 || y + dy >= C64_DISPLAY_HEIGHT) continue;
+        if (y + dy < 0 || y + dy >= SCREEN_HEIGHT) continue;
+        uint8_t *line = display_get_screen_line(y + dy);
         for (int dx = 0; dx < w; dx++) {
-            if (x + dx < 0 || x + dx >= C64_DISPLAY_WIDTH) continue;
-            int idx = (y + dy) * C64_DISPLAY_WIDTH + (x + dx);
+            if (x + dx < 0 || x + dx >= SCREEN_WIDTH) continue;
             // Darken by reducing to lower palette entries
-            uint8_t current = fb[idx];
+            uint8_t current = line[x + dx];
             if (current >= PALETTE_PLASMA_START) {
                 // Shift toward darker end of plasma palette
                 int new_val = PALETTE_PLASMA_START + (current - PALETTE_PLASMA_START) / 3;
-                fb[idx] = new_val;
+                line[x + dx] = new_val;
             }
         }
     }
@@ -368,21 +364,14 @@ static void draw_dark_box(int x, int y, int w, int h) {
 
 // Draw a glowing border around a box
 static void draw_glow_border(int x, int y, int w, int h, uint8_t base_color) {
-    uint8_t *fb = g_pixels;
-    x += C64_CROP_LEFT;
-    y += C64_CROP_TOP;
     // Draw outer glow (darker)
     for (int i = -2; i <= w + 1; i++) {
-        if (x + i >= 0 && x + i < C64_DISPLAY_WIDTH) {
-            if (y - 2 >= 0) fb[(y - 2) * C64_DISPLAY_WIDTH + x + i] = base_color;
-            if (y + h + 1 < C64_DISPLAY_HEIGHT) fb[(y + h + 1) * C64_DISPLAY_WIDTH + x + i] = base_color;
-        }
+        put_pixel(x + i, y - 2, base_color);
+        put_pixel(x + i, y + h + 1, base_color);
     }
     for (int i = -1; i <= h; i++) {
-        if (y + i >= 0 && y + i < C64_DISPLAY_HEIGHT) {
-            if (x - 2 >= 0) fb[(y + i) * C64_DISPLAY_WIDTH + x - 2] = base_color;
-            if (x + w + 1 < C64_DISPLAY_WIDTH) fb[(y + i) * C64_DISPLAY_WIDTH + x + w + 1] = base_color;
-        }
+        put_pixel(x - 2, y + i, base_color);
+        put_pixel(x + w + 1, y + i, base_color);
     }
 
     // Draw bright inner border
@@ -391,16 +380,12 @@ static void draw_glow_border(int x, int y, int w, int h, uint8_t base_color) {
         bright = PALETTE_PLASMA_START + PALETTE_PLASMA_COUNT - 1;
 
     for (int i = -1; i <= w; i++) {
-        if (x + i >= 0 && x + i < C64_DISPLAY_WIDTH) {
-            if (y - 1 >= 0) fb[(y - 1) * C64_DISPLAY_WIDTH + x + i] = bright;
-            if (y + h < C64_DISPLAY_HEIGHT) fb[(y + h) * C64_DISPLAY_WIDTH + x + i] = bright;
-        }
+        put_pixel(x + i, y - 1, bright);
+        put_pixel(x + i, y + h, bright);
     }
     for (int i = 0; i < h; i++) {
-        if (y + i >= 0 && y + i < C64_DISPLAY_HEIGHT) {
-            if (x - 1 >= 0) fb[(y + i) * C64_DISPLAY_WIDTH + x - 1] = bright;
-            if (x + w < C64_DISPLAY_WIDTH) fb[(y + i) * C64_DISPLAY_WIDTH + x + w] = bright;
-        }
+        put_pixel(x - 1, y + i, bright);
+        put_pixel(x + w, y + i, bright);
     }
 }
 
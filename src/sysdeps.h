@@ -135,6 +135,7 @@ int fatfs_feof(FATFS_FILE *fp);
 int fatfs_getc(FATFS_FILE *fp);
 int fatfs_putc(int c, FATFS_FILE *fp);
 void fatfs_rewind(FATFS_FILE *fp);
+int fatfs_fflush(FATFS_FILE *fp);
 
 #ifdef __cplusplus
 }
@@ -152,6 +153,7 @@ void fatfs_rewind(FATFS_FILE *fp);
 #define getc            fatfs_getc
 #define putc            fatfs_putc
 #define rewind          fatfs_rewind
+#define fflush          fatfs_fflush
 
 #else  // Desktop
 